@@ -36,3 +36,7 @@ list(APPEND ilqgames_LIBRARIES ${GLUT_LIBRARIES})
 #find_package( Boost REQUIRED )
 #include_directories(SYSTEM ${BOOST_INCLUDE_DIRS})
 #list(APPEND ilqgames_LIBRARIES ${BOOST_LIBRARIES})
+
+# Find threads, used by the solver's optional thread pool.
+find_package( Threads REQUIRED )
+list(APPEND ilqgames_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+///////////////////////////////////////////////////////////////////////////////
+//
+// Benchmark suite for the solvers. Solves the example problems headless, in
+// both feedback and open-loop modes, with both ILQSolver and
+// AugmentedLagrangianSolver, several times each. Reports the number of solver
+// iterations, solve time percentiles, mean time per phase (see
+// IterateTelemetry), and mean number of allocations per solve as JSON, so that
+// results may be compared across commits to catch performance regressions.
+//
+// Some examples define command line flags of the same name (e.g., initial
+// conditions), so they cannot be linked into the same binary. Only the first
+// of each such group (Air3DExample, OnePlayerReachabilityExample, and
+// ThreePlayerCollisionAvoidanceReachabilityExample) is included. The
+// differentially flat examples are also excluded, since they keep their
+// dynamics apart from Problem's and so cannot be initialized.
+//
+// Allocations are counted by replacing the global `malloc` family (see
+// test/allocation_counter.h), which relies on glibc internals, so they are
+// reported as null on other platforms.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "allocation_counter.h"
+
+#include <ilqgames/examples/air_3d_example.h>
+#include <ilqgames/examples/dubins_origin_example.h>
+#include <ilqgames/examples/modified_three_player_intersection_example.h>
+#include <ilqgames/examples/one_player_reachability_example.h>
+#include <ilqgames/examples/roundabout_merging_example.h>
+#include <ilqgames/examples/skeleton_example.h>
+#include <ilqgames/examples/three_player_collision_avoidance_reachability_example.h>
+#include <ilqgames/examples/three_player_intersection_example.h>
+#include <ilqgames/examples/three_player_intersection_reachability_example.h>
+#include <ilqgames/examples/three_player_overtaking_example.h>
+#include <ilqgames/examples/two_player_collision_example.h>
+#include <ilqgames/solver/augmented_lagrangian_solver.h>
+#include <ilqgames/solver/game_solver.h>
+#include <ilqgames/solver/ilq_solver.h>
+#include <ilqgames/solver/problem.h>
+#include <ilqgames/solver/solver_params.h>
+#include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/solver_telemetry.h>
+#include <ilqgames/utils/types.h>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+DEFINE_int32(num_trials, 5, "Number of timed solves per configuration.");
+DEFINE_int32(max_solver_iters, 100, "Maximum number of solver iterations.");
+DEFINE_string(problems, ".*",
+              "Regular expression matching the names of problems to solve.");
+DEFINE_string(output, "", "File to write JSON results to (default: stdout).");
+
+namespace {
+
+using namespace ilqgames;
+
+// Named constructors for all example problems.
+using ProblemFactory = std::function<std::shared_ptr<Problem>()>;
+template <typename ProblemType>
+std::pair<std::string, ProblemFactory> Example(const std::string& name) {
+  return {name, []() { return std::make_shared<ProblemType>(); }};
+}
+
+const std::vector<std::pair<std::string, ProblemFactory>> kProblems = {
+    Example<Air3DExample>("air_3d"),
+    Example<DubinsOriginExample>("dubins_origin"),
+    Example<ModifiedThreePlayerIntersectionExample>(
+        "modified_three_player_intersection"),
+    Example<OnePlayerReachabilityExample>("one_player_reachability"),
+    Example<RoundaboutMergingExample>("roundabout_merging"),
+    Example<SkeletonExample>("skeleton"),
+    Example<ThreePlayerCollisionAvoidanceReachabilityExample>(
+        "three_player_collision_avoidance_reachability"),
+    Example<ThreePlayerIntersectionExample>("three_player_intersection"),
+    Example<ThreePlayerIntersectionReachabilityExample>(
+        "three_player_intersection_reachability"),
+    Example<ThreePlayerOvertakingExample>("three_player_overtaking"),
+    Example<TwoPlayerCollisionExample>("two_player_collision")};
+
+// Statistics over all trials of one configuration.
+struct Results {
+  std::vector<double> solve_times;
+  size_t num_iterations = 0;
+  size_t num_backtracking_steps = 0;
+  size_t num_converged = 0;
+  size_t num_allocations = 0;
+  IterateTelemetry total_telemetry;
+};  // struct Results
+
+// Solve the given problem once with a fresh solver, and accumulate results.
+void RunTrial(const ProblemFactory& make_problem, bool open_loop,
+              bool augmented_lagrangian, Results* results) {
+  CHECK_NOTNULL(results);
+
+  const std::shared_ptr<Problem> problem = make_problem();
+  problem->Initialize();
+
+  SolverParams params;
+  params.max_solver_iters = FLAGS_max_solver_iters;
+  params.open_loop = open_loop;
+  std::unique_ptr<GameSolver> solver;
+  if (augmented_lagrangian)
+    solver.reset(new AugmentedLagrangianSolver(problem, params));
+  else
+    solver.reset(new ILQSolver(problem, params));
+
+  // Only time and count allocations in the solve itself.
+  StartCountingAllocations();
+  const auto start = std::chrono::steady_clock::now();
+  const std::shared_ptr<const SolverLog> log = solver->Solve();
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  const size_t num_allocations = StopCountingAllocations();
+
+  results->solve_times.push_back(elapsed.count());
+  results->num_allocations += num_allocations;
+  if (log->Quality() == CONVERGED) results->num_converged++;
+
+  // Accumulate telemetry over all logged iterates. With the augmented
+  // Lagrangian solver, these include the initial iterate of each
+  // unconstrained solve, which did not take a step.
+  IterateTelemetry& total = results->total_telemetry;
+  for (size_t ii = 0; ii < log->NumIterates(); ii++) {
+    const IterateTelemetry& telemetry = log->Telemetry(ii);
+    total.linearization_time += telemetry.linearization_time;
+    total.quadraticization_time += telemetry.quadraticization_time;
+    total.lq_solve_time += telemetry.lq_solve_time;
+    total.rollout_time += telemetry.rollout_time;
+    total.linesearch_time += telemetry.linesearch_time;
+    results->num_backtracking_steps += telemetry.num_backtracking_steps;
+    if (telemetry.step_size > 0.0) results->num_iterations++;
+  }
+}
+
+// Quantile of the given (unsorted) samples, by nearest rank.
+double Quantile(std::vector<double> samples, double quantile) {
+  CHECK(!samples.empty());
+  std::sort(samples.begin(), samples.end());
+  const size_t rank = static_cast<size_t>(std::ceil(quantile * samples.size()));
+  return samples[std::min(std::max<size_t>(rank, 1), samples.size()) - 1];
+}
+
+// Write results for one configuration as a JSON object.
+void WriteResults(const std::string& problem_name, bool open_loop,
+                  bool augmented_lagrangian, const Results& results,
+                  FILE* file) {
+  constexpr double kMillisecondsPerSecond = 1e3;
+  const double num_trials = results.solve_times.size();
+  const auto mean_ms = [&](Time total) {
+    return kMillisecondsPerSecond * total / num_trials;
+  };
+  const auto quantile_ms = [&](double quantile) {
+    return kMillisecondsPerSecond * Quantile(results.solve_times, quantile);
+  };
+
+  fprintf(file, "    {\"problem\": \"%s\", \"mode\": \"%s\", ",
+          problem_name.c_str(), (open_loop) ? "open_loop" : "feedback");
+  fprintf(file, "\"solver\": \"%s\",\n",
+          (augmented_lagrangian) ? "augmented_lagrangian" : "ilq");
+  fprintf(file,
+          "     \"iterations\": %.2f, \"backtracking_steps\": %.2f, "
+          "\"converged_fraction\": %.2f,\n",
+          results.num_iterations / num_trials,
+          results.num_backtracking_steps / num_trials,
+          results.num_converged / num_trials);
+  fprintf(file,
+          "     \"solve_time_ms\": {\"min\": %.4f, \"p50\": %.4f, "
+          "\"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f},\n",
+          quantile_ms(0.0), quantile_ms(0.5), quantile_ms(0.9),
+          quantile_ms(0.99), quantile_ms(1.0));
+
+  const IterateTelemetry& total = results.total_telemetry;
+  fprintf(file,
+          "     \"phase_time_ms\": {\"linearization\": %.4f, "
+          "\"quadraticization\": %.4f, \"lq_solve\": %.4f, "
+          "\"rollout\": %.4f, \"linesearch\": %.4f},\n",
+          mean_ms(total.linearization_time),
+          mean_ms(total.quadraticization_time), mean_ms(total.lq_solve_time),
+          mean_ms(total.rollout_time), mean_ms(total.linesearch_time));
+  if (kCanCountAllocations) {
+    fprintf(file, "     \"allocations\": %.1f}",
+            results.num_allocations / num_trials);
+  } else {
+    fprintf(file, "     \"allocations\": null}");
+  }
+}
+
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  CHECK_GT(FLAGS_num_trials, 0);
+  CHECK_GT(FLAGS_max_solver_iters, 0);
+
+  FILE* file = stdout;
+  if (!FLAGS_output.empty()) {
+    file = fopen(FLAGS_output.c_str(), "w");
+    CHECK_NOTNULL(file);
+  }
+
+  fprintf(file, "{\n  \"num_trials\": %d,\n  \"max_solver_iters\": %d,\n",
+          FLAGS_num_trials, FLAGS_max_solver_iters);
+  fprintf(file, "  \"results\": [\n");
+
+  const std::regex problem_filter(FLAGS_problems);
+  bool first = true;
+  for (const auto& problem : kProblems) {
+    if (!std::regex_match(problem.first, problem_filter)) continue;
+
+    for (bool open_loop : {false, true}) {
+      for (bool augmented_lagrangian : {false, true}) {
+        LOG(INFO) << "Benchmarking " << problem.first << " ("
+                  << ((open_loop) ? "open loop" : "feedback") << ", "
+                  << ((augmented_lagrangian) ? "augmented Lagrangian" : "ILQ")
+                  << ").";
+
+        // Warm up once, then time each trial.
+        Results results;
+        RunTrial(problem.second, open_loop, augmented_lagrangian, &results);
+        results = Results();
+        for (int ii = 0; ii < FLAGS_num_trials; ii++)
+          RunTrial(problem.second, open_loop, augmented_lagrangian, &results);
+
+        if (!first) fprintf(file, ",\n");
+        first = false;
+        WriteResults(problem.first, open_loop, augmented_lagrangian, results,
+                     file);
+      }
+    }
+  }
+
+  fprintf(file, "\n  ]\n}\n");
+  if (file != stdout) fclose(file);
+
+  return 0;
+}
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+///////////////////////////////////////////////////////////////////////////////
+//
+// Microbenchmark the per-term kernels which dominate linearization and
+// quadraticization: `Evaluate` and `Quadraticize` (with and without Hessians)
+// for every cost and constraint, and `Evaluate` and `Linearize` for every
+// dynamical system. Costs and systems are constructed exactly as in
+// test/test_quadraticization.cpp and test/test_linearization.cpp, and inputs
+// are drawn from the same distributions as in those tests (which exercise
+// every branch of piecewise costs). Inputs are drawn ahead of time and cycled
+// through, so that branch prediction cannot memorize a single input. Reports
+// the median and minimum time per call over several repetitions.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/constraint/affine_scalar_constraint.h>
+#include <ilqgames/constraint/affine_vector_constraint.h>
+#include <ilqgames/constraint/polyline2_signed_distance_constraint.h>
+#include <ilqgames/constraint/proximity_constraint.h>
+#include <ilqgames/constraint/single_dimension_constraint.h>
+#include <ilqgames/cost/cost.h>
+#include <ilqgames/cost/curvature_cost.h>
+#include <ilqgames/cost/extreme_value_cost.h>
+#include <ilqgames/cost/locally_convex_proximity_cost.h>
+#include <ilqgames/cost/nominal_path_length_cost.h>
+#include <ilqgames/cost/orientation_cost.h>
+#include <ilqgames/cost/polyline2_signed_distance_cost.h>
+#include <ilqgames/cost/proximity_cost.h>
+#include <ilqgames/cost/quadratic_cost.h>
+#include <ilqgames/cost/quadratic_difference_cost.h>
+#include <ilqgames/cost/quadratic_norm_cost.h>
+#include <ilqgames/cost/quadratic_polyline2_cost.h>
+#include <ilqgames/cost/relative_distance_cost.h>
+#include <ilqgames/cost/route_progress_cost.h>
+#include <ilqgames/cost/semiquadratic_cost.h>
+#include <ilqgames/cost/semiquadratic_norm_cost.h>
+#include <ilqgames/cost/semiquadratic_polyline2_cost.h>
+#include <ilqgames/cost/signed_distance_cost.h>
+#include <ilqgames/cost/weighted_convex_proximity_cost.h>
+#include <ilqgames/dynamics/air_3d.h>
+#include <ilqgames/dynamics/concatenated_dynamical_system.h>
+#include <ilqgames/dynamics/fixed_size_concatenated_dynamical_system.h>
+#include <ilqgames/dynamics/multi_player_dynamical_system.h>
+#include <ilqgames/dynamics/single_player_car_5d.h>
+#include <ilqgames/dynamics/single_player_car_6d.h>
+#include <ilqgames/dynamics/single_player_car_7d.h>
+#include <ilqgames/dynamics/single_player_delayed_dubins_car.h>
+#include <ilqgames/dynamics/single_player_dubins_car.h>
+#include <ilqgames/dynamics/single_player_dynamical_system.h>
+#include <ilqgames/dynamics/single_player_point_mass_2d.h>
+#include <ilqgames/dynamics/single_player_unicycle_4d.h>
+#include <ilqgames/dynamics/single_player_unicycle_5d.h>
+#include <ilqgames/dynamics/two_player_unicycle_4d.h>
+#include <ilqgames/geometry/polyline2.h>
+#include <ilqgames/utils/linear_dynamics_approximation.h>
+#include <ilqgames/utils/types.h>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+DEFINE_int32(num_calls, 100000, "Number of calls to time per repetition.");
+DEFINE_int32(num_repeats, 5, "Number of timed repetitions per kernel.");
+DEFINE_string(kernels, ".*",
+              "Regular expression matching the names of kernels to time, "
+              "e.g., \"proximity_cost/.*\" or \".*/linearize\".");
+
+namespace {
+
+using namespace ilqgames;
+
+// Cost weight and input dimension, as in the quadraticization tests.
+static constexpr float kCostWeight = 1.0;
+static constexpr Dimension kInputDimension = 10;
+
+// Time step for discrete-time linearizations, and Dubins car speed, as in the
+// linearization tests.
+static constexpr Time kTimeStep = 0.1;
+static constexpr float kDubinsSpeed = 1.0;
+static constexpr float kInterAxleLength = 4.0;  // m
+
+// Number of inputs to cycle through.
+static constexpr size_t kNumInputs = 1024;
+
+// Results of each call are accumulated here so they cannot be optimized away.
+volatile float sink = 0.0;
+
+// Time the given kernel, which is called with the index of an input, and
+// print the median and minimum time per call.
+template <typename Kernel>
+void TimeKernel(const std::string& name, const std::string& kernel,
+                const Kernel& call) {
+  const std::string full_name = name + "/" + kernel;
+  if (!std::regex_match(full_name, std::regex(FLAGS_kernels))) return;
+
+  // Warm up on every input once.
+  for (size_t ii = 0; ii < kNumInputs; ii++) call(ii);
+
+  std::vector<double> ns_per_call(FLAGS_num_repeats);
+  for (auto& ns : ns_per_call) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < FLAGS_num_calls; ii++) call(ii % kNumInputs);
+    const std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    ns = elapsed.count() / FLAGS_num_calls;
+  }
+
+  std::sort(ns_per_call.begin(), ns_per_call.end());
+  printf("%-50s %10.1f ns/call   (min %.1f)\n", full_name.c_str(),
+         ns_per_call[ns_per_call.size() / 2], ns_per_call.front());
+}
+
+// Benchmark a cost (or constraint) on random inputs whose entries have random
+// signs and magnitudes in [0.5, 5], at random times within the horizon.
+void BenchmarkCost(const std::string& name, const Cost& cost) {
+  std::default_random_engine rng(0);
+  std::uniform_real_distribution<Time> time_distribution(
+      0.0, time::kDefaultTimeHorizon);
+  std::bernoulli_distribution sign_distribution;
+  std::uniform_real_distribution<float> entry_distribution(0.5, 5.0);
+
+  std::vector<VectorXf> inputs(kNumInputs, VectorXf(kInputDimension));
+  std::vector<Time> times(kNumInputs);
+  for (size_t ii = 0; ii < kNumInputs; ii++) {
+    for (Dimension jj = 0; jj < kInputDimension; jj++) {
+      const float s = sign_distribution(rng);
+      inputs[ii](jj) = (1.0 - 2.0 * s) * entry_distribution(rng);
+    }
+    times[ii] = time_distribution(rng);
+  }
+
+  // Gradients and Hessians accumulate over calls, as they do over the terms
+  // of a player cost.
+  MatrixXf hess(MatrixXf::Zero(kInputDimension, kInputDimension));
+  VectorXf grad(VectorXf::Zero(kInputDimension));
+  TimeKernel(name, "evaluate", [&](size_t ii) {
+    sink += cost.Evaluate(times[ii], inputs[ii]);
+  });
+  TimeKernel(name, "gradient", [&](size_t ii) {
+    cost.Quadraticize(times[ii], inputs[ii], nullptr, &grad);
+  });
+  TimeKernel(name, "quadraticize", [&](size_t ii) {
+    cost.Quadraticize(times[ii], inputs[ii], &hess, &grad);
+  });
+  sink += grad.sum() + hess.sum();
+}
+
+// Benchmark a single player system on random states and controls with entries
+// in [-1, 1], at random times.
+void BenchmarkDynamics(const std::string& name,
+                       const SinglePlayerDynamicalSystem& system) {
+  std::default_random_engine rng(0);
+  std::uniform_real_distribution<Time> time_distribution(0.0, 10.0);
+
+  std::vector<VectorXf> xs(kNumInputs);
+  std::vector<VectorXf> us(kNumInputs);
+  std::vector<Time> times(kNumInputs);
+  for (size_t ii = 0; ii < kNumInputs; ii++) {
+    xs[ii] = VectorXf::Random(system.XDim());
+    us[ii] = VectorXf::Random(system.UDim());
+    times[ii] = time_distribution(rng);
+  }
+
+  // Jacobians must be initialized before each call, as callers do.
+  MatrixXf A(system.XDim(), system.XDim());
+  MatrixXf B(system.XDim(), system.UDim());
+  TimeKernel(name, "evaluate", [&](size_t ii) {
+    sink += system.Evaluate(times[ii], xs[ii], us[ii])(0);
+  });
+  TimeKernel(name, "linearize", [&](size_t ii) {
+    A.setIdentity();
+    B.setZero();
+    system.Linearize(times[ii], kTimeStep, xs[ii], us[ii], A, B);
+  });
+  sink += A.sum() + B.sum();
+}
+
+// Same as above, for a multi-player system, using the in-place (and, where
+// derived classes support it, non-allocating) versions of each kernel.
+void BenchmarkDynamics(const std::string& name,
+                       const MultiPlayerDynamicalSystem& system) {
+  std::default_random_engine rng(0);
+  std::uniform_real_distribution<Time> time_distribution(0.0, 10.0);
+
+  std::vector<VectorXf> xs(kNumInputs);
+  std::vector<std::vector<VectorXf>> us(kNumInputs);
+  std::vector<Time> times(kNumInputs);
+  for (size_t ii = 0; ii < kNumInputs; ii++) {
+    xs[ii] = VectorXf::Random(system.XDim());
+    for (PlayerIndex jj = 0; jj < system.NumPlayers(); jj++)
+      us[ii].push_back(VectorXf::Random(system.UDim(jj)));
+    times[ii] = time_distribution(rng);
+  }
+
+  VectorXf xdot(system.XDim());
+  LinearDynamicsApproximation linearization(system);
+  TimeKernel(name, "evaluate", [&](size_t ii) {
+    system.Evaluate(times[ii], xs[ii], us[ii], &xdot);
+  });
+  TimeKernel(name, "linearize", [&](size_t ii) {
+    system.Linearize(times[ii], kTimeStep, xs[ii], us[ii], &linearization);
+  });
+  sink += xdot.sum() + linearization.A.sum();
+}
+
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  CHECK_GT(FLAGS_num_calls, 0);
+  CHECK_GT(FLAGS_num_repeats, 0);
+
+  // Costs.
+  const Polyline2 polyline(
+      {Point2(-2.0, -2.0), Point2(0.5, 1.0), Point2(2.0, 2.0)});
+  const Polyline2 long_polyline(
+      {Point2(-200.0, -200.0), Point2(0.5, 1.0), Point2(200.0, 200.0)});
+  constexpr float kNominalSpeed = 0.1;
+
+  BenchmarkCost("quadratic_cost", QuadraticCost(kCostWeight, -1, 1.0));
+  BenchmarkCost("quadratic_difference_cost",
+                QuadraticDifferenceCost(kCostWeight, {0, 1}, {1, 2}));
+  BenchmarkCost("relative_distance_cost",
+                RelativeDistanceCost(kCostWeight, {0, 1}, {1, 2}));
+  BenchmarkCost("quadratic_norm_cost",
+                QuadraticNormCost(kCostWeight, {1, 2}, 1.0));
+  BenchmarkCost("semiquadratic_cost",
+                SemiquadraticCost(kCostWeight, 0, 0.0, true));
+  BenchmarkCost("semiquadratic_norm_cost",
+                SemiquadraticNormCost(kCostWeight, {1, 2}, 1.0, true));
+  BenchmarkCost("quadratic_polyline2_cost",
+                QuadraticPolyline2Cost(kCostWeight, polyline, {0, 1}));
+  BenchmarkCost(
+      "route_progress_cost",
+      RouteProgressCost(kCostWeight, kNominalSpeed, polyline, {0, 1}));
+  BenchmarkCost(
+      "semiquadratic_polyline2_cost",
+      SemiquadraticPolyline2Cost(kCostWeight, long_polyline, {0, 1}, 0.5,
+                                 true));
+  BenchmarkCost("curvature_cost", CurvatureCost(kCostWeight, 0, 1));
+  BenchmarkCost("nominal_path_length_cost",
+                NominalPathLengthCost(kCostWeight, 0, 1.0));
+  BenchmarkCost("proximity_cost",
+                ProximityCost(kCostWeight, {0, 1}, {2, 3}, 0.0));
+  BenchmarkCost("locally_convex_proximity_cost",
+                LocallyConvexProximityCost(kCostWeight, {0, 1}, {2, 3}, 0.0));
+  BenchmarkCost(
+      "weighted_convex_proximity_cost",
+      WeightedConvexProximityCost(kCostWeight, {0, 1}, {2, 3}, 4, 5, 0.0));
+  BenchmarkCost("orientation_cost", OrientationCost(kCostWeight, 1, M_PI_2));
+  BenchmarkCost("polyline2_signed_distance_cost",
+                Polyline2SignedDistanceCost(polyline, {0, 1}));
+  BenchmarkCost("signed_distance_cost",
+                SignedDistanceCost({0, 1}, {2, 3}, 5.0));
+  const std::shared_ptr<const SignedDistanceCost> extreme_value_cost1(
+      new SignedDistanceCost({0, 1}, {2, 3}, 5.0));
+  const std::shared_ptr<const QuadraticCost> extreme_value_cost2(
+      new QuadraticCost(kCostWeight, -1, 1.0));
+  BenchmarkCost("extreme_value_cost",
+                ExtremeValueCost({extreme_value_cost1, extreme_value_cost2},
+                                 true));
+
+  // Constraints.
+  BenchmarkCost("affine_scalar_constraint",
+                AffineScalarConstraint(
+                    VectorXf::LinSpaced(kInputDimension, -1.0, 1.0), 0.5,
+                    false));
+  BenchmarkCost("affine_vector_constraint",
+                AffineVectorConstraint(
+                    10.0 * MatrixXf::Random(kInputDimension, kInputDimension),
+                    VectorXf::Random(kInputDimension), false));
+  BenchmarkCost("proximity_constraint",
+                ProximityConstraint({0, 1}, {2, 3}, 0.7, false));
+  BenchmarkCost("polyline2_signed_distance_constraint",
+                Polyline2SignedDistanceConstraint(polyline, {0, 1}, 10.0,
+                                                  true));
+  BenchmarkCost("single_dimension_constraint",
+                SingleDimensionConstraint(0, 1.0, true));
+
+  // Single player dynamics.
+  BenchmarkDynamics("single_player_dubins_car",
+                    SinglePlayerDubinsCar(kDubinsSpeed));
+  BenchmarkDynamics("single_player_delayed_dubins_car",
+                    SinglePlayerDelayedDubinsCar(kDubinsSpeed));
+  BenchmarkDynamics("single_player_unicycle_4d", SinglePlayerUnicycle4D());
+  BenchmarkDynamics("single_player_unicycle_5d", SinglePlayerUnicycle5D());
+  BenchmarkDynamics("single_player_car_5d",
+                    SinglePlayerCar5D(kInterAxleLength));
+  BenchmarkDynamics("single_player_car_6d",
+                    SinglePlayerCar6D(kInterAxleLength));
+  BenchmarkDynamics("single_player_car_7d",
+                    SinglePlayerCar7D(kInterAxleLength));
+  BenchmarkDynamics("single_player_point_mass_2d", SinglePlayerPointMass2D());
+
+  // Multi-player dynamics, including dynamic and fixed-size concatenations of
+  // the same systems.
+  constexpr float kAir3DSpeed = 3.0;  // m/s
+  BenchmarkDynamics("air_3d", Air3D(kAir3DSpeed, kAir3DSpeed));
+  BenchmarkDynamics("two_player_unicycle_4d", TwoPlayerUnicycle4D());
+  BenchmarkDynamics(
+      "concatenated_dynamical_system",
+      ConcatenatedDynamicalSystem(
+          {std::make_shared<SinglePlayerCar6D>(kInterAxleLength),
+           std::make_shared<SinglePlayerUnicycle4D>()}));
+  BenchmarkDynamics(
+      "fixed_size_concatenated_dynamical_system",
+      FixedSizeConcatenatedDynamicalSystem<SinglePlayerCar6D,
+                                           SinglePlayerUnicycle4D>{
+          SinglePlayerCar6D(kInterAxleLength), SinglePlayerUnicycle4D()});
+
+  return 0;
+}
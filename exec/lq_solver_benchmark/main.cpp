@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+///////////////////////////////////////////////////////////////////////////////
+//
+// Benchmark the LQ feedback solver's linear solve backends (see
+// LQSolverBackend) on several example problems. Each problem is solved for a
+// few iterations, linearized and quadraticized about the resulting operating
+// point, and then the resulting LQ game is solved repeatedly with each
+// backend. Reports the average time per solve and the largest difference in
+// feedback gains from the Householder QR backend.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/dynamics/multi_player_dynamical_system.h>
+#include <ilqgames/examples/roundabout_merging_example.h>
+#include <ilqgames/examples/three_player_intersection_example.h>
+#include <ilqgames/examples/three_player_overtaking_example.h>
+#include <ilqgames/examples/two_player_collision_example.h>
+#include <ilqgames/solver/ilq_solver.h>
+#include <ilqgames/solver/lq_feedback_solver.h>
+#include <ilqgames/solver/problem.h>
+#include <ilqgames/solver/solver_params.h>
+#include <ilqgames/utils/linear_dynamics_approximation.h>
+#include <ilqgames/utils/operating_point.h>
+#include <ilqgames/utils/quadratic_cost_approximation.h>
+#include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/types.h>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+DEFINE_int32(num_trials, 100, "Number of LQ solves to time per backend.");
+DEFINE_int32(num_solver_iters, 10,
+             "Number of solver iterations before linearizing.");
+
+namespace {
+
+using namespace ilqgames;
+
+// Backends to compare, and their names.
+const std::vector<std::pair<LQSolverBackend, std::string>> kBackends = {
+    {HOUSEHOLDER_QR, "householder_qr"},
+    {PARTIAL_PIV_LU, "partial_piv_lu"},
+    {BLOCK_SCHUR, "block_schur"}};
+
+// Benchmark all backends on the given problem.
+void Benchmark(const std::string& name,
+               const std::shared_ptr<Problem>& problem) {
+  problem->Initialize();
+
+  // Run the solver for a bit to get a representative operating point.
+  SolverParams params;
+  params.max_solver_iters = FLAGS_num_solver_iters;
+  ILQSolver ilq_solver(problem, params);
+  const std::shared_ptr<const SolverLog> log = ilq_solver.Solve();
+
+  // Linearize and quadraticize about that operating point.
+  const auto dyn = static_cast<const MultiPlayerDynamicalSystem*>(
+      problem->Dynamics().get());
+  const OperatingPoint& op = log->FinalOperatingPoint();
+  std::vector<LinearDynamicsApproximation> linearization(
+      problem->NumTimeSteps());
+  std::vector<std::vector<QuadraticCostApproximation>> quadraticization(
+      problem->NumTimeSteps());
+  for (size_t kk = 0; kk < problem->NumTimeSteps(); kk++) {
+    const Time t = problem->RelativeTime(kk);
+    linearization[kk] =
+        dyn->Linearize(t, problem->TimeStep(kk), op.xs[kk], op.us[kk]);
+    for (const auto& cost : problem->PlayerCosts())
+      quadraticization[kk].push_back(
+          cost.Quadraticize(t, op.xs[kk], op.us[kk]));
+  }
+
+  const VectorXf x0 = VectorXf::Zero(problem->Dynamics()->XDim());
+  std::vector<Strategy> reference_strategies;
+  for (const auto& backend : kBackends) {
+    LQFeedbackSolver solver(problem->Dynamics(), problem->NumTimeSteps(),
+                            backend.first);
+
+    // Warm up once, which also sizes the output strategies.
+    std::vector<Strategy> strategies;
+    solver.Solve(linearization, quadraticization, x0, &strategies);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int ii = 0; ii < FLAGS_num_trials; ii++)
+      solver.Solve(linearization, quadraticization, x0, &strategies);
+    const std::chrono::duration<double, std::micro> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    // Compare feedback gains to those from the first (reference) backend.
+    if (reference_strategies.empty()) reference_strategies = strategies;
+    float max_difference = 0.0;
+    for (size_t ii = 0; ii < strategies.size(); ii++) {
+      for (size_t kk = 0; kk < problem->NumTimeSteps(); kk++) {
+        max_difference = std::max(
+            max_difference, (strategies[ii].Ps[kk] -
+                             reference_strategies[ii].Ps[kk])
+                                .cwiseAbs()
+                                .maxCoeff());
+      }
+    }
+
+    printf("%-26s %-16s %12.1f us/solve   max |dP| = %.3e\n", name.c_str(),
+           backend.second.c_str(), elapsed.count() / FLAGS_num_trials,
+           max_difference);
+  }
+}
+
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+  google::InitGoogleLogging(argv[0]);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  CHECK_GT(FLAGS_num_trials, 0);
+  CHECK_GE(FLAGS_num_solver_iters, 0);
+
+  Benchmark("two_player_collision",
+            std::make_shared<TwoPlayerCollisionExample>());
+  Benchmark("three_player_intersection",
+            std::make_shared<ThreePlayerIntersectionExample>());
+  Benchmark("three_player_overtaking",
+            std::make_shared<ThreePlayerOvertakingExample>());
+  Benchmark("roundabout_merging", std::make_shared<RoundaboutMergingExample>());
+
+  return 0;
+}
@@ -77,6 +77,10 @@ DEFINE_double(initial_alpha_scaling, 0.5, "Initial step size in linesearch.");
 DEFINE_double(convergence_tolerance, 0.01, "KKT squared error tolerance.");
 DEFINE_double(expected_decrease, 0.1, "KKT sq err expected decrease per iter.");
 
+// Augmented Lagrangian parameters.
+DEFINE_bool(warm_start_multipliers, false,
+            "Carry constraint multipliers over between replans.");
+
 // About OpenGL function loaders: modern OpenGL doesn't have a standard header
 // file and requires individual function pointers to be loaded manually. Helper
 // libraries are often used for this purpose! Here we are supporting a few
@@ -116,6 +120,8 @@ int main(int argc, char** argv) {
   params.convergence_tolerance = FLAGS_convergence_tolerance;
   params.state_regularization = FLAGS_state_regularization;
   params.control_regularization = FLAGS_control_regularization;
+  params.reset_lambdas = !FLAGS_warm_start_multipliers;
+  params.reset_mu = !FLAGS_warm_start_multipliers;
 
   auto problem = std::make_shared<ilqgames::ThreePlayerIntersectionExample>();
   problem->Initialize();
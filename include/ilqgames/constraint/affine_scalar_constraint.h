@@ -72,11 +72,12 @@ class AffineScalarConstraint : public TimeInvariantConstraint {
   // mu, respectively (terms in the augmented Lagrangian).
   void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const {
-    CHECK_NOTNULL(hess);
     CHECK_NOTNULL(grad);
     CHECK_EQ(input.size(), a_.size());
-    CHECK_EQ(hess->rows(), input.size());
-    CHECK_EQ(hess->cols(), input.size());
+    if (hess) {
+      CHECK_EQ(hess->rows(), input.size());
+      CHECK_EQ(hess->cols(), input.size());
+    }
     CHECK_EQ(grad->size(), input.size());
 
     // Get current lambda and mu.
@@ -85,7 +86,7 @@ class AffineScalarConstraint : public TimeInvariantConstraint {
 
     // Compute gradient and Hessian.
     (*grad) += lambda * a_ + mu * (hess_of_sq_ * input - b_ * a_);
-    (*hess) += mu * hess_of_sq_;
+    if (hess) (*hess) += mu * hess_of_sq_;
   }
 
  private:
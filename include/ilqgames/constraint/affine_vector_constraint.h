@@ -75,11 +75,12 @@ class AffineVectorConstraint : public TimeInvariantConstraint {
   // mu, respectively (terms in the augmented Lagrangian).
   void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const {
-    CHECK_NOTNULL(hess);
     CHECK_NOTNULL(grad);
     CHECK_EQ(input.size(), b_.size());
-    CHECK_EQ(hess->rows(), input.size());
-    CHECK_EQ(hess->cols(), input.size());
+    if (hess) {
+      CHECK_EQ(hess->rows(), input.size());
+      CHECK_EQ(hess->cols(), input.size());
+    }
     CHECK_EQ(grad->size(), input.size());
 
     // Get current lambda and mu.
@@ -93,9 +94,12 @@ class AffineVectorConstraint : public TimeInvariantConstraint {
     // Compute gradient and Hessian.
     const VectorXf AT_delta = A_.transpose() * delta;
     (*grad) += (mu + lambda / value) * AT_delta;
-    (*hess) += (lambda / value) *
-                   (AAT_ - AT_delta * AT_delta.transpose() / (value * value)) +
-               mu * ATA_;
+    if (hess) {
+      (*hess) +=
+          (lambda / value) *
+              (AAT_ - AT_delta * AT_delta.transpose() / (value * value)) +
+          mu * ATA_;
+    }
   }
 
  private:
@@ -52,11 +52,14 @@
 #define ILQGAMES_CONSTRAINT_CONSTRAINT_H
 
 #include <ilqgames/cost/cost.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -82,45 +85,99 @@ class Constraint : public Cost {
   virtual float Evaluate(Time t, const VectorXf& input) const = 0;
   float EvaluateAugmentedLagrangian(Time t, const VectorXf& input) const {
     const float g = Evaluate(t, input);
-    const float lambda = lambdas_[TimeIndex(t)];
-    return lambda * g + 0.5 * Mu(lambda, g) * g * g;
+    const size_t kk = TimeIndex(t);
+    return lambdas_[kk] * g + 0.5 * Mu(mus_[kk], lambdas_[kk], g) * g * g;
   }
 
   // Quadraticize the constraint value and its square, each scaled by lambda or
-  // mu, respectively (terms in the augmented Lagrangian).
+  // mu, respectively (terms in the augmented Lagrangian). `hess` may be null,
+  // in which case only the gradient is accumulated.
   virtual void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
                             VectorXf* grad) const = 0;
 
+  // Set time discretization, and resize multipliers to match. Multipliers
+  // revert to being stored by this constraint (see `BindMultipliers`).
+  void SetTimeDiscretization(const TimeGrid& time_grid,
+                             size_t num_time_steps) {
+    Cost::SetTimeDiscretization(time_grid, num_time_steps);
+    own_lambdas_.resize(num_time_steps, constants::kDefaultLambda);
+    own_mus_.resize(num_time_steps, constants::kDefaultMu);
+    lambdas_ = own_lambdas_.data();
+    mus_ = own_mus_.data();
+  }
+
+  // Store multipliers (lambdas) and augmented multipliers (mus) in the given
+  // external storage, with one entry each per time step, e.g., rows of
+  // matrices holding the multipliers of every constraint in a problem (see
+  // `ConstraintMultipliers`). Current values are copied over. The storage
+  // must outlive this constraint or the next call to this function or
+  // `SetTimeDiscretization`.
+  void BindMultipliers(float* lambdas, float* mus) {
+    CHECK_NOTNULL(lambdas);
+    CHECK_NOTNULL(mus);
+    if (lambdas != lambdas_) {
+      std::copy(lambdas_, lambdas_ + NumTimeSteps(), lambdas);
+      lambdas_ = lambdas;
+    }
+    if (mus != mus_) {
+      std::copy(mus_, mus_ + NumTimeSteps(), mus);
+      mus_ = mus;
+    }
+  }
+
   // Accessors and setters.
   bool IsEquality() const { return is_equality_; }
+  size_t NumTimeSteps() const { return own_lambdas_.size(); }
   float& Lambda(Time t) { return lambdas_[TimeIndex(t)]; }
   float Lambda(Time t) const { return lambdas_[TimeIndex(t)]; }
   void IncrementLambda(Time t, float value) {
     const size_t kk = TimeIndex(t);
-    const float new_lambda = lambdas_[kk] + mu_ * value;
+    const float new_lambda = lambdas_[kk] + mus_[kk] * value;
     lambdas_[kk] = (is_equality_) ? new_lambda : std::max(0.0f, new_lambda);
   }
   void ScaleLambdas(float scale) {
-    for (auto& lambda : lambdas_) lambda *= scale;
+    for (size_t kk = 0; kk < NumTimeSteps(); kk++) lambdas_[kk] *= scale;
+  }
+  float& Mu(Time t) { return mus_[TimeIndex(t)]; }
+  float Mu(Time t) const { return mus_[TimeIndex(t)]; }
+  virtual void SetMu(float mu) { std::fill(mus_, mus_ + NumTimeSteps(), mu); }
+  virtual void ScaleMu(float scale) {
+    for (size_t kk = 0; kk < NumTimeSteps(); kk++) mus_[kk] *= scale;
   }
-  static float& GlobalMu() { return mu_; }
-  static void ScaleMu(float scale) { mu_ *= scale; }
   float Mu(Time t, const VectorXf& input) const {
-    const float g = Evaluate(t, input);
-    return Mu(Lambda(t), g);
+    const size_t kk = TimeIndex(t);
+    return Mu(mus_[kk], lambdas_[kk], Evaluate(t, input));
   }
-  float Mu(float lambda, float g) const {
+
+  // Augmented multiplier to use given the stored one, lambda, and g. This is
+  // zero for inequality constraints which are inactive.
+  float Mu(float mu, float lambda, float g) const {
     if (!is_equality_ && g <= constants::kSmallNumber &&
         std::abs(lambda) <= constants::kSmallNumber)
       return 0.0;
-    return mu_;
+    return mu;
   }
 
  protected:
   explicit Constraint(bool is_equality, const std::string& name)
       : Cost(1.0, name),
         is_equality_(is_equality),
-        lambdas_(time::kNumTimeSteps, constants::kDefaultLambda) {}
+        own_lambdas_(time::kDefaultNumTimeSteps, constants::kDefaultLambda),
+        own_mus_(time::kDefaultNumTimeSteps, constants::kDefaultMu),
+        lambdas_(own_lambdas_.data()),
+        mus_(own_mus_.data()) {}
+
+  // Copies always store their own multipliers.
+  Constraint(const Constraint& other)
+      : Cost(other),
+        is_equality_(other.is_equality_),
+        own_lambdas_(other.lambdas_, other.lambdas_ + other.NumTimeSteps()),
+        own_mus_(other.mus_, other.mus_ + other.NumTimeSteps()),
+        lambdas_(own_lambdas_.data()),
+        mus_(own_mus_.data()) {}
+
+  // Assignment would alias the other constraint's multipliers, so disallow it.
+  Constraint& operator=(const Constraint& other) = delete;
 
   // Modify derivatives to account for the multipliers and the quadratic term in
   // the augmented Lagrangian. The inputs are the derivatives of g in the
@@ -133,10 +190,15 @@ class Constraint : public Cost {
   // Is this an equality constraint? If not, it is an inequality constraint.
   bool is_equality_;
 
-  // Multipliers, one per time step. Also a static augmented multiplier for an
-  // augmented Lagrangian.
-  std::vector<float> lambdas_;
-  static float mu_;
+  // Multipliers and augmented multipliers (from the augmented Lagrangian),
+  // one each per time step. These are owned by this constraint (and hence by
+  // the problem it belongs to) so that independent solvers do not interfere.
+  // They are always accessed through `lambdas_` and `mus_`, which point
+  // either to `own_lambdas_` and `own_mus_` or to external storage.
+  std::vector<float> own_lambdas_;
+  std::vector<float> own_mus_;
+  float* lambdas_;
+  float* mus_;
 };  //\class Constraint
 
 }  // namespace ilqgames
@@ -44,11 +44,13 @@
 #define ILQGAMES_CONSTRAINT_FINAL_TIME_CONSTRAINT_H
 
 #include <ilqgames/constraint/constraint.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -63,6 +65,26 @@ class FinalTimeConstraint : public Constraint {
     CHECK_NOTNULL(constraint_);
   }
 
+  // Set time discretization, initial time, and augmented multiplier for this
+  // and the underlying constraint.
+  void SetTimeDiscretization(const TimeGrid& time_grid,
+                             size_t num_time_steps) {
+    Constraint::SetTimeDiscretization(time_grid, num_time_steps);
+    constraint_->SetTimeDiscretization(time_grid, num_time_steps);
+  }
+  void ResetInitialTime(Time t0) {
+    Constraint::ResetInitialTime(t0);
+    constraint_->ResetInitialTime(t0);
+  }
+  void SetMu(float mu) {
+    Constraint::SetMu(mu);
+    constraint_->SetMu(mu);
+  }
+  void ScaleMu(float scale) {
+    Constraint::ScaleMu(scale);
+    constraint_->ScaleMu(scale);
+  }
+
   // Evaluate this constraint value, i.e., g(x).
   float Evaluate(Time t, const VectorXf& input) const {
     return (t < initial_time_ + threshold_time_)
@@ -78,6 +100,11 @@ class FinalTimeConstraint : public Constraint {
       constraint_->Quadraticize(t, input, hess, grad);
   }
 
+  // Sparsity pattern is the same as the underlying constraint.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    return constraint_->HessianSparsityPattern(dims);
+  }
+
  private:
   // Underlying constraint.
   const std::shared_ptr<Constraint> constraint_;
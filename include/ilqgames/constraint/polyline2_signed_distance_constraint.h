@@ -55,6 +55,7 @@
 #include <glog/logging.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -80,6 +81,13 @@ class Polyline2SignedDistanceConstraint : public TimeInvariantConstraint {
   void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in the position dimensions.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->insert(dims->end(), {xidx_, yidx_});
+    return true;
+  }
+
  private:
   // Polyline.
   const Polyline2 polyline_;
@@ -53,6 +53,7 @@
 #include <glog/logging.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -81,6 +82,13 @@ class ProximityConstraint : public TimeInvariantConstraint {
   void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in both players' position dimensions.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->insert(dims->end(), {xidx1_, yidx1_, xidx2_, yidx2_});
+    return true;
+  }
+
  private:
   // Position dimension indices for both players.
   const Dimension xidx1_;
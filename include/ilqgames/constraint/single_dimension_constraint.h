@@ -51,6 +51,7 @@
 #include <glog/logging.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -73,10 +74,11 @@ class SingleDimensionConstraint : public TimeInvariantConstraint {
   // mu, respectively (terms in the augmented Lagrangian).
   void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const {
-    CHECK_NOTNULL(hess);
     CHECK_NOTNULL(grad);
-    CHECK_EQ(hess->rows(), input.size());
-    CHECK_EQ(hess->cols(), input.size());
+    if (hess) {
+      CHECK_EQ(hess->rows(), input.size());
+      CHECK_EQ(hess->cols(), input.size());
+    }
     CHECK_EQ(grad->size(), input.size());
 
     // Get current lambda.
@@ -92,7 +94,14 @@ class SingleDimensionConstraint : public TimeInvariantConstraint {
     ModifyDerivatives(t, g, &dx, &ddx);
 
     (*grad)(dim_) += dx;
-    (*hess)(dim_, dim_) += ddx;
+    if (hess) (*hess)(dim_, dim_) += ddx;
+  }
+
+  // Hessian is only nonzero in the constrained dimension.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->push_back(dim_);
+    return true;
   }
 
  private:
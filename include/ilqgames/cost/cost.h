@@ -49,6 +49,7 @@
 
 #include <glog/logging.h>
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -60,10 +61,19 @@ class Cost : public RelativeTimeTracker {
   virtual float Evaluate(Time t, const VectorXf& input) const = 0;
 
   // Quadraticize this cost at the given time and input, and add to the running
-  // sum of gradients and Hessians.
+  // sum of gradients and Hessians. `hess` may be null, in which case only the
+  // gradient is accumulated.
   virtual void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
                             VectorXf* grad) const = 0;
 
+  // If this cost's Hessian is only nonzero in the rows and columns of a few
+  // input dimensions, append those dimensions to `dims` and return true.
+  // Otherwise (the default), the Hessian may be dense and this returns false.
+  virtual bool HessianSparsityPattern(
+      std::vector<Dimension>* /* dims */) const {
+    return false;
+  }
+
   // Reset and scale weight.
   void SetWeight(float weight) { weight_ = weight; }
   void ScaleWeight(float scale) { weight_ *= scale; }
@@ -47,6 +47,7 @@
 #include <ilqgames/utils/types.h>
 
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -64,6 +65,13 @@ class CurvatureCost : public TimeInvariantCost {
   void Quadraticize(const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in the angular rate and speed dimensions.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->insert(dims->end(), {omega_idx_, v_idx_});
+    return true;
+  }
+
  private:
   // Compute curvature.
   float Curvature(const VectorXf& input) const {
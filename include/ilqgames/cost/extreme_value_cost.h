@@ -48,6 +48,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -65,6 +66,16 @@ class ExtremeValueCost : public Cost {
   void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Sparsity pattern is the union of those of all sub-costs, or dense if any
+  // of them is dense.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    for (const auto& cost : costs_) {
+      if (!cost->HessianSparsityPattern(dims)) return false;
+    }
+
+    return true;
+  }
+
   // Return a pointer to the extreme cost, and optionally evaluate it too.
   const Cost* ExtremeCost(Time t, const VectorXf& input,
                           float* evaluated = nullptr) const;
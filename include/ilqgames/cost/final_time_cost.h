@@ -49,6 +49,7 @@
 #include <glog/logging.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -75,6 +76,11 @@ class FinalTimeCost : public Cost {
     cost_->Quadraticize(t, input, hess, grad);
   }
 
+  // Sparsity pattern is the same as the underlying cost.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    return cost_->HessianSparsityPattern(dims);
+  }
+
  private:
   // Cost function.
   const std::shared_ptr<const Cost> cost_;
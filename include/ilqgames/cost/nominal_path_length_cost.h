@@ -48,6 +48,7 @@
 #include <ilqgames/utils/types.h>
 
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -67,6 +68,13 @@ class NominalPathLengthCost : public Cost {
   void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in the path length dimension.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->push_back(dimension_);
+    return true;
+  }
+
  private:
   // Dimension in which to apply the quadratic cost.
   const Dimension dimension_;
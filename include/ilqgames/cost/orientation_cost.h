@@ -49,6 +49,7 @@
 #include <glog/logging.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace ilqgames {
 
@@ -70,6 +71,13 @@ class OrientationCost : public TimeInvariantCost {
   void Quadraticize(const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in the heading dimension.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->push_back(dim_);
+    return true;
+  }
+
  private:
   // Dimensions in which to apply the quadratic cost.
   const Dimension dim_;
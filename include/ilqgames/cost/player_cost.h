@@ -48,6 +48,7 @@
 #include <ilqgames/cost/cost.h>
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/quadratic_cost_approximation.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <unordered_map>
@@ -66,8 +67,8 @@ class PlayerCost {
       : name_(name),
         state_regularization_(state_regularization),
         control_regularization_(control_regularization),
-        cost_structure_(CostStructure::SUM),
-        time_of_extreme_cost_(0) {}
+        is_state_hess_sparse_(true),
+        cost_structure_(CostStructure::SUM) {}
 
   // Add new state and control costs for this player.
   void AddStateCost(const std::shared_ptr<Cost>& cost);
@@ -80,6 +81,12 @@ class PlayerCost {
   void AddControlConstraint(PlayerIndex idx,
                             const std::shared_ptr<Constraint>& constraint);
 
+  // Set the time discretization and initial time for all costs and
+  // constraints.
+  void SetTimeDiscretization(const TimeGrid& time_grid,
+                             size_t num_time_steps);
+  void ResetInitialTime(Time t0);
+
   // Evaluate this cost at the current time, state, and controls, or
   // integrate over an entire trajectory. The "Offset" here indicates that
   // state costs will be evaluated at the next time step.
@@ -98,6 +105,26 @@ class PlayerCost {
   QuadraticCostApproximation QuadraticizeControlCosts(
       Time t, const VectorXf& x, const std::vector<VectorXf>& us) const;
 
+  // In-place versions of the above, which overwrite the given quadraticization.
+  // These reuse existing storage in `q` and so do not allocate memory once `q`
+  // has storage for every player's control (unless the underlying costs
+  // themselves allocate).
+  void Quadraticize(Time t, const VectorXf& x, const std::vector<VectorXf>& us,
+                    QuadraticCostApproximation* q) const;
+  void QuadraticizeControlCosts(Time t, const VectorXf& x,
+                                const std::vector<VectorXf>& us,
+                                QuadraticCostApproximation* q) const;
+
+  // Same as the in-place versions above, but only compute gradients. This is
+  // cheaper when only gradients are needed (e.g., to evaluate a merit
+  // function), and leaves the state Hessian in `q` untouched and control
+  // Hessians unspecified.
+  void Differentiate(Time t, const VectorXf& x, const std::vector<VectorXf>& us,
+                     QuadraticCostApproximation* q) const;
+  void DifferentiateControlCosts(Time t, const VectorXf& x,
+                                 const std::vector<VectorXf>& us,
+                                 QuadraticCostApproximation* q) const;
+
   // Set whether this is a time-additive, max-over-time, or min-over-time cost.
   // At each specific time, all costs are accumulated with the given operation.
   enum CostStructure { SUM, MAX, MIN };
@@ -108,10 +135,6 @@ class PlayerCost {
   bool IsMaxOverTime() const { return cost_structure_ == MAX; }
   bool IsMinOverTime() const { return cost_structure_ == MIN; }
 
-  // Keep track of the time of extreme costs.
-  size_t TimeOfExtremeCost() { return time_of_extreme_cost_; }
-  void SetTimeOfExtremeCost(size_t kk) { time_of_extreme_cost_ = kk; }
-
   // Accessors.
   const PtrVector<Cost>& StateCosts() const { return state_costs_; }
   const PlayerPtrMultiMap<Cost>& ControlCosts() const { return control_costs_; }
@@ -141,14 +164,29 @@ class PlayerCost {
   const float state_regularization_;
   const float control_regularization_;
 
+  // Union of the sparsity patterns of all state costs and constraints, and
+  // whether they are all sparse.
+  std::vector<Dimension> state_hess_dims_;
+  bool is_state_hess_sparse_;
+
+  // Add the given state cost or constraint's sparsity pattern to the union.
+  void UpdateStateHessianSparsity(const Cost& cost);
+
+  // Overwrite the given quadraticization with the gradients (and optionally
+  // Hessians) of either all costs and constraints or only control costs.
+  void Accumulate(Time t, const VectorXf& x, const std::vector<VectorXf>& us,
+                  bool control_costs_only, bool include_hessians,
+                  QuadraticCostApproximation* q) const;
+
+  // Reset the given state Hessian to pure regularization and record its
+  // sparsity pattern. If the Hessian already has the same pattern, only
+  // entries in the rows and columns of that pattern are reset.
+  void ResetStateHessian(Dimension xdim, bool control_costs_only,
+                         SingleCostApproximation* state) const;
+
   // Ternary variable whether this objective is time-additive, max-over-time, or
   // min-over-time.
   CostStructure cost_structure_;
-
-  // Keep track of the time of extreme costs. This will depend upon the current
-  // operating point, and it will only be meaningful if the cost structure is an
-  // extremum over time.
-  size_t time_of_extreme_cost_;
 };  //\class PlayerCost
 
 }  // namespace ilqgames
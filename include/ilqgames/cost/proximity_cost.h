@@ -50,6 +50,7 @@
 
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace ilqgames {
 
@@ -75,6 +76,13 @@ class ProximityCost : public TimeInvariantCost {
   void Quadraticize(const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in both players' position dimensions.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->insert(dims->end(), {xidx1_, yidx1_, xidx2_, yidx2_});
+    return true;
+  }
+
  private:
   // Threshold for minimum squared relative distance.
   const float threshold_, threshold_sq_;
@@ -47,6 +47,7 @@
 #include <ilqgames/utils/types.h>
 
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -67,6 +68,16 @@ class QuadraticCost : public TimeInvariantCost {
   void Quadraticize(const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in the given dimension, or dense if applied to all
+  // dimensions.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    if (dimension_ < 0) return false;
+
+    dims->push_back(dimension_);
+    return true;
+  }
+
  private:
   // Dimension in which to apply the quadratic cost.
   const Dimension dimension_;
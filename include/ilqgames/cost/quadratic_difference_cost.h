@@ -48,6 +48,7 @@
 
 #include <glog/logging.h>
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -70,6 +71,14 @@ class QuadraticDifferenceCost : public TimeInvariantCost {
   void Quadraticize(const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in both sets of dimensions.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->insert(dims->end(), dims1_.begin(), dims1_.end());
+    dims->insert(dims->end(), dims2_.begin(), dims2_.end());
+    return true;
+  }
+
  private:
   // Sets of dimensions whose pairwise differences will constitute the cost.
   const std::vector<Dimension> dims1_, dims2_;
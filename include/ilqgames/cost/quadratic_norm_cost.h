@@ -50,6 +50,7 @@
 #include <glog/logging.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace ilqgames {
 
@@ -75,6 +76,13 @@ class QuadraticNormCost : public TimeInvariantCost {
   void Quadraticize(const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in the two dimensions of the norm.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->insert(dims->end(), {dim1_, dim2_});
+    return true;
+  }
+
  private:
   // Dimensions in which to apply the quadratic cost.
   const Dimension dim1_, dim2_;
@@ -49,6 +49,7 @@
 
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace ilqgames {
 
@@ -72,6 +73,13 @@ class QuadraticPolyline2Cost : public TimeInvariantCost {
   void Quadraticize(const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in the position dimensions.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->insert(dims->end(), {xidx_, yidx_});
+    return true;
+  }
+
  private:
   // Polyline to compute distances from.
   const Polyline2 polyline_;
@@ -49,6 +49,7 @@
 #include <glog/logging.h>
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace ilqgames {
 
@@ -70,6 +71,14 @@ class RelativeDistanceCost : public TimeInvariantCost {
   void Quadraticize(const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in both sets of dimensions.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->insert(dims->end(),
+                 {dims1_.first, dims1_.second, dims2_.first, dims2_.second});
+    return true;
+  }
+
  private:
   // Sets of dimensions whose pairwise differences will constitute the cost.
   const std::pair<Dimension, Dimension> dims1_, dims2_;
@@ -50,6 +50,7 @@
 
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace ilqgames {
 
@@ -76,6 +77,13 @@ class RouteProgressCost : public Cost {
   void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in the position dimensions.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->insert(dims->end(), {xidx_, yidx_});
+    return true;
+  }
+
  private:
   // Nominal speed.
   const float nominal_speed_;
@@ -49,6 +49,7 @@
 
 #include <glog/logging.h>
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -73,6 +74,13 @@ class SemiquadraticCost : public TimeInvariantCost {
   void Quadraticize(const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in the penalized dimension.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->push_back(dimension_);
+    return true;
+  }
+
  private:
   // Dimension in which to apply the quadratic cost.
   const Dimension dimension_;
@@ -47,6 +47,7 @@
 #include <ilqgames/utils/types.h>
 
 #include <string>
+#include <vector>
 
 namespace ilqgames {
 
@@ -77,6 +78,13 @@ class SignedDistanceCost : public TimeInvariantCost {
   void Quadraticize(const VectorXf& input, MatrixXf* hess,
                     VectorXf* grad) const;
 
+  // Hessian is only nonzero in both players' position dimensions.
+  bool HessianSparsityPattern(std::vector<Dimension>* dims) const {
+    CHECK_NOTNULL(dims);
+    dims->insert(dims->end(), {xdim1_, ydim1_, xdim2_, ydim2_});
+    return true;
+  }
+
  private:
   // Dimensions in which to apply the distance cost.
   const Dimension xdim1_, ydim1_;
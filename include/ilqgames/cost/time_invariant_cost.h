@@ -61,7 +61,8 @@ class TimeInvariantCost : public Cost {
   }
 
   // Quadraticize this cost at the given input, and add to the running set of
-  // sum of gradients and Hessians.
+  // sum of gradients and Hessians. `hess` may be null, in which case only the
+  // gradient is accumulated.
   virtual void Quadraticize(const VectorXf& input, MatrixXf* hess,
                             VectorXf* grad) const = 0;
   void Quadraticize(Time t, const VectorXf& input, MatrixXf* hess,
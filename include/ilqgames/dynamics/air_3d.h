@@ -75,7 +75,8 @@ class Air3D : public MultiPlayerDynamicalSystem {
                     const std::vector<VectorXf>& us) const;
 
   // Compute a discrete-time Jacobian linearization.
-  LinearDynamicsApproximation Linearize(Time t, const VectorXf& x,
+  LinearDynamicsApproximation Linearize(Time t, Time time_step,
+                                        const VectorXf& x,
                                         const std::vector<VectorXf>& us) const;
 
   // Distance metric between two states.
@@ -127,23 +128,24 @@ inline VectorXf Air3D::Evaluate(Time t, const VectorXf& x,
 }
 
 inline LinearDynamicsApproximation Air3D::Linearize(
-    Time t, const VectorXf& x, const std::vector<VectorXf>& us) const {
+    Time t, Time time_step, const VectorXf& x,
+    const std::vector<VectorXf>& us) const {
   LinearDynamicsApproximation linearization(*this);
 
-  const float ctheta = std::cos(x(kRThetaIdx)) * time::kTimeStep;
-  const float stheta = std::sin(x(kRThetaIdx)) * time::kTimeStep;
+  const float ctheta = std::cos(x(kRThetaIdx)) * time_step;
+  const float stheta = std::sin(x(kRThetaIdx)) * time_step;
 
-  linearization.A(kRxIdx, kRyIdx) += us[0](kOmega1Idx) * time::kTimeStep;
+  linearization.A(kRxIdx, kRyIdx) += us[0](kOmega1Idx) * time_step;
   linearization.A(kRxIdx, kRThetaIdx) -= pursuer_speed_ * stheta;
 
-  linearization.A(kRyIdx, kRxIdx) -= us[0](kOmega1Idx) * time::kTimeStep;
+  linearization.A(kRyIdx, kRxIdx) -= us[0](kOmega1Idx) * time_step;
   linearization.A(kRyIdx, kRThetaIdx) += pursuer_speed_ * ctheta;
 
-  linearization.Bs[0](kRxIdx, kOmega1Idx) = x(kRyIdx) * time::kTimeStep;
-  linearization.Bs[0](kRyIdx, kOmega1Idx) = -x(kRxIdx) * time::kTimeStep;
-  linearization.Bs[0](kRThetaIdx, kOmega1Idx) = -time::kTimeStep;
+  linearization.Bs[0](kRxIdx, kOmega1Idx) = x(kRyIdx) * time_step;
+  linearization.Bs[0](kRyIdx, kOmega1Idx) = -x(kRxIdx) * time_step;
+  linearization.Bs[0](kRThetaIdx, kOmega1Idx) = -time_step;
 
-  linearization.Bs[1](kRThetaIdx, kOmega2Idx) = time::kTimeStep;
+  linearization.Bs[1](kRThetaIdx, kOmega2Idx) = time_step;
 
   return linearization;
 }
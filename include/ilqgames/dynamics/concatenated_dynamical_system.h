@@ -64,8 +64,13 @@ class ConcatenatedDynamicalSystem : public MultiPlayerDynamicalSystem {
                     const std::vector<VectorXf>& us) const;
 
   // Compute a discrete-time Jacobian linearization.
-  LinearDynamicsApproximation Linearize(Time t, const VectorXf& x,
+  // The result records the block structure of A and Bs.
+  LinearDynamicsApproximation Linearize(Time t, Time time_step,
+                                        const VectorXf& x,
                                         const std::vector<VectorXf>& us) const;
+  void Linearize(Time t, Time time_step, const VectorXf& x,
+                 const std::vector<VectorXf>& us,
+                 LinearDynamicsApproximation* linearization) const;
 
   // Distance metric between two states.
   float DistanceBetween(const VectorXf& x0, const VectorXf& x1) const;
@@ -62,7 +62,7 @@ class ConcatenatedFlatSystem : public MultiPlayerFlatSystem {
   VectorXf Evaluate(const VectorXf& x, const std::vector<VectorXf>& us) const;
 
   // Discrete time approximation of the underlying linearized system.
-  void ComputeLinearizedSystem() const;
+  void ComputeLinearizedSystem(Time time_step) const;
 
   // Utilities for feedback linearization.
   MatrixXf InverseDecouplingMatrix(const VectorXf& x) const;
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Multi-player dynamical system comprised of several single player subsystems
+// whose types (and hence dimensions) are known at compile time. Each subsystem
+// type must provide constexpr kNumXDims and kNumUDims, along with
+// EvaluateFixedSize and LinearizeFixedSize (see, e.g., SinglePlayerCar6D).
+// This allows Eigen to use fixed-size (stack-allocated, unrolled) blocks for
+// each subsystem. Use ConcatenatedDynamicalSystem for problems whose
+// subsystems are only known at runtime.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ILQGAMES_DYNAMICS_FIXED_SIZE_CONCATENATED_DYNAMICAL_SYSTEM_H
+#define ILQGAMES_DYNAMICS_FIXED_SIZE_CONCATENATED_DYNAMICAL_SYSTEM_H
+
+#include <ilqgames/dynamics/multi_player_dynamical_system.h>
+#include <ilqgames/utils/linear_dynamics_approximation.h>
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ilqgames {
+
+template <typename... Subsystems>
+class FixedSizeConcatenatedDynamicalSystem : public MultiPlayerDynamicalSystem {
+ public:
+  static_assert(sizeof...(Subsystems) > 0, "Must have at least one player.");
+
+  // Total state dimension and number of players.
+  static constexpr Dimension kNumXDims = (Subsystems::kNumXDims + ...);
+  static constexpr PlayerIndex kNumPlayers = sizeof...(Subsystems);
+
+  ~FixedSizeConcatenatedDynamicalSystem() {}
+  explicit FixedSizeConcatenatedDynamicalSystem(const Subsystems&... subsystems)
+      : MultiPlayerDynamicalSystem(kNumXDims), subsystems_(subsystems...) {}
+
+  // Compute time derivative of state.
+  VectorXf Evaluate(Time t, const VectorXf& x,
+                    const std::vector<VectorXf>& us) const;
+
+  // Compute a discrete-time Jacobian linearization.
+  LinearDynamicsApproximation Linearize(Time t, Time time_step,
+                                        const VectorXf& x,
+                                        const std::vector<VectorXf>& us) const;
+
+  // In-place versions of the above. These do not allocate memory as long as
+  // the outputs are already the right size.
+  void Evaluate(Time t, const VectorXf& x, const std::vector<VectorXf>& us,
+                VectorXf* xdot) const;
+  void Linearize(Time t, Time time_step, const VectorXf& x,
+                 const std::vector<VectorXf>& us,
+                 LinearDynamicsApproximation* linearization) const;
+
+  // Distance metric between two states. As in ConcatenatedDynamicalSystem,
+  // only the first subsystem matters.
+  float DistanceBetween(const VectorXf& x0, const VectorXf& x1) const {
+    constexpr Dimension kEgoXDim = Subsystem<0>::kNumXDims;
+    return std::get<0>(subsystems_).DistanceBetween(
+        x0.template head<kEgoXDim>(), x1.template head<kEgoXDim>());
+  }
+
+  // Stitch between two states of the system. Interprets the first one as best
+  // for ego and the second as best for other players.
+  VectorXf Stitch(const VectorXf& x_ego, const VectorXf& x_others) const {
+    constexpr Dimension kEgoXDim = Subsystem<0>::kNumXDims;
+    constexpr Dimension kOthersXDim = kNumXDims - kEgoXDim;
+
+    VectorXf x(kNumXDims);
+    x.template head<kEgoXDim>() = x_ego.template head<kEgoXDim>();
+    x.template tail<kOthersXDim>() = x_others.template tail<kOthersXDim>();
+    return x;
+  }
+
+  // Getters.
+  PlayerIndex NumPlayers() const { return kNumPlayers; }
+  Dimension SubsystemStartDim(PlayerIndex player_idx) const {
+    return kSubsystemStartDims[player_idx];
+  }
+  Dimension SubsystemXDim(PlayerIndex player_idx) const {
+    return kSubsystemXDims[player_idx];
+  }
+  Dimension UDim(PlayerIndex player_idx) const {
+    return kSubsystemUDims[player_idx];
+  }
+  std::vector<Dimension> PositionDimensions() const;
+
+ private:
+  // Type of the given subsystem.
+  template <size_t kIdx>
+  using Subsystem = std::tuple_element_t<kIdx, std::tuple<Subsystems...>>;
+
+  // Per-subsystem dimensions.
+  static constexpr std::array<Dimension, kNumPlayers> kSubsystemXDims = {
+      Subsystems::kNumXDims...};
+  static constexpr std::array<Dimension, kNumPlayers> kSubsystemUDims = {
+      Subsystems::kNumUDims...};
+
+  // Cumulative sum of dimensions of each subsystem.
+  static constexpr std::array<Dimension, kNumPlayers> kSubsystemStartDims =
+      []() {
+        std::array<Dimension, kNumPlayers> start_dims = {};
+        for (size_t ii = 1; ii < kNumPlayers; ii++)
+          start_dims[ii] = start_dims[ii - 1] + kSubsystemXDims[ii - 1];
+        return start_dims;
+      }();
+
+  // Call f(std::integral_constant<size_t, ii>) for each subsystem index ii.
+  template <typename F>
+  static void ForEachSubsystem(const F& f) {
+    ForEachSubsystem(f, std::make_index_sequence<kNumPlayers>());
+  }
+  template <typename F, size_t... kIdxs>
+  static void ForEachSubsystem(const F& f, std::index_sequence<kIdxs...>) {
+    (f(std::integral_constant<size_t, kIdxs>()), ...);
+  }
+
+  // Subsystems, each of which controls the affects of a single player.
+  const std::tuple<Subsystems...> subsystems_;
+};  // class FixedSizeConcatenatedDynamicalSystem
+
+// ----------------------------- IMPLEMENTATION ----------------------------- //
+
+template <typename... Subsystems>
+VectorXf FixedSizeConcatenatedDynamicalSystem<Subsystems...>::Evaluate(
+    Time t, const VectorXf& x, const std::vector<VectorXf>& us) const {
+  VectorXf xdot(kNumXDims);
+  Evaluate(t, x, us, &xdot);
+  return xdot;
+}
+
+template <typename... Subsystems>
+LinearDynamicsApproximation
+FixedSizeConcatenatedDynamicalSystem<Subsystems...>::Linearize(
+    Time t, Time time_step, const VectorXf& x,
+    const std::vector<VectorXf>& us) const {
+  LinearDynamicsApproximation linearization(*this);
+  Linearize(t, time_step, x, us, &linearization);
+  return linearization;
+}
+
+template <typename... Subsystems>
+void FixedSizeConcatenatedDynamicalSystem<Subsystems...>::Evaluate(
+    Time t, const VectorXf& x, const std::vector<VectorXf>& us,
+    VectorXf* xdot) const {
+  CHECK_NOTNULL(xdot);
+  CHECK_EQ(us.size(), NumPlayers());
+  xdot->resize(kNumXDims);
+
+  // Populate 'xdot' one subsystem at a time.
+  ForEachSubsystem([this, t, &x, &us, xdot](auto idx) {
+    constexpr size_t kIdx = decltype(idx)::value;
+    constexpr Dimension kStartDim = kSubsystemStartDims[kIdx];
+    constexpr Dimension kXDim = Subsystem<kIdx>::kNumXDims;
+
+    std::get<kIdx>(subsystems_)
+        .EvaluateFixedSize(t, x.template segment<kXDim>(kStartDim), us[kIdx],
+                           xdot->template segment<kXDim>(kStartDim));
+  });
+}
+
+template <typename... Subsystems>
+void FixedSizeConcatenatedDynamicalSystem<Subsystems...>::Linearize(
+    Time t, Time time_step, const VectorXf& x, const std::vector<VectorXf>& us,
+    LinearDynamicsApproximation* linearization) const {
+  CHECK_NOTNULL(linearization);
+  CHECK_EQ(us.size(), NumPlayers());
+
+  // Reset to identity A and zero Bs, since subsystems only write to their own
+  // blocks (and accumulate into A).
+  linearization->A.setIdentity(kNumXDims, kNumXDims);
+  linearization->Bs.resize(kNumPlayers);
+  for (PlayerIndex ii = 0; ii < kNumPlayers; ii++)
+    linearization->Bs[ii].setZero(kNumXDims, kSubsystemUDims[ii]);
+
+  // Record the block structure.
+  linearization->x_block_starts.assign(kSubsystemStartDims.begin(),
+                                       kSubsystemStartDims.end());
+  linearization->x_block_dims.assign(kSubsystemXDims.begin(),
+                                     kSubsystemXDims.end());
+
+  // Populate a block-diagonal A, as well as Bs.
+  ForEachSubsystem([this, t, time_step, &x, &us, linearization](auto idx) {
+    constexpr size_t kIdx = decltype(idx)::value;
+    constexpr Dimension kStartDim = kSubsystemStartDims[kIdx];
+    constexpr Dimension kXDim = Subsystem<kIdx>::kNumXDims;
+    constexpr Dimension kUDim = Subsystem<kIdx>::kNumUDims;
+
+    std::get<kIdx>(subsystems_)
+        .LinearizeFixedSize(
+            t, time_step, x.template segment<kXDim>(kStartDim), us[kIdx],
+            linearization->A.template block<kXDim, kXDim>(kStartDim,
+                                                          kStartDim),
+            linearization->Bs[kIdx].template block<kXDim, kUDim>(kStartDim,
+                                                                 0));
+  });
+}
+
+template <typename... Subsystems>
+std::vector<Dimension>
+FixedSizeConcatenatedDynamicalSystem<Subsystems...>::PositionDimensions()
+    const {
+  std::vector<Dimension> dims;
+  ForEachSubsystem([this, &dims](auto idx) {
+    const std::vector<Dimension> sub_dims =
+        std::get<decltype(idx)::value>(subsystems_).PositionDimensions();
+    dims.insert(dims.end(), sub_dims.begin(), sub_dims.end());
+  });
+
+  return dims;
+}
+
+}  // namespace ilqgames
+
+#endif
@@ -50,6 +50,7 @@
 #include <ilqgames/utils/strategy.h>
 #include <ilqgames/utils/types.h>
 
+#include <glog/logging.h>
 #include <vector>
 
 namespace ilqgames {
@@ -64,11 +65,36 @@ class MultiPlayerDynamicalSystem : public MultiPlayerIntegrableSystem {
 
   // Compute a discrete-time Jacobian linearization.
   virtual LinearDynamicsApproximation Linearize(
-      Time t, const VectorXf& x, const std::vector<VectorXf>& us) const = 0;
+      Time t, Time time_step, const VectorXf& x,
+      const std::vector<VectorXf>& us) const = 0;
 
-  // Integrate these dynamics forward in time.
+  // In-place versions of the above, which overwrite preallocated outputs. By
+  // default these just call the allocating versions, but derived classes
+  // should override them where it is possible to avoid allocating memory.
+  virtual void Evaluate(Time t, const VectorXf& x,
+                        const std::vector<VectorXf>& us, VectorXf* xdot) const {
+    CHECK_NOTNULL(xdot);
+    *xdot = Evaluate(t, x, us);
+  }
+  virtual void Linearize(Time t, Time time_step, const VectorXf& x,
+                         const std::vector<VectorXf>& us,
+                         LinearDynamicsApproximation* linearization) const {
+    CHECK_NOTNULL(linearization);
+    *linearization = Linearize(t, time_step, x, us);
+  }
+
+  // Integrate these dynamics forward in time, either with RK4 or a single
+  // forward Euler step. The in-place version only allocates memory if the
+  // in-place version of `Evaluate` does, or if the workspace is not yet sized.
   VectorXf Integrate(Time t0, Time time_interval, const VectorXf& x0,
                      const std::vector<VectorXf>& us) const;
+  void Integrate(Time t0, Time time_interval, const VectorXf& x0,
+                 const std::vector<VectorXf>& us,
+                 IntegrationWorkspace* workspace, VectorXf* x) const;
+  VectorXf IntegrateEuler(Time t0, Time time_interval, const VectorXf& x0,
+                          const std::vector<VectorXf>& us) const {
+    return x0 + time_interval * Evaluate(t0, x0, us);
+  }
 
   // Getters.
   virtual Dimension UDim(PlayerIndex player_idx) const = 0;
@@ -97,9 +97,11 @@ class MultiPlayerFlatSystem : public MultiPlayerIntegrableSystem {
   // true here.
   bool TreatAsLinear() const { return true; }
 
-  // Getters.
-  const LinearDynamicsApproximation& LinearizedSystem() const {
-    if (!discrete_linear_system_) ComputeLinearizedSystem();
+  // Getters. The discrete-time linearization is cached, and only recomputed
+  // when queried with a different time step.
+  const LinearDynamicsApproximation& LinearizedSystem(Time time_step) const {
+    if (!discrete_linear_system_ || time_step != discrete_time_step_)
+      ComputeLinearizedSystem(time_step);
     return *discrete_linear_system_;
   }
 
@@ -107,16 +109,19 @@ class MultiPlayerFlatSystem : public MultiPlayerIntegrableSystem {
   virtual PlayerIndex NumPlayers() const = 0;
 
  protected:
-  MultiPlayerFlatSystem(Dimension xdim) : MultiPlayerIntegrableSystem(xdim) {}
+  MultiPlayerFlatSystem(Dimension xdim)
+      : MultiPlayerIntegrableSystem(xdim), discrete_time_step_(0.0) {}
 
   // Discrete time approximation of the underlying linearized system.
-  virtual void ComputeLinearizedSystem() const = 0;
+  virtual void ComputeLinearizedSystem(Time time_step) const = 0;
 
-  // Linearized system (discrete and continuous time).
+  // Linearized system (discrete and continuous time), and the time step used
+  // for the discrete version.
   mutable std::unique_ptr<const LinearDynamicsApproximation>
       discrete_linear_system_;
   mutable std::unique_ptr<const LinearDynamicsApproximation>
       continuous_linear_system_;
+  mutable Time discrete_time_step_;
 
 };  //\class MultiPlayerFlatSystem
 
@@ -46,8 +46,10 @@
 
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
+#include <glog/logging.h>
 #include <vector>
 
 namespace ilqgames {
@@ -56,24 +58,47 @@ class MultiPlayerIntegrableSystem {
  public:
   virtual ~MultiPlayerIntegrableSystem() {}
 
+  // Scratch space for integrating without allocating memory. Once these have
+  // been sized by a first call to the in-place version of `Integrate` below,
+  // subsequent calls (with the same dimensions) will not allocate.
+  struct IntegrationWorkspace {
+    VectorXf x, x_stage;
+    VectorXf k1, k2, k3, k4;
+  };  // struct IntegrationWorkspace
+
   // Integrate these dynamics forward in time.
   // Options include integration for a single timestep, between arbitrary times,
-  // and within a single timestep.
+  // and within a single timestep. Versions which follow an operating point and
+  // strategies require the time grid on which those are discretized.
   virtual VectorXf Integrate(Time t0, Time time_interval, const VectorXf& x0,
                              const std::vector<VectorXf>& us) const = 0;
-  VectorXf Integrate(Time t0, Time t, const VectorXf& x0,
-                     const OperatingPoint& operating_point,
+  VectorXf Integrate(Time t0, Time t, const TimeGrid& time_grid,
+                     const VectorXf& x0, const OperatingPoint& operating_point,
                      const std::vector<Strategy>& strategies) const;
   VectorXf Integrate(size_t initial_timestep, size_t final_timestep,
-                     const VectorXf& x0, const OperatingPoint& operating_point,
+                     const TimeGrid& time_grid, const VectorXf& x0,
+                     const OperatingPoint& operating_point,
                      const std::vector<Strategy>& strategies) const;
   VectorXf IntegrateToNextTimeStep(
-      Time t0, const VectorXf& x0, const OperatingPoint& operating_point,
+      Time t0, const TimeGrid& time_grid, const VectorXf& x0,
+      const OperatingPoint& operating_point,
       const std::vector<Strategy>& strategies) const;
   VectorXf IntegrateFromPriorTimeStep(
-      Time t, const VectorXf& x0, const OperatingPoint& operating_point,
+      Time t, const TimeGrid& time_grid, const VectorXf& x0,
+      const OperatingPoint& operating_point,
       const std::vector<Strategy>& strategies) const;
 
+  // In-place version of single-step integration, which writes the result to
+  // `x` and uses the given workspace for intermediate values. By default this
+  // just calls the allocating version above. It is safe for `x` to alias `x0`.
+  virtual void Integrate(Time t0, Time time_interval, const VectorXf& x0,
+                         const std::vector<VectorXf>& us,
+                         IntegrationWorkspace* /* workspace */,
+                         VectorXf* x) const {
+    CHECK_NOTNULL(x);
+    *x = Integrate(t0, time_interval, x0, us);
+  }
+
   // Make a utility version of the above that operates on Eigen::Refs.
   VectorXf Integrate(Time t0, Time time_interval,
                      const Eigen::Ref<VectorXf>& x0,
@@ -92,11 +117,20 @@ class MultiPlayerIntegrableSystem {
     return x_ego;
   }
 
+  // Integrate for a single step using forward Euler, regardless of how this
+  // system integrates by default. Systems without a meaningful Euler step
+  // (e.g., flat systems) just integrate as usual.
+  virtual VectorXf IntegrateEuler(Time t0, Time time_interval,
+                                  const VectorXf& x0,
+                                  const std::vector<VectorXf>& us) const {
+    return Integrate(t0, time_interval, x0, us);
+  }
+
   // Integrate using single step Euler or not, see below for more extensive
   // description.
-  static void IntegrateUsingEuler() { integrate_using_euler_ = true; }
-  static void IntegrateUsingRK4() { integrate_using_euler_ = false; }
-  static bool IntegrationUsesEuler() { return integrate_using_euler_; }
+  void IntegrateUsingEuler() { integrate_using_euler_ = true; }
+  void IntegrateUsingRK4() { integrate_using_euler_ = false; }
+  bool IntegrationUsesEuler() const { return integrate_using_euler_; }
 
   // Getters.
   Dimension XDim() const { return xdim_; }
@@ -115,15 +149,17 @@ class MultiPlayerIntegrableSystem {
   }
 
  protected:
-  MultiPlayerIntegrableSystem(Dimension xdim) : xdim_(xdim) {}
+  MultiPlayerIntegrableSystem(Dimension xdim)
+      : xdim_(xdim), integrate_using_euler_(false) {}
 
   // State dimension.
   const Dimension xdim_;
 
   // Whether to use single Euler during integration. Typically this is false but
   // it is typically used either for testing (we only derive Nash typically in
-  // this case) or for speed.
-  static bool integrate_using_euler_;
+  // this case) or for speed. Numerical checks which require Euler integration
+  // should call `IntegrateEuler` directly rather than toggling this flag.
+  bool integrate_using_euler_;
 };  //\class MultiPlayerIntegrableSystem
 
 }  // namespace ilqgames
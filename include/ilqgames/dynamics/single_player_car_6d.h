@@ -69,7 +69,7 @@ class SinglePlayerCar6D : public SinglePlayerDynamicalSystem {
   VectorXf Evaluate(Time t, const VectorXf& x, const VectorXf& u) const;
 
   // Compute a discrete-time Jacobian linearization.
-  void Linearize(Time t, const VectorXf& x, const VectorXf& u,
+  void Linearize(Time t, Time time_step, const VectorXf& x, const VectorXf& u,
                  Eigen::Ref<MatrixXf> A, Eigen::Ref<MatrixXf> B) const;
 
   // Distance metric between two states.
@@ -79,18 +79,34 @@ class SinglePlayerCar6D : public SinglePlayerDynamicalSystem {
   std::vector<Dimension> PositionDimensions() const { return {kPxIdx, kPyIdx}; }
 
   // Constexprs for state indices.
-  static const Dimension kNumXDims;
-  static const Dimension kPxIdx;
-  static const Dimension kPyIdx;
-  static const Dimension kThetaIdx;
-  static const Dimension kPhiIdx;
-  static const Dimension kVIdx;
-  static const Dimension kAIdx;
+  static constexpr Dimension kNumXDims = 6;
+  static constexpr Dimension kPxIdx = 0;
+  static constexpr Dimension kPyIdx = 1;
+  static constexpr Dimension kThetaIdx = 2;
+  static constexpr Dimension kPhiIdx = 3;
+  static constexpr Dimension kVIdx = 4;
+  static constexpr Dimension kAIdx = 5;
 
   // Constexprs for control indices.
-  static const Dimension kNumUDims;
-  static const Dimension kOmegaIdx;
-  static const Dimension kJerkIdx;
+  static constexpr Dimension kNumUDims = 2;
+  static constexpr Dimension kOmegaIdx = 0;
+  static constexpr Dimension kJerkIdx = 1;
+
+  // Fixed-size types and versions of Evaluate and Linearize, for use when
+  // dimensions are known at compile time. The dynamic-size versions above
+  // forward to these.
+  using StateVector = Eigen::Matrix<float, kNumXDims, 1>;
+  using ControlVector = Eigen::Matrix<float, kNumUDims, 1>;
+  using StateJacobian = Eigen::Matrix<float, kNumXDims, kNumXDims>;
+  using ControlJacobian = Eigen::Matrix<float, kNumXDims, kNumUDims>;
+  void EvaluateFixedSize(Time t, const Eigen::Ref<const StateVector>& x,
+                         const Eigen::Ref<const ControlVector>& u,
+                         Eigen::Ref<StateVector> xdot) const;
+  void LinearizeFixedSize(Time t, Time time_step,
+                          const Eigen::Ref<const StateVector>& x,
+                          const Eigen::Ref<const ControlVector>& u,
+                          Eigen::Ref<StateJacobian> A,
+                          Eigen::Ref<ControlJacobian> B) const;
 
  private:
   // Inter-axle distance. Determines turning radius.
@@ -102,22 +118,35 @@ class SinglePlayerCar6D : public SinglePlayerDynamicalSystem {
 inline VectorXf SinglePlayerCar6D::Evaluate(Time t, const VectorXf& x,
                                             const VectorXf& u) const {
   VectorXf xdot(xdim_);
+  EvaluateFixedSize(t, x, u, xdot);
+  return xdot;
+}
+
+inline void SinglePlayerCar6D::Linearize(Time t, Time time_step,
+                                         const VectorXf& x, const VectorXf& u,
+                                         Eigen::Ref<MatrixXf> A,
+                                         Eigen::Ref<MatrixXf> B) const {
+  LinearizeFixedSize(t, time_step, x, u, A, B);
+}
+
+inline void SinglePlayerCar6D::EvaluateFixedSize(
+    Time t, const Eigen::Ref<const StateVector>& x,
+    const Eigen::Ref<const ControlVector>& u,
+    Eigen::Ref<StateVector> xdot) const {
   xdot(kPxIdx) = x(kVIdx) * std::cos(x(kThetaIdx));
   xdot(kPyIdx) = x(kVIdx) * std::sin(x(kThetaIdx));
   xdot(kThetaIdx) = (x(kVIdx) / inter_axle_distance_) * std::tan(x(kPhiIdx));
   xdot(kPhiIdx) = u(kOmegaIdx);
   xdot(kVIdx) = x(kAIdx);
   xdot(kAIdx) = u(kJerkIdx);
-
-  return xdot;
 }
 
-inline void SinglePlayerCar6D::Linearize(Time t, const VectorXf& x,
-                                         const VectorXf& u,
-                                         Eigen::Ref<MatrixXf> A,
-                                         Eigen::Ref<MatrixXf> B) const {
-  const float ctheta = std::cos(x(kThetaIdx)) * time::kTimeStep;
-  const float stheta = std::sin(x(kThetaIdx)) * time::kTimeStep;
+inline void SinglePlayerCar6D::LinearizeFixedSize(
+    Time t, Time time_step, const Eigen::Ref<const StateVector>& x,
+    const Eigen::Ref<const ControlVector>& u, Eigen::Ref<StateJacobian> A,
+    Eigen::Ref<ControlJacobian> B) const {
+  const float ctheta = std::cos(x(kThetaIdx)) * time_step;
+  const float stheta = std::sin(x(kThetaIdx)) * time_step;
   const float cphi = std::cos(x(kPhiIdx));
   const float tphi = std::tan(x(kPhiIdx));
 
@@ -128,13 +157,13 @@ inline void SinglePlayerCar6D::Linearize(Time t, const VectorXf& x,
   A(kPyIdx, kVIdx) += stheta;
 
   A(kThetaIdx, kPhiIdx) +=
-      x(kVIdx) * time::kTimeStep / (inter_axle_distance_ * cphi * cphi);
-  A(kThetaIdx, kVIdx) += tphi * time::kTimeStep / inter_axle_distance_;
+      x(kVIdx) * time_step / (inter_axle_distance_ * cphi * cphi);
+  A(kThetaIdx, kVIdx) += tphi * time_step / inter_axle_distance_;
 
-  A(kVIdx, kAIdx) += time::kTimeStep;
+  A(kVIdx, kAIdx) += time_step;
 
-  B(kPhiIdx, kOmegaIdx) = time::kTimeStep;
-  B(kAIdx, kJerkIdx) = time::kTimeStep;
+  B(kPhiIdx, kOmegaIdx) = time_step;
+  B(kAIdx, kJerkIdx) = time_step;
 }
 
 inline float SinglePlayerCar6D::DistanceBetween(const VectorXf& x0,
@@ -67,7 +67,7 @@ class SinglePlayerDubinsCar : public SinglePlayerDynamicalSystem {
   VectorXf Evaluate(Time t, const VectorXf& x, const VectorXf& u) const;
 
   // Compute a discrete-time Jacobian linearization.
-  void Linearize(Time t, const VectorXf& x, const VectorXf& u,
+  void Linearize(Time t, Time time_step, const VectorXf& x, const VectorXf& u,
                  Eigen::Ref<MatrixXf> A, Eigen::Ref<MatrixXf> B) const;
 
   // Position dimensions.
@@ -100,18 +100,18 @@ inline VectorXf SinglePlayerDubinsCar::Evaluate(Time t, const VectorXf& x,
   return xdot;
 }
 
-inline void SinglePlayerDubinsCar::Linearize(Time t,
+inline void SinglePlayerDubinsCar::Linearize(Time t, Time time_step,
                                              const VectorXf& x,
                                              const VectorXf& u,
                                              Eigen::Ref<MatrixXf> A,
                                              Eigen::Ref<MatrixXf> B) const {
-  const float ctheta = std::cos(x(kThetaIdx)) * time::kTimeStep;
-  const float stheta = std::sin(x(kThetaIdx)) * time::kTimeStep;
+  const float ctheta = std::cos(x(kThetaIdx)) * time_step;
+  const float stheta = std::sin(x(kThetaIdx)) * time_step;
 
   A(kPxIdx, kThetaIdx) += -v_ * stheta;
   A(kPyIdx, kThetaIdx) += v_ * ctheta;
 
-  B(kThetaIdx, kOmegaIdx) = time::kTimeStep;
+  B(kThetaIdx, kOmegaIdx) = time_step;
 }
 
 }  // namespace ilqgames
@@ -68,7 +68,8 @@ class SinglePlayerFlatUnicycle4D : public SinglePlayerFlatSystem {
   VectorXf Evaluate(const VectorXf& x, const VectorXf& u) const;
 
   // Discrete time approximation of the underlying linearized system.
-  void LinearizedSystem(Eigen::Ref<MatrixXf> A, Eigen::Ref<MatrixXf> B) const;
+  void LinearizedSystem(Time time_step, Eigen::Ref<MatrixXf> A,
+                        Eigen::Ref<MatrixXf> B) const;
 
   // Utilities for feedback linearization.
   MatrixXf InverseDecouplingMatrix(const VectorXf& x) const;
@@ -114,12 +115,12 @@ inline VectorXf SinglePlayerFlatUnicycle4D::Evaluate(const VectorXf& x,
 }
 
 inline void SinglePlayerFlatUnicycle4D::LinearizedSystem(
-    Eigen::Ref<MatrixXf> A, Eigen::Ref<MatrixXf> B) const {
-  A(kPxIdx, kVxIdx) += time::kTimeStep;
-  A(kPyIdx, kVyIdx) += time::kTimeStep;
+    Time time_step, Eigen::Ref<MatrixXf> A, Eigen::Ref<MatrixXf> B) const {
+  A(kPxIdx, kVxIdx) += time_step;
+  A(kPyIdx, kVyIdx) += time_step;
 
-  B(kVxIdx, 0) = time::kTimeStep;
-  B(kVyIdx, 1) = time::kTimeStep;
+  B(kVxIdx, 0) = time_step;
+  B(kVyIdx, 1) = time_step;
 }
 
 inline MatrixXf SinglePlayerFlatUnicycle4D::InverseDecouplingMatrix(
@@ -63,7 +63,7 @@ class SinglePlayerUnicycle4D : public SinglePlayerDynamicalSystem {
   VectorXf Evaluate(Time t, const VectorXf& x, const VectorXf& u) const;
 
   // Compute a discrete-time Jacobian linearization.
-  void Linearize(Time t, const VectorXf& x, const VectorXf& u,
+  void Linearize(Time t, Time time_step, const VectorXf& x, const VectorXf& u,
                  Eigen::Ref<MatrixXf> A, Eigen::Ref<MatrixXf> B) const;
 
   // Distance metric between two states.
@@ -73,16 +73,32 @@ class SinglePlayerUnicycle4D : public SinglePlayerDynamicalSystem {
   std::vector<Dimension> PositionDimensions() const { return {kPxIdx, kPyIdx}; }
 
   // Constexprs for state indices.
-  static const Dimension kNumXDims;
-  static const Dimension kPxIdx;
-  static const Dimension kPyIdx;
-  static const Dimension kThetaIdx;
-  static const Dimension kVIdx;
+  static constexpr Dimension kNumXDims = 4;
+  static constexpr Dimension kPxIdx = 0;
+  static constexpr Dimension kPyIdx = 1;
+  static constexpr Dimension kThetaIdx = 2;
+  static constexpr Dimension kVIdx = 3;
 
   // Constexprs for control indices.
-  static const Dimension kNumUDims;
-  static const Dimension kOmegaIdx;
-  static const Dimension kAIdx;
+  static constexpr Dimension kNumUDims = 2;
+  static constexpr Dimension kOmegaIdx = 0;
+  static constexpr Dimension kAIdx = 1;
+
+  // Fixed-size types and versions of Evaluate and Linearize, for use when
+  // dimensions are known at compile time. The dynamic-size versions above
+  // forward to these.
+  using StateVector = Eigen::Matrix<float, kNumXDims, 1>;
+  using ControlVector = Eigen::Matrix<float, kNumUDims, 1>;
+  using StateJacobian = Eigen::Matrix<float, kNumXDims, kNumXDims>;
+  using ControlJacobian = Eigen::Matrix<float, kNumXDims, kNumUDims>;
+  void EvaluateFixedSize(Time t, const Eigen::Ref<const StateVector>& x,
+                         const Eigen::Ref<const ControlVector>& u,
+                         Eigen::Ref<StateVector> xdot) const;
+  void LinearizeFixedSize(Time t, Time time_step,
+                          const Eigen::Ref<const StateVector>& x,
+                          const Eigen::Ref<const ControlVector>& u,
+                          Eigen::Ref<StateJacobian> A,
+                          Eigen::Ref<ControlJacobian> B) const;
 };  //\class SinglePlayerUnicycle4D
 
 // ----------------------------- IMPLEMENTATION ----------------------------- //
@@ -90,20 +106,34 @@ class SinglePlayerUnicycle4D : public SinglePlayerDynamicalSystem {
 inline VectorXf SinglePlayerUnicycle4D::Evaluate(Time t, const VectorXf& x,
                                                  const VectorXf& u) const {
   VectorXf xdot(xdim_);
-  xdot(kPxIdx) = x(kVIdx) * std::cos(x(kThetaIdx));
-  xdot(kPyIdx) = x(kVIdx) * std::sin(x(kThetaIdx));
-  xdot(kThetaIdx) = u(kOmegaIdx);
-  xdot(kVIdx) = u(kAIdx);
-
+  EvaluateFixedSize(t, x, u, xdot);
   return xdot;
 }
 
-inline void SinglePlayerUnicycle4D::Linearize(Time t, const VectorXf& x,
+inline void SinglePlayerUnicycle4D::Linearize(Time t, Time time_step,
+                                              const VectorXf& x,
                                               const VectorXf& u,
                                               Eigen::Ref<MatrixXf> A,
                                               Eigen::Ref<MatrixXf> B) const {
-  const float ctheta = std::cos(x(kThetaIdx)) * time::kTimeStep;
-  const float stheta = std::sin(x(kThetaIdx)) * time::kTimeStep;
+  LinearizeFixedSize(t, time_step, x, u, A, B);
+}
+
+inline void SinglePlayerUnicycle4D::EvaluateFixedSize(
+    Time t, const Eigen::Ref<const StateVector>& x,
+    const Eigen::Ref<const ControlVector>& u,
+    Eigen::Ref<StateVector> xdot) const {
+  xdot(kPxIdx) = x(kVIdx) * std::cos(x(kThetaIdx));
+  xdot(kPyIdx) = x(kVIdx) * std::sin(x(kThetaIdx));
+  xdot(kThetaIdx) = u(kOmegaIdx);
+  xdot(kVIdx) = u(kAIdx);
+}
+
+inline void SinglePlayerUnicycle4D::LinearizeFixedSize(
+    Time t, Time time_step, const Eigen::Ref<const StateVector>& x,
+    const Eigen::Ref<const ControlVector>& u, Eigen::Ref<StateJacobian> A,
+    Eigen::Ref<ControlJacobian> B) const {
+  const float ctheta = std::cos(x(kThetaIdx)) * time_step;
+  const float stheta = std::sin(x(kThetaIdx)) * time_step;
 
   A(kPxIdx, kThetaIdx) += -x(kVIdx) * stheta;
   A(kPxIdx, kVIdx) += ctheta;
@@ -111,8 +141,8 @@ inline void SinglePlayerUnicycle4D::Linearize(Time t, const VectorXf& x,
   A(kPyIdx, kThetaIdx) += x(kVIdx) * ctheta;
   A(kPyIdx, kVIdx) += stheta;
 
-  B(kThetaIdx, kOmegaIdx) = time::kTimeStep;
-  B(kVIdx, kAIdx) = time::kTimeStep;
+  B(kThetaIdx, kOmegaIdx) = time_step;
+  B(kVIdx, kAIdx) = time_step;
 }
 
 inline float SinglePlayerUnicycle4D::DistanceBetween(const VectorXf& x0,
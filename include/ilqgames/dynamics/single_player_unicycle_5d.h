@@ -64,7 +64,7 @@ class SinglePlayerUnicycle5D : public SinglePlayerDynamicalSystem {
   VectorXf Evaluate(Time t, const VectorXf& x, const VectorXf& u) const;
 
   // Compute a discrete-time Jacobian linearization.
-  void Linearize(Time t, const VectorXf& x, const VectorXf& u,
+  void Linearize(Time t, Time time_step, const VectorXf& x, const VectorXf& u,
                  Eigen::Ref<MatrixXf> A, Eigen::Ref<MatrixXf> B) const;
 
   // Distance metric between two states.
@@ -101,12 +101,13 @@ inline VectorXf SinglePlayerUnicycle5D::Evaluate(Time t, const VectorXf& x,
   return xdot;
 }
 
-inline void SinglePlayerUnicycle5D::Linearize(Time t, const VectorXf& x,
+inline void SinglePlayerUnicycle5D::Linearize(Time t, Time time_step,
+                                              const VectorXf& x,
                                               const VectorXf& u,
                                               Eigen::Ref<MatrixXf> A,
                                               Eigen::Ref<MatrixXf> B) const {
-  const float ctheta = std::cos(x(kThetaIdx)) * time::kTimeStep;
-  const float stheta = std::sin(x(kThetaIdx)) * time::kTimeStep;
+  const float ctheta = std::cos(x(kThetaIdx)) * time_step;
+  const float stheta = std::sin(x(kThetaIdx)) * time_step;
 
   A(kPxIdx, kThetaIdx) += -x(kVIdx) * stheta;
   A(kPxIdx, kVIdx) += ctheta;
@@ -114,10 +115,10 @@ inline void SinglePlayerUnicycle5D::Linearize(Time t, const VectorXf& x,
   A(kPyIdx, kThetaIdx) += x(kVIdx) * ctheta;
   A(kPyIdx, kVIdx) += stheta;
 
-  A(kSIdx, kVIdx) += time::kTimeStep;
+  A(kSIdx, kVIdx) += time_step;
 
-  B(kThetaIdx, kOmegaIdx) = time::kTimeStep;
-  B(kVIdx, kAIdx) = time::kTimeStep;
+  B(kThetaIdx, kOmegaIdx) = time_step;
+  B(kVIdx, kAIdx) = time_step;
 }
 
 inline float SinglePlayerUnicycle5D::DistanceBetween(const VectorXf& x0,
@@ -65,7 +65,8 @@ class TwoPlayerUnicycle4D : public MultiPlayerDynamicalSystem {
                     const std::vector<VectorXf>& us) const;
 
   // Compute a discrete-time Jacobian linearization.
-  LinearDynamicsApproximation Linearize(Time t, const VectorXf& x,
+  LinearDynamicsApproximation Linearize(Time t, Time time_step,
+                                        const VectorXf& x,
                                         const std::vector<VectorXf>& us) const;
 
   // Distance metric between two states.
@@ -117,11 +118,12 @@ inline VectorXf TwoPlayerUnicycle4D::Evaluate(
 }
 
 inline LinearDynamicsApproximation TwoPlayerUnicycle4D::Linearize(
-    Time t, const VectorXf& x, const std::vector<VectorXf>& us) const {
+    Time t, Time time_step, const VectorXf& x,
+    const std::vector<VectorXf>& us) const {
   LinearDynamicsApproximation linearization(*this);
 
-  const float ctheta = std::cos(x(kThetaIdx)) * time::kTimeStep;
-  const float stheta = std::sin(x(kThetaIdx)) * time::kTimeStep;
+  const float ctheta = std::cos(x(kThetaIdx)) * time_step;
+  const float stheta = std::sin(x(kThetaIdx)) * time_step;
 
   linearization.A(kPxIdx, kThetaIdx) += -x(kVIdx) * stheta;
   linearization.A(kPxIdx, kVIdx) += ctheta;
@@ -129,11 +131,11 @@ inline LinearDynamicsApproximation TwoPlayerUnicycle4D::Linearize(
   linearization.A(kPyIdx, kThetaIdx) += x(kVIdx) * ctheta;
   linearization.A(kPyIdx, kVIdx) += stheta;
 
-  linearization.Bs[0](kThetaIdx, kOmegaIdx) = time::kTimeStep;
-  linearization.Bs[0](kVIdx, kAIdx) = time::kTimeStep;
+  linearization.Bs[0](kThetaIdx, kOmegaIdx) = time_step;
+  linearization.Bs[0](kVIdx, kAIdx) = time_step;
 
-  linearization.Bs[1](kPxIdx, kDxIdx) = time::kTimeStep;
-  linearization.Bs[1](kPyIdx, kDyIdx) = time::kTimeStep;
+  linearization.Bs[1](kPxIdx, kDxIdx) = time_step;
+  linearization.Bs[1](kPyIdx, kDyIdx) = time_step;
 
   return linearization;
 }
@@ -52,7 +52,9 @@ namespace ilqgames {
 class Air3DExample : public TopDownRenderableProblem {
  public:
   ~Air3DExample() {}
-  Air3DExample() : TopDownRenderableProblem() {}
+  explicit Air3DExample(Time time_horizon = time::kDefaultTimeHorizon,
+                        Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
@@ -55,7 +55,9 @@ namespace ilqgames {
 class DubinsOriginExample : public TopDownRenderableProblem {
  public:
   ~DubinsOriginExample() {}
-  DubinsOriginExample() : TopDownRenderableProblem() {}
+  explicit DubinsOriginExample(Time time_horizon = time::kDefaultTimeHorizon,
+                               Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
@@ -40,8 +40,8 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
-#ifndef ILQGAMES_EXAMPLES_ROUNDABOUT_MERGING_EXAMPLE_H
-#define ILQGAMES_EXAMPLES_ROUNDABOUT_MERGING_EXAMPLE_H
+#ifndef ILQGAMES_EXAMPLES_FLAT_ROUNDABOUT_MERGING_EXAMPLE_H
+#define ILQGAMES_EXAMPLES_FLAT_ROUNDABOUT_MERGING_EXAMPLE_H
 
 #include <ilqgames/dynamics/concatenated_flat_system.h>
 #include <ilqgames/dynamics/multi_player_flat_system.h>
@@ -54,7 +54,10 @@ namespace ilqgames {
 class FlatRoundaboutMergingExample : public TopDownRenderableProblem {
  public:
   ~FlatRoundaboutMergingExample() {}
-  FlatRoundaboutMergingExample() : TopDownRenderableProblem() {}
+  explicit FlatRoundaboutMergingExample(
+      Time time_horizon = time::kDefaultTimeHorizon,
+      Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, initial operating point, player costs.
   void ConstructDynamics();
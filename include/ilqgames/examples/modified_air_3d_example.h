@@ -55,7 +55,9 @@ namespace ilqgames {
 class ModifiedAir3DExample : public TopDownRenderableProblem {
  public:
   ~ModifiedAir3DExample() {}
-  ModifiedAir3DExample() : TopDownRenderableProblem() {}
+  explicit ModifiedAir3DExample(Time time_horizon = time::kDefaultTimeHorizon,
+                                Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
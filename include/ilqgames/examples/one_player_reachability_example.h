@@ -52,7 +52,10 @@ namespace ilqgames {
 class OnePlayerReachabilityExample : public TopDownRenderableProblem {
  public:
   ~OnePlayerReachabilityExample() {}
-  OnePlayerReachabilityExample() : TopDownRenderableProblem() {}
+  explicit OnePlayerReachabilityExample(
+      Time time_horizon = time::kDefaultTimeHorizon,
+      Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
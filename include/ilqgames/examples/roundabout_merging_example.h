@@ -52,7 +52,10 @@ namespace ilqgames {
 class RoundaboutMergingExample : public TopDownRenderableProblem {
  public:
   ~RoundaboutMergingExample() {}
-  RoundaboutMergingExample() : TopDownRenderableProblem() {}
+  explicit RoundaboutMergingExample(
+      Time time_horizon = time::kDefaultTimeHorizon,
+      Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, initial operating point, player costs.
   void ConstructDynamics();
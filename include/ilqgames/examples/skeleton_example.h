@@ -54,7 +54,9 @@ namespace ilqgames {
 class SkeletonExample : public TopDownRenderableProblem {
  public:
   ~SkeletonExample() {}
-  SkeletonExample() : TopDownRenderableProblem() {}
+  explicit SkeletonExample(Time time_horizon = time::kDefaultTimeHorizon,
+                           Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
@@ -52,8 +52,10 @@ class ThreePlayerCollisionAvoidanceReachabilityExample
     : public TopDownRenderableProblem {
  public:
   ~ThreePlayerCollisionAvoidanceReachabilityExample() {}
-  ThreePlayerCollisionAvoidanceReachabilityExample()
-      : TopDownRenderableProblem() {}
+  explicit ThreePlayerCollisionAvoidanceReachabilityExample(
+      Time time_horizon = time::kDefaultTimeHorizon,
+      Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
@@ -53,7 +53,10 @@ namespace ilqgames {
 class ThreePlayerFlatIntersectionExample : public TopDownRenderableProblem {
  public:
   ~ThreePlayerFlatIntersectionExample() {}
-  ThreePlayerFlatIntersectionExample() : TopDownRenderableProblem() {}
+  explicit ThreePlayerFlatIntersectionExample(
+      Time time_horizon = time::kDefaultTimeHorizon,
+      Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
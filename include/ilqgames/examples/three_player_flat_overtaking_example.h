@@ -53,7 +53,10 @@ namespace ilqgames {
 class ThreePlayerFlatOvertakingExample : public TopDownRenderableProblem {
  public:
   ~ThreePlayerFlatOvertakingExample() {}
-  ThreePlayerFlatOvertakingExample() : TopDownRenderableProblem() {}
+  explicit ThreePlayerFlatOvertakingExample(
+      Time time_horizon = time::kDefaultTimeHorizon,
+      Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
@@ -54,7 +54,10 @@ class ThreePlayerIntersectionReachabilityExample
     : public TopDownRenderableProblem {
  public:
   ~ThreePlayerIntersectionReachabilityExample() {}
-  ThreePlayerIntersectionReachabilityExample() : TopDownRenderableProblem() {}
+  explicit ThreePlayerIntersectionReachabilityExample(
+      Time time_horizon = time::kDefaultTimeHorizon,
+      Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
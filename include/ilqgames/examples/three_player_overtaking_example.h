@@ -46,13 +46,19 @@
 #include <ilqgames/solver/problem.h>
 #include <ilqgames/solver/solver_params.h>
 #include <ilqgames/solver/top_down_renderable_problem.h>
+#include <ilqgames/utils/time_grid.h>
 
 namespace ilqgames {
 
 class ThreePlayerOvertakingExample : public TopDownRenderableProblem {
  public:
   ~ThreePlayerOvertakingExample() {}
-  ThreePlayerOvertakingExample() : TopDownRenderableProblem() {}
+  explicit ThreePlayerOvertakingExample(
+      Time time_horizon = time::kDefaultTimeHorizon,
+      Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
+  ThreePlayerOvertakingExample(Time time_horizon, const TimeGrid& time_grid)
+      : TopDownRenderableProblem(time_horizon, time_grid) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
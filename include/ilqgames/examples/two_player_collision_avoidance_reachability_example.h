@@ -52,8 +52,10 @@ class TwoPlayerCollisionAvoidanceReachabilityExample
     : public TopDownRenderableProblem {
  public:
   ~TwoPlayerCollisionAvoidanceReachabilityExample() {}
-  TwoPlayerCollisionAvoidanceReachabilityExample()
-      : TopDownRenderableProblem() {}
+  explicit TwoPlayerCollisionAvoidanceReachabilityExample(
+      Time time_horizon = time::kDefaultTimeHorizon,
+      Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
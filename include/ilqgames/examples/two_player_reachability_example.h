@@ -53,7 +53,10 @@ namespace ilqgames {
 class TwoPlayerReachabilityExample : public TopDownRenderableProblem {
  public:
   ~TwoPlayerReachabilityExample() {}
-  TwoPlayerReachabilityExample() : TopDownRenderableProblem() {}
+  explicit TwoPlayerReachabilityExample(
+      Time time_horizon = time::kDefaultTimeHorizon,
+      Time time_step = time::kDefaultTimeStep)
+      : TopDownRenderableProblem(time_horizon, time_step) {}
 
   // Construct dynamics, initial state, and player costs.
   void ConstructDynamics();
@@ -90,6 +90,9 @@ class AugmentedLagrangianSolver : public GameSolver {
                                    Time max_runtime = 5.0);
 
  private:
+  // Scale the augmented multiplier of every constraint in this problem.
+  void ScaleMu(float scale);
+
   // Lower level (unconstrained) solver.
   std::unique_ptr<ILQSolver> unconstrained_solver_;
 };  // class AugmentedLagrangianSolver
@@ -52,11 +52,17 @@
 #include <ilqgames/utils/linear_dynamics_approximation.h>
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/quadratic_cost_approximation.h>
+#include <ilqgames/utils/quantile_timer.h>
 #include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/solver_telemetry.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/thread_pool.h>
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <vector>
@@ -69,17 +75,68 @@ class ILQSolver : public GameSolver {
   ILQSolver(const std::shared_ptr<Problem>& problem,
             const SolverParams& params = SolverParams())
       : GameSolver(problem, params),
-        linearization_(time::kNumTimeSteps),
-        cost_quadraticization_(time::kNumTimeSteps),
+        linearization_(problem->NumTimeSteps()),
+        cost_quadraticization_(problem->NumTimeSteps()),
+        times_of_extreme_costs_(problem->PlayerCosts().size(), 0),
+        last_operating_point_(problem->NumTimeSteps(), 0.0,
+                              problem->Dynamics()),
+        delta_x_(problem->Dynamics()->XDim()),
         last_merit_function_value_(constants::kInfinity),
-        expected_decrease_(constants::kInfinity) {
+        expected_decrease_(constants::kInfinity),
+        max_runtime_(constants::kInfinity),
+        reached_deadline_(false),
+        current_operating_point_(problem->NumTimeSteps(), 0.0,
+                                 problem->Dynamics()),
+        num_iterations_(0),
+        has_converged_(false),
+        failed_(false),
+        terminated_(true),
+        elapsed_(0.0),
+        linearization_reference_(problem->NumTimeSteps(), 0.0,
+                                 problem->Dynamics()),
+        quadraticization_reference_(problem->NumTimeSteps(), 0.0,
+                                    problem->Dynamics()),
+        has_linearization_reference_(false),
+        has_quadraticization_reference_(false),
+        changed_time_steps_(problem->NumTimeSteps(), true),
+        num_reused_linearizations_(0),
+        num_reused_quadraticizations_(0),
+        segment_dx_(problem->Dynamics()->XDim()),
+        next_segment_dx_(problem->Dynamics()->XDim()) {
     // Set up LQ solver.
     if (params_.open_loop)
-      lq_solver_.reset(
-          new LQOpenLoopSolver(problem_->Dynamics(), time::kNumTimeSteps));
+      lq_solver_.reset(new LQOpenLoopSolver(problem_->Dynamics(),
+                                            problem_->NumTimeSteps()));
     else
-      lq_solver_.reset(
-          new LQFeedbackSolver(problem_->Dynamics(), time::kNumTimeSteps));
+      lq_solver_.reset(new LQFeedbackSolver(problem_->Dynamics(),
+                                            problem_->NumTimeSteps(),
+                                            params_.lq_solver_backend));
+
+    // Maybe set up a thread pool for linearization and quadraticization.
+    if (params_.num_threads > 1)
+      thread_pool_.reset(new ThreadPool(params_.num_threads));
+
+    // Maybe run the LQ solver's forward pass in parallel in time.
+    if (params_.num_lq_time_chunks > 1)
+      lq_solver_->SetTimeChunks(params_.num_lq_time_chunks, thread_pool_.get());
+
+    // Split the horizon into shooting segments, and preallocate their
+    // workspaces.
+    const size_t num_segments = std::max<size_t>(
+        1, std::min(params_.num_shooting_segments, problem_->NumTimeSteps()));
+    for (size_t jj = 0; jj < num_segments; jj++) {
+      segment_starts_.push_back(jj * problem_->NumTimeSteps() / num_segments);
+      segment_steps_.push_back(VectorXf::Zero(problem_->Dynamics()->XDim()));
+      segment_delta_xs_.emplace_back(problem_->Dynamics()->XDim());
+      defects_.push_back(VectorXf::Zero(problem_->Dynamics()->XDim()));
+    }
+    segment_integration_workspaces_.resize(num_segments);
+
+    // The final single shooting rollout (see `Finish`) would not be accounted
+    // for by a hard deadline.
+    CHECK(num_segments == 1 || !params_.hard_deadline);
+    for (PlayerIndex ii = 0; ii < problem_->Dynamics()->NumPlayers(); ii++)
+      segment_dus_.emplace_back(problem_->Dynamics()->UDim(ii));
 
     // If this system is flat then compute the linearization once, now.
     if (problem_->Dynamics()->TreatAsLinear())
@@ -92,6 +149,33 @@ class ILQSolver : public GameSolver {
 
     // Set last quadraticization to current, to start.
     last_cost_quadraticization_ = cost_quadraticization_;
+
+    // Maybe preallocate a cache for lazy requadraticization.
+    if (params_.relinearization_tolerance > 0.0)
+      cached_cost_quadraticization_ = cost_quadraticization_;
+
+    // Preallocate temporaries for computing the expected decrease.
+    for (PlayerIndex ii = 0; ii < problem_->Dynamics()->NumPlayers(); ii++) {
+      control_grads_.emplace_back(problem_->Dynamics()->UDim(ii));
+      control_steps_.emplace_back(problem_->Dynamics()->UDim(ii));
+    }
+
+    // Maybe preallocate workspaces for a speculative linesearch.
+    if (params_.linesearch && params_.num_speculative_steps > 1) {
+      const size_t num_candidates = std::min(params_.num_speculative_steps,
+                                             params_.max_backtracking_steps);
+      for (size_t jj = 0; jj < num_candidates; jj++) {
+        linesearch_candidates_.push_back(
+            {{},
+             OperatingPoint(problem_->NumTimeSteps(), 0.0,
+                            problem_->Dynamics()),
+             VectorXf(problem_->Dynamics()->XDim()),
+             {},
+             cost_quadraticization_,
+             constants::kInfinity,
+             0.0});
+      }
+    }
   }
 
   // Solve this game. Returns true if converged.
@@ -99,6 +183,14 @@ class ILQSolver : public GameSolver {
       bool* success = nullptr,
       Time max_runtime = std::numeric_limits<Time>::infinity());
 
+  // Optionally, set a function to be called on the log after each accepted
+  // iterate. If it returns true, the solver stops early and returns the last
+  // accepted iterate, e.g., so that a higher-level solver can cancel it.
+  void SetStopCallback(
+      const std::function<bool(const SolverLog&)>& stop_callback) {
+    stop_callback_ = stop_callback;
+  }
+
   // Accessors.
   // NOTE: these should be primarily used by higher-level solvers.
   std::vector<std::vector<QuadraticCostApproximation>>* Quadraticization() {
@@ -109,7 +201,36 @@ class ILQSolver : public GameSolver {
     return &linearization_;
   }
 
+  // Number of time steps at which a linearization or a (full) quadraticization
+  // was reused rather than recomputed during the current or last solve (see
+  // `SolverParams::relinearization_tolerance`).
+  size_t NumReusedLinearizations() const { return num_reused_linearizations_; }
+  size_t NumReusedQuadraticizations() const {
+    return num_reused_quadraticizations_;
+  }
+
  protected:
+  // Steps of `Solve`, which calls these in sequence. `Start` logs the initial
+  // iterate, each call to `Step` runs a single iteration and returns false once
+  // the solve has terminated, and `Finish` records the outcome and returns the
+  // log. With multiple shooting, if the last accepted iterate has defects
+  // beyond `SolverParams::defect_tolerance`, `Finish` first logs a single
+  // shooting rollout which tracks it (see `LogSingleShootingRollout`).
+  const std::shared_ptr<SolverLog>& Start(
+      Time max_runtime = std::numeric_limits<Time>::infinity());
+  bool Step();
+  std::shared_ptr<SolverLog> Finish(bool* success = nullptr);
+
+  // Run a single iteration of the solver from the given operating point and
+  // strategies (both of which are overwritten): linearize dynamics, solve the
+  // LQ game, and modify its solution. Returns false if the linesearch fails or
+  // if the deadline is reached (see `SolverParams::hard_deadline`), in which
+  // case `reached_deadline_` is set. Once all the member workspaces have been
+  // sized (i.e., after the first iteration), this does not allocate memory as
+  // long as the dynamics and costs support in-place evaluation.
+  bool Iterate(std::vector<Strategy>* current_strategies,
+               OperatingPoint* current_operating_point, bool* has_converged);
+
   // Modify LQ strategies to improve convergence properties.
   // This function performs an Armijo linesearch and returns true if successful.
   bool ModifyLQStrategies(const std::vector<VectorXf>& delta_xs,
@@ -118,6 +239,18 @@ class ILQSolver : public GameSolver {
                           OperatingPoint* current_operating_point,
                           bool* has_converged);
 
+  // Check whether there is (probably) enough time before the deadline to run
+  // the phase timed by the given timer and then log the result. If not, and
+  // the deadline is hard, records that the deadline has been reached.
+  bool HasTimeFor(const QuantileTimer& phase_timer);
+
+  // Where to record trace events for the phases of the current iterate, or
+  // null if the solver is not recording them.
+  std::vector<TraceEvent>* TraceEvents() {
+    return (params_.record_trace && log_) ? log_->MutableTraceEvents()
+                                          : nullptr;
+  }
+
   // Compute distance (infinity norm) between states in the given dimensions.
   // If dimensions empty, checks all dimensions.
   float StateDistance(const VectorXf& x1, const VectorXf& x2,
@@ -129,9 +262,10 @@ class ILQSolver : public GameSolver {
            params_.convergence_tolerance;
   }
 
-  // Compute overall costs and set times of extreme costs.
+  // Compute overall costs and record the times of extreme costs, which are
+  // used when quadraticizing max- and min-over-time player costs.
   void TotalCosts(const OperatingPoint& current_op,
-                  std::vector<float>* total_costs) const;
+                  std::vector<float>* total_costs);
 
   // Armijo condition check. Returns true if the new operating point satisfies
   // the Armijo condition, and also returns current merit function value.
@@ -139,25 +273,100 @@ class ILQSolver : public GameSolver {
                             float current_stepsize) const;
 
   // Compute current merit function value. Note that to compute the merit
-  // function at the given operating point we have to compute a full cost
-  // quadraticization there. To do so efficiently, this will overwrite the
-  // current cost quadraticization (and presume it has already been used to
-  // compute the expected decrease from the last iterate).
-  float MeritFunction(const OperatingPoint& current_op);
+  // function at the given operating point we have to compute cost gradients
+  // there. To do so efficiently, this will overwrite the current cost
+  // quadraticization (and presume it has already been used to compute the
+  // expected decrease from the last iterate). If `full_quadraticization` is
+  // false, only gradients are computed and Hessians are left unspecified.
+  // With multiple shooting, this includes the penalty on defects between
+  // segments (see `DefectPenalty`).
+  float MeritFunction(const OperatingPoint& current_op,
+                      bool full_quadraticization = true);
+
+  // Merit function value given the cost gradients at an operating point,
+  // excluding any defect penalty.
+  float MeritFunction(
+      const std::vector<std::vector<QuadraticCostApproximation>>& q) const;
 
   // Compute expected decrease based on current cost quadraticization,
   // (player-indexed) strategies, and (time-indexed) lists of delta states and
-  // (also player-indexed) costates.
-  float ExpectedDecrease(
-      const std::vector<Strategy>& strategies,
-      const std::vector<VectorXf>& delta_xs,
-      const std::vector<std::vector<VectorXf>>& costates) const;
+  // (also player-indexed) costates. With multiple shooting, this includes the
+  // expected decrease of the defect penalty, given that the LQ step closes all
+  // of the defects last computed in `defects_` to first order.
+  float ExpectedDecrease(const std::vector<Strategy>& strategies,
+                         const std::vector<VectorXf>& delta_xs,
+                         const std::vector<std::vector<VectorXf>>& costates);
 
   // Compute the current operating point based on the current set of
-  // strategies and the last operating point.
+  // strategies and the last operating point. With multiple shooting, each
+  // segment starts from the last operating point moved by the given fraction
+  // (i.e., the step size of the current strategies) of the last LQ step, and
+  // segments are rolled out in parallel if a thread pool is available.
   void CurrentOperatingPoint(const OperatingPoint& last_operating_point,
                              const std::vector<Strategy>& current_strategies,
-                             OperatingPoint* current_operating_point) const;
+                             float step_size,
+                             OperatingPoint* current_operating_point);
+
+  // Same as above, but using the given temporaries rather than the solver's
+  // own (and rolling out segments one at a time), so that several operating
+  // points may be computed concurrently.
+  void CurrentOperatingPoint(
+      const OperatingPoint& last_operating_point,
+      const std::vector<Strategy>& current_strategies, float step_size,
+      VectorXf* delta_x,
+      MultiPlayerIntegrableSystem::IntegrationWorkspace* integration_workspace,
+      OperatingPoint* current_operating_point) const;
+
+  // Roll out time steps [start, stop) of the current operating point, starting
+  // from its state at `start` (or the initial state, if `start` is zero) and
+  // following the given strategies about the last operating point.
+  void RollOut(
+      size_t start, size_t stop, const OperatingPoint& last_operating_point,
+      const std::vector<Strategy>& current_strategies, VectorXf* delta_x,
+      MultiPlayerIntegrableSystem::IntegrationWorkspace* integration_workspace,
+      OperatingPoint* current_operating_point) const;
+
+  // Roll out a single shooting segment, as above.
+  void RollOutSegment(
+      size_t segment, const OperatingPoint& last_operating_point,
+      const std::vector<Strategy>& current_strategies, float step_size,
+      VectorXf* delta_x,
+      MultiPlayerIntegrableSystem::IntegrationWorkspace* integration_workspace,
+      OperatingPoint* current_operating_point) const;
+
+  // Is the solver using multiple shooting?
+  bool IsMultipleShooting() const { return segment_starts_.size() > 1; }
+
+  // Compute the defect at the start of each shooting segment (after the first)
+  // of the given operating point, i.e., the integrated state from the end of
+  // the previous segment minus the segment's start state. Returns the largest
+  // defect (in the infinity norm).
+  float ComputeDefects(const OperatingPoint& op);
+
+  // Compute the defect at the start of the given shooting segment (after the
+  // first), using the given temporary, as above.
+  void ComputeDefect(
+      size_t segment, const OperatingPoint& op,
+      MultiPlayerIntegrableSystem::IntegrationWorkspace* integration_workspace,
+      VectorXf* defect) const;
+
+  // Penalty on the defects between shooting segments of the given operating
+  // point, i.e., half the sum of their squared norms, computed with the given
+  // temporaries. This is zero with single shooting.
+  float DefectPenalty(
+      const OperatingPoint& op,
+      MultiPlayerIntegrableSystem::IntegrationWorkspace* integration_workspace,
+      VectorXf* defect) const;
+
+  // Roll out the final iterate's strategies about its own operating point
+  // without their feedforward terms (i.e., track it with feedback), in a single
+  // shooting rollout from the initial state, and log the result as a new final
+  // iterate.
+  void LogSingleShootingRollout();
+
+  // Compute the change in the start state of each shooting segment predicted
+  // by the linearized dynamics for the given (full step) strategies.
+  void ComputeSegmentSteps(const std::vector<Strategy>& strategies);
 
   // Populate the given vector with a linearization of the dynamics about
   // the given operating point. Provide version with no operating point for use
@@ -173,6 +382,69 @@ class ILQSolver : public GameSolver {
       const OperatingPoint& op,
       std::vector<std::vector<QuadraticCostApproximation>>* q);
 
+  // Compute only the gradients of the cost at the given operating point.
+  // Hessians in `q` are left unspecified. Also provide a version for a single
+  // (time step, player) pair.
+  void ComputeCostGradients(
+      const OperatingPoint& op,
+      std::vector<std::vector<QuadraticCostApproximation>>* q);
+  void ComputeCostGradient(const OperatingPoint& op, size_t kk, PlayerIndex ii,
+                           QuadraticCostApproximation* q) const;
+
+  // For lazy relinearization and requadraticization, mark the time steps at
+  // which the given operating point differs from the reference one by more
+  // than `params_.relinearization_tolerance` in `changed_time_steps_`, and
+  // return the number of unchanged time steps. All time steps are marked
+  // changed if there is no reference.
+  size_t FindChangedTimeSteps(const OperatingPoint& op,
+                              const OperatingPoint& reference,
+                              bool has_reference);
+
+  // Copy the changed time steps of the given operating point into the
+  // reference one.
+  void UpdateReference(const OperatingPoint& op,
+                       OperatingPoint* reference) const;
+
+  // Is lazy relinearization and requadraticization enabled?
+  bool IsLazy() const { return params_.relinearization_tolerance > 0.0; }
+
+  // Workspace for one candidate step in the speculative linesearch.
+  struct LinesearchCandidate {
+    std::vector<Strategy> strategies;
+    OperatingPoint operating_point;
+    VectorXf delta_x;
+    MultiPlayerIntegrableSystem::IntegrationWorkspace integration_workspace;
+    std::vector<std::vector<QuadraticCostApproximation>> cost_gradients;
+    float merit_function_value;
+    float step_size;
+  };  // struct LinesearchCandidate
+
+  // Linesearch which rolls out and scores several step sizes at once, starting
+  // from the given (already scaled) strategies and `last_operating_point_`.
+  // Accepts the largest step which satisfies the Armijo condition, with the
+  // same result as the serial linesearch in `ModifyLQStrategies`.
+  bool SpeculativeLinesearch(std::vector<Strategy>* strategies,
+                             OperatingPoint* current_operating_point,
+                             bool* has_converged);
+
+  // Roll out and score a single linesearch candidate. Runs serially, so that
+  // several candidates can be evaluated concurrently.
+  void EvaluateLinesearchCandidate(LinesearchCandidate* candidate) const;
+
+  // Evaluate f(ii) for ii in [0, num_tasks), in parallel if a thread pool is
+  // available. Each call must write only to its own output. This is a template
+  // so that `f` is only ever wrapped by reference (which avoids allocating
+  // memory for lambdas with large captures).
+  template <typename F>
+  void ParallelFor(size_t num_tasks, const F& f) {
+    if (thread_pool_) {
+      thread_pool_->ParallelFor(num_tasks, std::cref(f));
+      return;
+    }
+
+    for (size_t ii = 0; ii < num_tasks; ii++) f(ii);
+  }
+
   // Linearization and quadraticization. Both are time-indexed (and
   // quadraticizations' inner vector is indexed by player). Also keep track of
   // the quadraticization from last iteration.
@@ -181,12 +453,100 @@ class ILQSolver : public GameSolver {
   std::vector<std::vector<QuadraticCostApproximation>>
       last_cost_quadraticization_;
 
+  // Time index of the extreme cost for each player, as of the last call to
+  // TotalCosts. This is only meaningful for players whose cost is an extremum
+  // over time, and it is kept here (rather than in the problem's player costs)
+  // so that solvers do not write to shared problem state.
+  std::vector<size_t> times_of_extreme_costs_;
+
+  // Preallocated workspaces, so that iterations after the first do not
+  // allocate memory. These include the operating point from before the
+  // linesearch, delta xs and costates from the LQ solve, and temporaries for
+  // integration and (player-indexed) expected decrease terms.
+  OperatingPoint last_operating_point_;
+  std::vector<VectorXf> delta_xs_;
+  std::vector<std::vector<VectorXf>> costates_;
+  VectorXf delta_x_;
+  MultiPlayerIntegrableSystem::IntegrationWorkspace integration_workspace_;
+  std::vector<VectorXf> control_grads_;
+  std::vector<VectorXf> control_steps_;
+
+  // Candidate workspaces for the speculative linesearch. Empty unless
+  // `params_.num_speculative_steps` is greater than 1.
+  std::vector<LinesearchCandidate> linesearch_candidates_;
+
   // Core LQ Solver.
   std::unique_ptr<LQSolver> lq_solver_;
 
+  // Optional thread pool. Null unless more than one thread is requested.
+  std::unique_ptr<ThreadPool> thread_pool_;
+
   // Last merit function value and expected decreases (per step length).
   float last_merit_function_value_;
   float expected_decrease_;
+
+  // Timers for each phase of an iteration (linearization, LQ solve, a single
+  // step, or round of speculative steps, of the linesearch, and computing
+  // total costs and logging), which are used to predict whether the next phase
+  // will finish before the deadline.
+  QuantileTimer linearization_timer_;
+  QuantileTimer lq_solve_timer_;
+  QuantileTimer linesearch_timer_;
+  QuantileTimer logging_timer_;
+
+  // Start time and maximum runtime of the current call to `Solve`, and whether
+  // it has reached its deadline.
+  std::chrono::time_point<Clock> solver_call_time_;
+  Time max_runtime_;
+  bool reached_deadline_;
+
+  // State of the current solve: its log, the current iterate and its total
+  // costs, the number of iterations so far, whether it has converged, failed,
+  // or otherwise terminated, the runtime of all iterations so far, and the
+  // telemetry of the current iterate.
+  std::shared_ptr<SolverLog> log_;
+  OperatingPoint current_operating_point_;
+  std::vector<Strategy> current_strategies_;
+  std::vector<float> total_costs_;
+  size_t num_iterations_;
+  bool has_converged_;
+  bool failed_;
+  bool terminated_;
+  Time elapsed_;
+  IterateTelemetry telemetry_;
+
+  // Lazy relinearization and requadraticization state: the operating points
+  // about which each time step was last linearized and quadraticized, whether
+  // they are valid for the current solve, the cached quadraticization, which
+  // time steps changed in the last comparison, and the number of reused
+  // linearizations and quadraticizations in the current solve.
+  OperatingPoint linearization_reference_;
+  OperatingPoint quadraticization_reference_;
+  bool has_linearization_reference_;
+  bool has_quadraticization_reference_;
+  std::vector<std::vector<QuadraticCostApproximation>>
+      cached_cost_quadraticization_;
+  std::vector<char> changed_time_steps_;
+  size_t num_reused_linearizations_;
+  size_t num_reused_quadraticizations_;
+
+  // Multiple shooting state: the first time step of each segment, the change
+  // in each segment's start state predicted by the last LQ step (for a full
+  // step), the defect at the start of each segment, and temporaries for
+  // rolling out segments concurrently and for predicting the changes in their
+  // start states. Only the first segment is used for single shooting.
+  std::vector<size_t> segment_starts_;
+  std::vector<VectorXf> segment_steps_;
+  std::vector<VectorXf> defects_;
+  std::vector<VectorXf> segment_delta_xs_;
+  std::vector<MultiPlayerIntegrableSystem::IntegrationWorkspace>
+      segment_integration_workspaces_;
+  VectorXf segment_dx_;
+  VectorXf next_segment_dx_;
+  std::vector<VectorXf> segment_dus_;
+
+  // Optional function deciding whether to stop after each accepted iterate.
+  std::function<bool(const SolverLog&)> stop_callback_;
 };  // class ILQSolver
 
 }  // namespace ilqgames
@@ -37,9 +37,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Core LQ game solver from Basar and Olsder, "Preliminary Notation for
-// Corollary 6.1" (pp. 279). All notation matches the text, though we
-// shall assume that `c` (additive drift in dynamics) is always `0`, which
-// holds because these dynamics are for delta x, delta us.
+// Corollary 6.1" (pp. 279). All notation matches the text, though `c`
+// (additive drift in dynamics) is `0` unless the linearization has a drift
+// term, since these dynamics are for delta x, delta us. Drift only arises
+// from defects in operating points which are not dynamically feasible (e.g.,
+// with multiple shooting).
 // Also, we have modified terms slightly to account for linear terms in the
 // stage cost for control, i.e.
 //       control penalty i = 0.5 \sum_j du_j^T R_ij (du_j + 2 r_ij)
@@ -59,10 +61,13 @@
 
 #include <ilqgames/dynamics/multi_player_integrable_system.h>
 #include <ilqgames/solver/lq_solver.h>
+#include <ilqgames/solver/solver_params.h>
 #include <ilqgames/utils/linear_dynamics_approximation.h>
 #include <ilqgames/utils/quadratic_cost_approximation.h>
 #include <ilqgames/utils/strategy.h>
 
+#include <glog/logging.h>
+#include <algorithm>
 #include <vector>
 
 namespace ilqgames {
@@ -72,8 +77,8 @@ class LQFeedbackSolver : public LQSolver {
   ~LQFeedbackSolver() {}
   LQFeedbackSolver(
       const std::shared_ptr<const MultiPlayerIntegrableSystem>& dynamics,
-      size_t num_time_steps)
-      : LQSolver(dynamics, num_time_steps) {
+      size_t num_time_steps, LQSolverBackend backend = HOUSEHOLDER_QR)
+      : LQSolver(dynamics, num_time_steps), backend_(backend) {
     // Cache the total number of control dimensions, since this is inefficient
     // to compute.
     const Dimension total_udim = dynamics_->TotalUDim();
@@ -95,34 +100,97 @@ class LQFeedbackSolver : public LQSolver {
       cumulative_udim += dynamics_->UDim(ii);
     }
 
-    // Initialize Zs and zetas for each time and player. Note that we need to
-    // store over all time to compute optimal costates if desired.
+    // Initialize Zs and zetas for each time, with all players side by side.
+    // Note that we need to store over all time to compute optimal costates if
+    // desired.
+    const Dimension stacked_xdim = dynamics_->NumPlayers() * dynamics_->XDim();
     Zs_.resize(num_time_steps_);
     zetas_.resize(num_time_steps_);
     for (size_t kk = 0; kk < num_time_steps_; kk++) {
-      Zs_[kk].resize(dynamics_->NumPlayers());
-      zetas_[kk].resize(dynamics_->NumPlayers());
-      for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
-        Zs_[kk][ii].resize(dynamics_->XDim(), dynamics_->XDim());
-        zetas_[kk][ii].resize(dynamics_->XDim());
-      }
+      Zs_[kk].resize(dynamics_->XDim(), stacked_xdim);
+      zetas_[kk].resize(dynamics_->XDim(), dynamics_->NumPlayers());
     }
 
     // Preallocate memory for intermediate variables F, beta.
     F_.resize(dynamics_->XDim(), dynamics_->XDim());
     beta_.resize(dynamics_->XDim());
+
+    // Preallocate memory for the decomposition(s) of S used by the chosen
+    // backend and the rest of the temporaries so that Solve does not touch the
+    // heap. QR is needed by every backend, since the others fall back to it
+    // when S is numerically singular.
+    qr_ = Eigen::HouseholderQR<MatrixXf>(total_udim, total_udim);
+    qr_workspace_.resize(dynamics_->XDim() + 1);
+    switch (backend_) {
+      case HOUSEHOLDER_QR:
+        break;
+      case PARTIAL_PIV_LU:
+        lu_ = Eigen::PartialPivLU<MatrixXf>(total_udim);
+        break;
+      case BLOCK_SCHUR: {
+        Dimension max_udim = 0;
+        for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
+          block_lus_.emplace_back(dynamics_->UDim(ii));
+          max_udim = std::max(max_udim, dynamics_->UDim(ii));
+        }
+        schur_workspace_.resize(
+            max_udim, std::max(total_udim, dynamics_->XDim() + 1));
+        S_copy_.resize(total_udim, total_udim);
+        Y_copy_.resize(total_udim, dynamics_->XDim() + 1);
+        break;
+      }
+      default:
+        LOG(FATAL) << "Unknown LQ solver backend: " << backend_;
+    }
+
+    FZ_.resize(dynamics_->XDim(), stacked_xdim);
+    Zbeta_.resize(stacked_xdim);
+    zeta_.resize(dynamics_->XDim(), dynamics_->NumPlayers());
+    drift_zeta_.resize(dynamics_->XDim(), dynamics_->NumPlayers());
+    x_star_.resize(dynamics_->XDim());
+    last_x_star_.resize(dynamics_->XDim());
+    for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
+      BiZis_.emplace_back(dynamics_->UDim(ii), dynamics_->XDim());
+      RPs_.emplace_back(dynamics_->UDim(ii), dynamics_->XDim());
+      us_.emplace_back(dynamics_->UDim(ii));
+    }
   }
 
   // Solve underlying LQ game to a feedback Nash equilibrium.
   // Optionally return delta xs and costates.
-  std::vector<Strategy> Solve(
-      const std::vector<LinearDynamicsApproximation>& linearization,
-      const std::vector<std::vector<QuadraticCostApproximation>>&
-          quadraticization,
-      const VectorXf& x0, std::vector<VectorXf>* delta_xs = nullptr,
-      std::vector<std::vector<VectorXf>>* costates = nullptr);
+  using LQSolver::Solve;
+  void Solve(const std::vector<LinearDynamicsApproximation>& linearization,
+             const std::vector<std::vector<QuadraticCostApproximation>>&
+                 quadraticization,
+             const VectorXf& x0, std::vector<Strategy>* strategies,
+             std::vector<VectorXf>* delta_xs = nullptr,
+             std::vector<std::vector<VectorXf>>* costates = nullptr);
 
  private:
+  // Compute delta xs and costates in parallel in time (see
+  // `LQSolver::SetTimeChunks`) once the backward pass is done.
+  void ParallelForwardPass(
+      const std::vector<LinearDynamicsApproximation>& linearization,
+      const std::vector<Strategy>& strategies, const VectorXf& x0,
+      std::vector<VectorXf>* delta_xs,
+      std::vector<std::vector<VectorXf>>* costates);
+
+  // Solve S X = Y (in place, so S and Y are overwritten) with the chosen
+  // backend. The LU and block Schur backends fall back to QR if S (or one of
+  // its diagonal blocks) is numerically singular.
+  void SolveCoupledSystem();
+  void SolveCoupledSystemQR();
+  void SolveCoupledSystemLU();
+  void SolveCoupledSystemBlockSchur();
+
+  // Player ii's block of Zs_[kk].
+  MatrixXf::ColsBlockXpr Z(size_t kk, PlayerIndex ii) {
+    return Zs_[kk].middleCols(ii * dynamics_->XDim(), dynamics_->XDim());
+  }
+
+  // Which method to use in the linear solve.
+  const LQSolverBackend backend_;
+
   // Quadratic/linear components of value function at the current time step in
   // the dynamic program.
   // NOTE: since these will be computed by solving a big
@@ -133,13 +201,44 @@ class LQFeedbackSolver : public LQSolver {
   std::vector<Eigen::Ref<MatrixXf>> Ps_;
   std::vector<Eigen::Ref<VectorXf>> alphas_;
 
-  // Initialize Zs and zetas for each time and player.
-  std::vector<std::vector<MatrixXf>> Zs_;
-  std::vector<std::vector<VectorXf>> zetas_;
+  // Quadratic and linear terms of each player's value function at each time.
+  // Players are stored side by side, i.e., player ii's Z occupies columns
+  // [ii * xdim, (ii + 1) * xdim) of Zs_[kk] and its zeta is column ii of
+  // zetas_[kk], so that products with F can be batched across players.
+  std::vector<MatrixXf> Zs_;
+  std::vector<MatrixXf> zetas_;
 
   // Preallocate memory for intermediate variables F, beta.
   MatrixXf F_;
   VectorXf beta_;
+
+  // Decomposition of S and workspace for applying its Householder reflectors.
+  Eigen::HouseholderQR<MatrixXf> qr_;
+  Eigen::Matrix<float, 1, Eigen::Dynamic> qr_workspace_;
+
+  // Decomposition of S for the LU backend.
+  Eigen::PartialPivLU<MatrixXf> lu_;
+
+  // Decompositions of the diagonal block of S (after eliminating earlier
+  // players) for each player, workspace for applying their permutations, and
+  // copies of S and Y to restore before falling back to QR, for the block
+  // Schur backend.
+  std::vector<Eigen::PartialPivLU<MatrixXf>> block_lus_;
+  MatrixXf schur_workspace_;
+  MatrixXf S_copy_, Y_copy_;
+
+  // Temporaries for products in the backward and forward passes. FZ, Zbeta,
+  // zeta, and drift_zeta (the next zetas, accounting for drift) are stacked
+  // across players like Zs and zetas, and BiZis, RPs, and us are
+  // player-indexed.
+  MatrixXf FZ_;
+  Eigen::Matrix<float, 1, Eigen::Dynamic> Zbeta_;
+  MatrixXf zeta_;
+  MatrixXf drift_zeta_;
+  VectorXf x_star_, last_x_star_;
+  std::vector<MatrixXf> BiZis_;
+  std::vector<MatrixXf> RPs_;
+  std::vector<VectorXf> us_;
 };  // LQFeedbackSolver
 
 }  // namespace ilqgames
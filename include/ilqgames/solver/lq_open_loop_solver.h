@@ -37,10 +37,12 @@
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Core open-loop LQ game solver based on Basar and Olsder, Chapter 6. All
-// notation matches the text, though we shall assume that `c` (additive drift in
-// dynamics) is always `0`, which holds because these dynamics are for delta x,
-// delta us. Also, we have modified terms slightly to account for linear terms
-// in the stage cost for control, i.e.
+// notation matches the text, though `c` (additive drift in dynamics) is `0`
+// unless the linearization has a drift term, since these dynamics are for
+// delta x, delta us. Drift only arises from defects in operating points which
+// are not dynamically feasible (e.g., with multiple shooting). Also, we have
+// modified terms slightly to account for linear terms in the stage cost for
+// control, i.e.
 //       control penalty i = 0.5 \sum_j du_j^T R_ij (du_j + 2 r_ij)
 //
 // Solve a time-varying, finite horizon LQ game (finds open-loop Nash
@@ -112,14 +114,22 @@ class LQOpenLoopSolver : public LQSolver {
 
   // Solve underlying LQ game to a open-loop Nash equilibrium.
   // Optionally return delta xs and costates.
-  std::vector<Strategy> Solve(
-      const std::vector<LinearDynamicsApproximation>& linearization,
-      const std::vector<std::vector<QuadraticCostApproximation>>&
-          quadraticization,
-      const VectorXf& x0, std::vector<VectorXf>* delta_xs = nullptr,
-      std::vector<std::vector<VectorXf>>* costates = nullptr);
+  using LQSolver::Solve;
+  void Solve(const std::vector<LinearDynamicsApproximation>& linearization,
+             const std::vector<std::vector<QuadraticCostApproximation>>&
+                 quadraticization,
+             const VectorXf& x0, std::vector<Strategy>* strategies,
+             std::vector<VectorXf>* delta_xs = nullptr,
+             std::vector<std::vector<VectorXf>>* costates = nullptr);
 
  private:
+  // Forward pass, in parallel in time (see `LQSolver::SetTimeChunks`).
+  void ParallelForwardPass(
+      const std::vector<LinearDynamicsApproximation>& linearization,
+      const VectorXf& x0, std::vector<Strategy>* strategies,
+      std::vector<VectorXf>* delta_xs,
+      std::vector<std::vector<VectorXf>>* costates);
+
   // Initialize Ms and ms.
   std::vector<std::vector<VectorXf>> ms_;
   std::vector<std::vector<MatrixXf>> Ms_;
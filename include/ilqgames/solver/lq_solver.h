@@ -45,11 +45,15 @@
 #define ILQGAMES_SOLVER_LQ_SOLVER_H
 
 #include <ilqgames/dynamics/multi_player_integrable_system.h>
+#include <ilqgames/utils/affine_scan.h>
 #include <ilqgames/utils/linear_dynamics_approximation.h>
 #include <ilqgames/utils/quadratic_cost_approximation.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/thread_pool.h>
 
 #include <glog/logging.h>
+#include <functional>
+#include <memory>
 #include <vector>
 
 namespace ilqgames {
@@ -61,23 +65,135 @@ class LQSolver {
   // Solve underlying LQ game to a Nash equilibrium. This will differ in derived
   // classes depending on the information structure of the game.
   // Optionally return delta xs and costates.
-  virtual std::vector<Strategy> Solve(
+  std::vector<Strategy> Solve(
       const std::vector<LinearDynamicsApproximation>& linearization,
       const std::vector<std::vector<QuadraticCostApproximation>>&
           quadraticization,
       const VectorXf& x0, std::vector<VectorXf>* delta_xs = nullptr,
+      std::vector<std::vector<VectorXf>>* costates = nullptr) {
+    std::vector<Strategy> strategies;
+    for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
+      strategies.emplace_back(num_time_steps_, dynamics_->XDim(),
+                              dynamics_->UDim(ii));
+
+    Solve(linearization, quadraticization, x0, &strategies, delta_xs,
+          costates);
+    return strategies;
+  }
+
+  // Same as above, but overwrite the given (player-indexed) strategies. If
+  // strategies, delta xs, and costates are already the right size then this
+  // does not allocate any memory.
+  virtual void Solve(
+      const std::vector<LinearDynamicsApproximation>& linearization,
+      const std::vector<std::vector<QuadraticCostApproximation>>&
+          quadraticization,
+      const VectorXf& x0, std::vector<Strategy>* strategies,
+      std::vector<VectorXf>* delta_xs = nullptr,
       std::vector<std::vector<VectorXf>>* costates = nullptr) = 0;
 
+  // Optionally run the forward pass (i.e., the rollout of optimal delta xs,
+  // which is an affine recursion, along with the costates) in parallel in
+  // time, splitting the horizon into the given number of chunks (see
+  // `AffineScan`) which are processed on the given thread pool, if it is not
+  // null. The pool must outlive this solver. The backward pass remains
+  // sequential, since the coupled Riccati recursion for a Nash equilibrium
+  // is not associative in general.
+  void SetTimeChunks(size_t num_chunks, ThreadPool* thread_pool = nullptr) {
+    CHECK_GE(num_chunks, 1);
+    thread_pool_ = thread_pool;
+    if (num_chunks == 1) {
+      affine_scan_.reset();
+      return;
+    }
+
+    affine_scan_.reset(new AffineScan(dynamics_->XDim(), num_chunks));
+    forward_Fs_.resize(num_time_steps_ - 1,
+                       MatrixXf(dynamics_->XDim(), dynamics_->XDim()));
+    forward_fs_.resize(num_time_steps_ - 1, VectorXf(dynamics_->XDim()));
+    forward_xs_.resize(num_time_steps_, VectorXf(dynamics_->XDim()));
+  }
+
  protected:
   LQSolver(const std::shared_ptr<const MultiPlayerIntegrableSystem>& dynamics,
            size_t num_time_steps)
-      : dynamics_(dynamics), num_time_steps_(num_time_steps) {
+      : dynamics_(dynamics),
+        num_time_steps_(num_time_steps),
+        thread_pool_(nullptr) {
     CHECK_NOTNULL(dynamics.get());
   }
 
+  // Is the forward pass parallel in time?
+  bool IsParallelInTime() const { return affine_scan_ != nullptr; }
+
+  // Evaluate f(kk) for kk in [0, num_tasks), in parallel if a thread pool is
+  // available.
+  template <typename F>
+  void ParallelFor(size_t num_tasks, const F& f) const {
+    if (thread_pool_) {
+      thread_pool_->ParallelFor(num_tasks, std::cref(f));
+      return;
+    }
+
+    for (size_t kk = 0; kk < num_tasks; kk++) f(kk);
+  }
+
+  // Roll out the forward recursion given by `forward_Fs_` and `forward_fs_`
+  // from x0 into `forward_xs_`, in parallel in time.
+  void RollOutForwardPass(const VectorXf& x0) {
+    CHECK(IsParallelInTime());
+    affine_scan_->Solve(forward_Fs_, forward_fs_, x0, thread_pool_,
+                        &forward_xs_);
+  }
+
+  // Make sure strategies, delta xs, and costates are the right size. Only
+  // allocates if they are not.
+  void ResizeOutputs(std::vector<Strategy>* strategies,
+                     std::vector<VectorXf>* delta_xs,
+                     std::vector<std::vector<VectorXf>>* costates) const {
+    CHECK_NOTNULL(strategies);
+    if (strategies->size() != dynamics_->NumPlayers()) {
+      strategies->clear();
+      for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
+        strategies->emplace_back(num_time_steps_, dynamics_->XDim(),
+                                 dynamics_->UDim(ii));
+    }
+
+    for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
+      auto& strategy = (*strategies)[ii];
+      strategy.Ps.resize(num_time_steps_);
+      strategy.alphas.resize(num_time_steps_);
+      for (size_t kk = 0; kk < num_time_steps_; kk++) {
+        strategy.Ps[kk].resize(dynamics_->UDim(ii), dynamics_->XDim());
+        strategy.alphas[kk].resize(dynamics_->UDim(ii));
+      }
+    }
+
+    if (delta_xs) CHECK_NOTNULL(costates);
+    if (costates) CHECK_NOTNULL(delta_xs);
+    if (delta_xs) {
+      delta_xs->resize(num_time_steps_);
+      costates->resize(num_time_steps_);
+      for (size_t kk = 0; kk < num_time_steps_; kk++) {
+        (*delta_xs)[kk].resize(dynamics_->XDim());
+        (*costates)[kk].resize(dynamics_->NumPlayers());
+        for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
+          (*costates)[kk][ii].resize(dynamics_->XDim());
+      }
+    }
+  }
+
   // Dynamics and number of time steps.
   const std::shared_ptr<const MultiPlayerIntegrableSystem> dynamics_;
   const size_t num_time_steps_;
+
+  // Parallel-in-time forward pass (null unless requested), the maps of each
+  // time step and the resulting states, and an optional thread pool.
+  std::unique_ptr<AffineScan> affine_scan_;
+  std::vector<MatrixXf> forward_Fs_;
+  std::vector<VectorXf> forward_fs_;
+  std::vector<VectorXf> forward_xs_;
+  ThreadPool* thread_pool_;
 };  // class LQSolver
 
 }  // namespace ilqgames
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Multi-start solver. Games often have several local Nash equilibria (e.g.,
+// depending upon who yields first at an intersection), and which one an
+// ILQSolver finds depends upon its initialization. This solver runs one
+// ILQSolver per initialization in parallel, cancels starts which can no longer
+// win, and selects an equilibrium according to a user-specified criterion.
+//
+// Each start has its own problem, which should already be initialized and
+// seeded (e.g., by perturbing the default initialization, initializing along a
+// route via `InitializeAlongRoute`, or via `Problem::OverwriteSolution`).
+// Problems must not share mutable state (e.g., constraint multipliers), since
+// they are solved concurrently.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ILQGAMES_SOLVER_MULTI_START_SOLVER_H
+#define ILQGAMES_SOLVER_MULTI_START_SOLVER_H
+
+#include <ilqgames/solver/game_solver.h>
+#include <ilqgames/solver/ilq_solver.h>
+#include <ilqgames/solver/problem.h>
+#include <ilqgames/solver/solver_params.h>
+#include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/thread_pool.h>
+#include <ilqgames/utils/types.h>
+
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ilqgames {
+
+// Criteria for selecting among equilibria found from different starts:
+// - LOWEST_SCORE: the converged solution with the lowest score (by default,
+//   the first player's total cost). Running starts are cancelled once their
+//   score is worse than that of a converged start by more than a margin.
+// - FASTEST_CONVERGENCE: the first start to converge. All other starts are
+//   cancelled as soon as it does.
+// In either case, if no start converges the lowest-scoring solution is chosen.
+enum MultiStartCriterion { LOWEST_SCORE, FASTEST_CONVERGENCE };
+
+class MultiStartSolver : public GameSolver {
+ public:
+  // Score of a solution, lower being better.
+  typedef std::function<float(const SolverLog&)> Score;
+
+  virtual ~MultiStartSolver() {}
+  MultiStartSolver(
+      const std::vector<std::shared_ptr<Problem>>& problems,
+      const SolverParams& params = SolverParams(),
+      MultiStartCriterion criterion = LOWEST_SCORE,
+      const Score& score = EgoCost,
+      float cancellation_margin = kDefaultCancellationMargin);
+
+  // Solve from every start and return the log of the selected one. Success is
+  // true if the selected solution converged.
+  std::shared_ptr<SolverLog> Solve(
+      bool* success = nullptr,
+      Time max_runtime = std::numeric_limits<Time>::infinity());
+
+  // Perturb the given problem's initialization by adding zero-mean Gaussian
+  // noise with the given standard deviation to its feedforward control terms.
+  static void PerturbInitialization(float stddev, unsigned int seed,
+                                    Problem* problem);
+
+  // Default score, the first player's total cost.
+  static float EgoCost(const SolverLog& log) { return log.TotalCosts()[0]; }
+
+  // Accessors. Logs are only valid after a call to `Solve`.
+  size_t NumStarts() const { return solvers_.size(); }
+  size_t SelectedStart() const { return selected_start_; }
+  Problem& GetProblem(size_t start) { return solvers_[start]->GetProblem(); }
+  const std::vector<std::shared_ptr<SolverLog>>& Logs() const {
+    return logs_;
+  }
+
+ private:
+  // Default cancellation margin, relative to the best converged score.
+  static constexpr float kDefaultCancellationMargin = 0.1;
+
+  // Whether the given start should stop early, given its current log.
+  bool ShouldCancel(const SolverLog& log) const;
+
+  // Record that the given start has finished, with the given log.
+  void Finish(size_t start, const SolverLog& log);
+
+  // Selection criterion, score, and cancellation margin.
+  const MultiStartCriterion criterion_;
+  const Score score_;
+  const float cancellation_margin_;
+
+  // One solver per start, and the logs from the last call to `Solve`.
+  std::vector<std::unique_ptr<ILQSolver>> solvers_;
+  std::vector<std::shared_ptr<SolverLog>> logs_;
+  size_t selected_start_;
+
+  // Thread pool with one thread per start.
+  ThreadPool thread_pool_;
+
+  // Whether all running starts should stop, and the first start to converge
+  // and best score of any converged start so far (guarded by `mutex_`).
+  std::atomic<bool> cancel_all_;
+  size_t first_converged_start_;
+  float best_converged_score_;
+  mutable std::mutex mutex_;
+};  // class MultiStartSolver
+
+}  // namespace ilqgames
+
+#endif
@@ -48,8 +48,10 @@
 #include <ilqgames/dynamics/multi_player_dynamical_system.h>
 #include <ilqgames/dynamics/multi_player_flat_system.h>
 #include <ilqgames/dynamics/multi_player_integrable_system.h>
+#include <ilqgames/utils/constraint_multipliers.h>
 #include <ilqgames/utils/solver_log.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <limits>
@@ -66,12 +68,22 @@ class Problem {
   virtual void Initialize() {
     ConstructDynamics();
     ConstructPlayerCosts();
+    for (auto& pc : player_costs_)
+      pc.SetTimeDiscretization(time_grid_, num_time_steps_);
     ConstructInitialState();
     ConstructInitialOperatingPoint();
     ConstructInitialStrategies();
+    BindConstraintMultipliers();
     initialized_ = true;
   }
 
+  // Store the multipliers of all constraints contiguously. This happens
+  // automatically during initialization, and should be called again if any
+  // constraints are added afterward.
+  void BindConstraintMultipliers() {
+    multipliers_.Bind(player_costs_, num_time_steps_);
+  }
+
   // Reset the initial time and change nothing else.
   void ResetInitialTime(Time t0) {
     CHECK(initialized_);
@@ -88,8 +100,9 @@ class Problem {
   // Since time is continuous and we will want to maintain the same fixed
   // discretization, we will integrate x0 forward from t0 by approximately
   // planner_runtime, then find the nearest state in the existing plan to that
-  // state, and start from there. By default, extends operating points and
-  // strategies as follows:
+  // state, and start from there. If the time grid is non-uniform, the existing
+  // plan is resampled onto the grid starting from that state. By default,
+  // extends operating points and strategies as follows:
   // 1. new controls are zero
   // 2. new states are those that result from zero control
   // 3. new strategies are also zero
@@ -97,19 +110,30 @@ class Problem {
                                         Time planner_runtime = 0.1);
 
   // Overwrite existing solution with the given operating point and strategies.
-  // Truncates to fit in the same memory.
+  // Truncates to fit in the same memory. Optionally, specify the time grid on
+  // which the given solution is discretized (e.g., if it has been spliced
+  // together from several solutions); by default, it is presumed to be this
+  // problem's.
   virtual void OverwriteSolution(const OperatingPoint& operating_point,
                                  const std::vector<Strategy>& strategies);
+  void OverwriteSolution(const OperatingPoint& operating_point,
+                         const std::vector<Strategy>& strategies,
+                         const TimeGrid& solution_grid);
 
   // Accessors.
   bool IsConstrained() const;
   virtual Time InitialTime() const { return operating_point_->t0; }
   const VectorXf& InitialState() const { return x0_; }
-  // size_t NumTimeSteps() const { return num_time_steps_; }
-  // Time TimeStep() const { return time_step_; }
-  // Time TimeHorizon() const { return time_horizon_; }
+  size_t NumTimeSteps() const { return num_time_steps_; }
+  const TimeGrid& Grid() const { return time_grid_; }
+  Time TimeStep() const { return time_step_; }
+  Time TimeStep(size_t kk) const { return time_grid_.TimeStep(kk); }
+  Time RelativeTime(size_t kk) const { return time_grid_.RelativeTime(kk); }
+  Time TimeHorizon() const { return time_horizon_; }
   std::vector<PlayerCost>& PlayerCosts() { return player_costs_; }
   const std::vector<PlayerCost>& PlayerCosts() const { return player_costs_; }
+  ConstraintMultipliers& Multipliers() { return multipliers_; }
+  const ConstraintMultipliers& Multipliers() const { return multipliers_; }
   const std::shared_ptr<const MultiPlayerIntegrableSystem>& Dynamics() const {
     return dynamics_;
   }
@@ -129,7 +153,9 @@ class Problem {
   }
 
  protected:
-  Problem();
+  Problem(Time time_horizon = time::kDefaultTimeHorizon,
+          Time time_step = time::kDefaultTimeStep);
+  Problem(Time time_horizon, const TimeGrid& time_grid);
 
   // Functions for initialization. By default, operating point and strategies
   // are initialized to zero.
@@ -138,12 +164,12 @@ class Problem {
   virtual void ConstructInitialState() = 0;
   virtual void ConstructInitialOperatingPoint() {
     operating_point_.reset(
-        new OperatingPoint(time::kNumTimeSteps, 0.0, dynamics_));
+        new OperatingPoint(num_time_steps_, 0.0, dynamics_));
   }
   virtual void ConstructInitialStrategies() {
     strategies_.reset(new std::vector<Strategy>());
     for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
-      strategies_->emplace_back(time::kNumTimeSteps, dynamics_->XDim(),
+      strategies_->emplace_back(num_time_steps_, dynamics_->XDim(),
                                 dynamics_->UDim(ii));
   }
 
@@ -153,10 +179,22 @@ class Problem {
   size_t SyncToExistingProblem(const VectorXf& x0, Time t0,
                                Time planner_runtime, OperatingPoint& op);
 
-  // // Time horizon (s), time step (s), and number of time steps.
-  // const Time time_horizon_;
-  // const Time time_step_;
-  // const size_t num_time_steps_;
+  // Utility used by SetUpNextRecedingHorizon for non-uniform time grids.
+  // Resample the existing plan, beginning at the given timestep, onto the time
+  // grid and return the number of resampled timesteps.
+  size_t ResampleExistingPlan(size_t first_timestep_in_new_problem);
+
+  // Time horizon (s), time discretization, initial time step (s) (which is the
+  // only time step if the grid is uniform), and number of time steps.
+  const Time time_horizon_;
+  const TimeGrid time_grid_;
+  const Time time_step_;
+  const size_t num_time_steps_;
+
+  // Time discretization of the current solution. This is the same as the time
+  // grid above, unless the solution has been overwritten with one discretized
+  // differently, in which case it is resampled in the next receding horizon.
+  TimeGrid solution_grid_;
 
   // Dynamical system.
   std::shared_ptr<const MultiPlayerIntegrableSystem> dynamics_;
@@ -164,6 +202,9 @@ class Problem {
   // Player costs. These will not change during operation of this solver.
   std::vector<PlayerCost> player_costs_;
 
+  // Multipliers of all constraints in the player costs.
+  ConstraintMultipliers multipliers_;
+
   // Initial condition.
   VectorXf x0_;
 
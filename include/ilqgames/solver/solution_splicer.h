@@ -47,6 +47,7 @@
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/solver_log.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <memory>
@@ -59,24 +60,41 @@ class SolutionSplicer {
   ~SolutionSplicer() {}
   explicit SolutionSplicer(const SolverLog& log);
 
-  // Splice in a new solution stored in a solver log.
+  // Splice in a new solution stored in a solver log. Optionally, keep the part
+  // of the existing solution from the given time onward, e.g., so that the
+  // dynamics can still be integrated from the current time along the spliced
+  // solution.
   void Splice(const SolverLog& log);
+  void Splice(const SolverLog& log, Time current_time);
 
   // Check if a given time is contained within the current operating point.
   bool ContainsTime(Time t) const {
     return (operating_point_.t0 <= t) &&
            (operating_point_.t0 +
-                operating_point_.xs.size() * time::kTimeStep >=
+                time_grid_.RelativeTime(operating_point_.xs.size()) >=
             t);
   }
 
   // Accessors.
+  const TimeGrid& Grid() const { return time_grid_; }
+  Time TimeStep() const { return time_grid_.TimeStep(0); }
   const std::vector<Strategy>& CurrentStrategies() const { return strategies_; }
   const OperatingPoint& CurrentOperatingPoint() const {
     return operating_point_;
   }
 
  private:
+  // Splice in a new solution, which begins at the given timestep of the
+  // current solution, keeping the current solution from the initial timestep.
+  void Splice(const SolverLog& log, size_t initial_timestep,
+              size_t current_timestep);
+
+  // Timestep of the current solution at which a new solution begins.
+  size_t CurrentTimestep(const SolverLog& log) const;
+
+  // Time discretization of the current operating point.
+  TimeGrid time_grid_;
+
   // Converged strategies and operating points for all players.
   std::vector<Strategy> strategies_;
   OperatingPoint operating_point_;
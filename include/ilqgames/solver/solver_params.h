@@ -47,12 +47,43 @@
 
 namespace ilqgames {
 
+// Methods for solving the coupled linear system S X = Y which determines all
+// players' feedback strategies at each time step of the LQ feedback solver.
+// - HOUSEHOLDER_QR: Householder QR of S. Most robust, but slowest.
+// - PARTIAL_PIV_LU: LU decomposition of S with partial pivoting.
+// - BLOCK_SCHUR: block Gaussian elimination, one player at a time, which
+//   inverts only the diagonal (per-player) blocks of S via partial pivot LU.
+//   Each player's own block is invertible whenever the sufficient condition
+//   for a unique Nash equilibrium holds.
+// Both LU backends fall back to HOUSEHOLDER_QR at any time step where a pivot
+// is tiny relative to the entries of S, i.e., where S (or, for BLOCK_SCHUR,
+// some player's block) is numerically singular.
+enum LQSolverBackend { HOUSEHOLDER_QR, PARTIAL_PIV_LU, BLOCK_SCHUR };
+
 struct SolverParams {
   // Consider a solution converged once max elementwise difference is below this
   // tolerance or solver has exceeded a maximum number of iterations.
   float convergence_tolerance = 1e-1;
   size_t max_solver_iters = 1000;
 
+  // Whether the maximum runtime passed to `Solve` is a hard deadline. If so,
+  // rather than only starting iterations which previous ones suggest will
+  // finish in time, the solver predicts the runtime of each phase of an
+  // iteration (linearization, LQ solve, each linesearch step, and logging) as
+  // the given quantile of its recent runtimes, and stops as soon as the next
+  // phase might not finish before the deadline, even mid-iteration. It also
+  // stops (rather than failing) if the linesearch fails. Either way, it returns
+  // the last accepted iterate, which is dynamically feasible and has the lowest
+  // merit function value so far, and records its quality in the log.
+  bool hard_deadline = false;
+  float deadline_runtime_quantile = 0.95;
+
+  // Whether to record each phase of every iterate (linearization,
+  // quadraticization, LQ solve, rollout, and linesearch) as a timed event in
+  // the solver log, for export as a Chrome trace. Per-iterate totals are
+  // always recorded (see `IterateTelemetry`).
+  bool record_trace = false;
+
   // Linesearch parameters. If flag is set 'true', then applied initial alpha
   // scaling to all strategies and backs off geometrically at the given rate for
   // the specified number of steps.
@@ -62,9 +93,54 @@ struct SolverParams {
   size_t max_backtracking_steps = 10;
   float expected_decrease_fraction = 0.1;
 
+  // Number of step sizes to try concurrently in each round of the linesearch.
+  // If greater than 1, candidate steps (i.e., the current step scaled by
+  // successive powers of the geometric alpha scaling) are rolled out and scored
+  // in parallel on the solver's thread pool (see `num_threads`), and the
+  // largest one which satisfies the Armijo condition is accepted. Results are
+  // identical to the default serial linesearch.
+  size_t num_speculative_steps = 1;
+
   // Whether solver should shoot for an open loop or feedback Nash.
   bool open_loop = false;
 
+  // Backend for the linear solve at each time step of the feedback solver.
+  LQSolverBackend lq_solver_backend = HOUSEHOLDER_QR;
+
+  // Number of threads used to linearize dynamics and quadraticize costs across
+  // time steps (and players). The default of 1 runs serially. Results are the
+  // same for any number of threads.
+  size_t num_threads = 1;
+
+  // Number of chunks of time steps into which the forward pass of each LQ
+  // solve is split, so that it runs in parallel in time on the solver's thread
+  // pool (see `LQSolver::SetTimeChunks`). The default of 1 runs sequentially.
+  // Results agree with the sequential forward pass up to roundoff.
+  size_t num_lq_time_chunks = 1;
+
+  // Multiple shooting. If greater than 1, the horizon is split into this many
+  // segments of time steps, which are rolled out concurrently on the solver's
+  // thread pool, each from its own start state. Each LQ step moves segment
+  // start states by its linearized prediction, and the defects between
+  // segments (where the operating point is not dynamically feasible) enter the
+  // next LQ game as drift terms, so they close as the solver converges. The
+  // solver only converges once every defect is below `defect_tolerance` (in
+  // the infinity norm). Otherwise, the final iterate is replaced by a single
+  // shooting rollout which tracks it, so it is always dynamically feasible.
+  // This is incompatible with `hard_deadline`. The default of 1 is single
+  // shooting.
+  size_t num_shooting_segments = 1;
+  float defect_tolerance = 1e-2;
+
+  // Lazy relinearization and requadraticization. If positive, dynamics
+  // linearizations and (time-additive) cost quadraticizations are reused at
+  // each time step whose state and controls are all within this tolerance
+  // (in the infinity norm) of the ones about which they were last computed,
+  // rather than being recomputed. Caches are cleared at the start of each
+  // solve, since initial times and constraint multipliers may change between
+  // solves. Defaults to 0, i.e., exact recomputation at every time step.
+  float relinearization_tolerance = 0.0;
+
   // State and control regularization.
   float state_regularization = 0.0;
   float control_regularization = 0.0;
@@ -77,7 +153,9 @@ struct SolverParams {
   float constraint_error_tolerance = 1e-1;
 
   // Should the solver reset problem/constraint params to their initial values.
-  // NOTE: defaults to true.
+  // NOTE: defaults to true. Multipliers which are not reset are shifted along
+  // with the operating point between receding horizon replans (see
+  // `Problem::SetUpNextRecedingHorizon`), warm starting the dual solution.
   bool reset_problem = true;
   bool reset_lambdas = true;
   bool reset_mu = true;
@@ -44,6 +44,7 @@
 #define ILQGAMES_SOLVER_TOP_DOWN_RENDERABLE_PROBLEM_H
 
 #include <ilqgames/solver/problem.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 namespace ilqgames {
@@ -58,7 +59,11 @@ class TopDownRenderableProblem : public Problem {
   virtual std::vector<float> Thetas(const VectorXf& x) const = 0;
 
  protected:
-  TopDownRenderableProblem() : Problem() {}
+  TopDownRenderableProblem(Time time_horizon = time::kDefaultTimeHorizon,
+                           Time time_step = time::kDefaultTimeStep)
+      : Problem(time_horizon, time_step) {}
+  TopDownRenderableProblem(Time time_horizon, const TimeGrid& time_grid)
+      : Problem(time_horizon, time_grid) {}
 };  // class TopDownRenderableProblem
 
 }  // namespace ilqgames
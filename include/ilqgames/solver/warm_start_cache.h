@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Cache of previously-computed equilibria, keyed by the initial state from
+// which they were computed. New problems may be warm-started from the solution
+// whose initial state is nearest to their own, which typically saves several
+// solver iterations relative to a cold start.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ILQGAMES_SOLVER_WARM_START_CACHE_H
+#define ILQGAMES_SOLVER_WARM_START_CACHE_H
+
+#include <ilqgames/dynamics/multi_player_integrable_system.h>
+#include <ilqgames/solver/problem.h>
+#include <ilqgames/utils/operating_point.h>
+#include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/types.h>
+
+#include <memory>
+#include <vector>
+
+namespace ilqgames {
+
+class WarmStartCache {
+ public:
+  ~WarmStartCache() {}
+
+  // Construct with the dynamics whose `DistanceBetween` metric is used to
+  // compare initial states, and the maximum number of entries to store. Once
+  // full, the oldest entry is evicted first. Optionally, provide per-dimension
+  // (nonnegative) state weights, in which case distance is measured by the
+  // weighted squared 2-norm instead.
+  explicit WarmStartCache(
+      const std::shared_ptr<const MultiPlayerIntegrableSystem>& dynamics,
+      size_t max_entries = 100, const VectorXf& state_weights = VectorXf());
+
+  // A single cached solution.
+  struct Entry {
+    VectorXf x0;
+    OperatingPoint operating_point;
+    std::vector<Strategy> strategies;
+  };
+
+  // Add the final solution in the given log, keyed by its initial state. Only
+  // converged solutions are added, unless `require_converged` is false.
+  // Returns whether the solution was added.
+  bool Add(const SolverLog& log, bool require_converged = true);
+  void Add(const VectorXf& x0, const OperatingPoint& operating_point,
+           const std::vector<Strategy>& strategies);
+
+  // Find the entry whose initial state is nearest to `x0`, or null if the
+  // cache is empty or no entry is within `max_distance`.
+  const Entry* Nearest(const VectorXf& x0,
+                       float max_distance = constants::kInfinity) const;
+
+  // Overwrite the given problem's solution with the nearest entry to its
+  // initial state, shifted to start at its initial time. Cached solutions must
+  // have come from problems with the same time discretization. Returns whether
+  // a suitable entry was found.
+  bool WarmStart(Problem* problem,
+                 float max_distance = constants::kInfinity) const;
+
+  // Distance between two initial states.
+  float Distance(const VectorXf& x0, const VectorXf& x1) const;
+
+  // Accessors.
+  size_t Size() const { return entries_.size(); }
+  size_t MaxEntries() const { return max_entries_; }
+  bool IsEmpty() const { return entries_.empty(); }
+  void Clear() {
+    entries_.clear();
+    next_entry_ = 0;
+  }
+
+ private:
+  // Dynamics, which defines the default distance metric.
+  const std::shared_ptr<const MultiPlayerIntegrableSystem> dynamics_;
+
+  // Optional per-dimension state weights.
+  const VectorXf state_weights_;
+
+  // Entries, stored in a ring buffer of at most `max_entries_` elements.
+  // `next_entry_` is the index of the next entry to be overwritten once full.
+  const size_t max_entries_;
+  std::vector<Entry> entries_;
+  size_t next_entry_;
+};  // class WarmStartCache
+
+}  // namespace ilqgames
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Parallel-in-time rollout of an affine recursion
+//           ``` x_{k+1} = F_k x_k + f_k ```
+// from a given initial state, e.g., the forward pass of an LQ game solver.
+//
+// Affine maps compose associatively, so the horizon is split into contiguous
+// chunks of time steps. First, each chunk's composite map is computed
+// concurrently. Then, the composite maps are applied in sequence to find the
+// state at the start of each chunk. Finally, each chunk is rolled out
+// concurrently from its starting state. With C chunks of a horizon of T steps,
+// the span is O(T / C + C) rather than O(T), at the cost of extra work to
+// compose maps (matrix-matrix rather than matrix-vector products).
+//
+// Results agree with a serial rollout up to floating point roundoff.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ILQGAMES_UTILS_AFFINE_SCAN_H
+#define ILQGAMES_UTILS_AFFINE_SCAN_H
+
+#include <ilqgames/utils/thread_pool.h>
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <functional>
+#include <vector>
+
+namespace ilqgames {
+
+class AffineScan {
+ public:
+  ~AffineScan() {}
+
+  // Construct for states of the given dimension, split into the given number
+  // of chunks. Preallocates all workspaces.
+  AffineScan(Dimension xdim, size_t num_chunks);
+
+  // Roll out the recursion for the given (time-indexed) Fs and fs from x0,
+  // writing states x_0, ..., x_{Fs.size()} to `xs` (which is resized only if
+  // necessary). Chunks are processed on the thread pool if it is not null.
+  void Solve(const std::vector<MatrixXf>& Fs, const std::vector<VectorXf>& fs,
+             const VectorXf& x0, ThreadPool* thread_pool,
+             std::vector<VectorXf>* xs);
+
+  // Accessors.
+  size_t NumChunks() const { return composite_Fs_.size(); }
+
+ private:
+  // First time step of the given chunk, for a horizon of the given number of
+  // time steps. The chunk ends at the first time step of the next chunk.
+  size_t ChunkStart(size_t chunk, size_t num_time_steps) const {
+    return chunk * num_time_steps / NumChunks();
+  }
+
+  // Evaluate f(ii) for ii in [0, num_tasks), in parallel if a thread pool is
+  // available.
+  template <typename F>
+  void ParallelFor(size_t num_tasks, ThreadPool* thread_pool,
+                   const F& f) const {
+    if (thread_pool) {
+      thread_pool->ParallelFor(num_tasks, std::cref(f));
+      return;
+    }
+
+    for (size_t ii = 0; ii < num_tasks; ii++) f(ii);
+  }
+
+  // Composite map of each chunk, and temporaries for each chunk's products.
+  std::vector<MatrixXf> composite_Fs_;
+  std::vector<VectorXf> composite_fs_;
+  std::vector<MatrixXf> temporary_Fs_;
+  std::vector<VectorXf> temporary_fs_;
+};  // class AffineScan
+
+}  // namespace ilqgames
+
+#endif
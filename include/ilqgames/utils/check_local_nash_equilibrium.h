@@ -50,6 +50,7 @@
 #include <ilqgames/solver/problem.h>
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <vector>
@@ -63,7 +64,13 @@ bool NumericalCheckLocalNashEquilibrium(
     const std::vector<Strategy>& strategies,
     const OperatingPoint& operating_point,
     const MultiPlayerIntegrableSystem& dynamics, const VectorXf& x0,
-    float max_perturbation, bool open_loop = false);
+    Time time_step, float max_perturbation, bool open_loop = false);
+bool NumericalCheckLocalNashEquilibrium(
+    const std::vector<PlayerCost>& player_costs,
+    const std::vector<Strategy>& strategies,
+    const OperatingPoint& operating_point,
+    const MultiPlayerIntegrableSystem& dynamics, const VectorXf& x0,
+    const TimeGrid& time_grid, float max_perturbation, bool open_loop = false);
 bool NumericalCheckLocalNashEquilibrium(const Problem& problem,
                                         float max_perturbation,
                                         bool open_loop = false);
@@ -74,7 +81,12 @@ bool NumericalCheckLocalNashEquilibrium(const Problem& problem,
 // coordinates.
 bool CheckSufficientLocalNashEquilibrium(
     const std::vector<PlayerCost>& player_costs,
-    const OperatingPoint& operating_point,
+    const OperatingPoint& operating_point, Time time_step,
+    const std::shared_ptr<const MultiPlayerIntegrableSystem>& dynamics =
+        nullptr);
+bool CheckSufficientLocalNashEquilibrium(
+    const std::vector<PlayerCost>& player_costs,
+    const OperatingPoint& operating_point, const TimeGrid& time_grid,
     const std::shared_ptr<const MultiPlayerIntegrableSystem>& dynamics =
         nullptr);
 bool CheckSufficientLocalNashEquilibrium(const Problem& problem);
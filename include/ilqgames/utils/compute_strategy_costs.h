@@ -51,6 +51,7 @@
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/quadratic_cost_approximation.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
@@ -60,13 +61,23 @@
 
 namespace ilqgames {
 
-// Compute cost of a set of strategies for each player.
+// Compute cost of a set of strategies for each player, given the time step (or
+// grid) at which strategies and operating point are discretized. Optionally
+// integrate with a single Euler step per time step rather than the dynamics'
+// default.
 std::vector<float> ComputeStrategyCosts(
     const std::vector<PlayerCost>& player_costs,
     const std::vector<Strategy>& strategies,
     const OperatingPoint& operating_point,
     const MultiPlayerIntegrableSystem& dynamics, const VectorXf& x0,
-    bool open_loop = false);
+    Time time_step, bool open_loop = false, bool integrate_using_euler = false);
+std::vector<float> ComputeStrategyCosts(
+    const std::vector<PlayerCost>& player_costs,
+    const std::vector<Strategy>& strategies,
+    const OperatingPoint& operating_point,
+    const MultiPlayerIntegrableSystem& dynamics, const VectorXf& x0,
+    const TimeGrid& time_grid, bool open_loop = false,
+    bool integrate_using_euler = false);
 std::vector<float> ComputeStrategyCosts(const Problem& problem,
                                         bool open_loop = false);
 
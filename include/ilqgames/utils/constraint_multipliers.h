@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Contiguous storage for the Lagrange multipliers (and augmented multipliers)
+// of every constraint in a problem, with one row per constraint and one column
+// per time step. Each constraint reads and writes its own row (see
+// `Constraint::BindMultipliers`),
+// so that the augmented Lagrangian dual update, multiplier rescaling, and
+// the maximum constraint violation are each a single pass over one array.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ILQGAMES_UTILS_CONSTRAINT_MULTIPLIERS_H
+#define ILQGAMES_UTILS_CONSTRAINT_MULTIPLIERS_H
+
+#include <ilqgames/constraint/constraint.h>
+#include <ilqgames/cost/player_cost.h>
+#include <ilqgames/utils/operating_point.h>
+#include <ilqgames/utils/time_grid.h>
+#include <ilqgames/utils/types.h>
+#include <ilqgames/utils/uncopyable.h>
+
+#include <memory>
+#include <vector>
+
+namespace ilqgames {
+
+class ConstraintMultipliers : private Uncopyable {
+ public:
+  // Row-major so that each constraint's multipliers are contiguous.
+  typedef Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      RowMatrixXf;
+
+  ~ConstraintMultipliers() {}
+  ConstraintMultipliers() {}
+
+  // Gather every (distinct) state and control constraint in the given player
+  // costs and bind their multipliers to rows of a single matrix, keeping their
+  // current values. Must be called again whenever constraints are added.
+  void Bind(const std::vector<PlayerCost>& player_costs,
+            size_t num_time_steps);
+
+  // Evaluate every constraint at every time step of the given operating point
+  // and return the maximum value (i.e., constraint violation). Values are
+  // stored for the next call to `IncrementLambdas`.
+  float EvaluateViolations(const OperatingPoint& op);
+
+  // Dual update using the last evaluated constraint values:
+  //           lambda <- lambda + mu g(x),
+  // clamped to be nonnegative for inequality constraints.
+  void IncrementLambdas();
+
+  // Shift multipliers forward in time by the given (nonnegative) offset
+  // relative to the current initial time, i.e., so that the multipliers for
+  // a time step of the given grid are those which were stored for that time
+  // step plus the offset. Time steps which were not previously covered
+  // revert to default values. This keeps the dual solution aligned with a
+  // shifted operating point, e.g., in receding horizon replanning.
+  void Shift(Time offset, const TimeGrid& time_grid);
+
+  // Initial time with respect to which multipliers are currently indexed
+  // (that of the first constraint), or zero if there are no constraints.
+  Time InitialTime() const;
+
+  // Scale or reset multipliers of all constraints.
+  void ScaleLambdas(float scale) { lambdas_ *= scale; }
+  void ScaleMu(float scale);
+  void SetMu(float mu);
+
+  // Accessors.
+  size_t NumConstraints() const { return constraints_.size(); }
+  RowMatrixXf& Lambdas() { return lambdas_; }
+  const RowMatrixXf& Lambdas() const { return lambdas_; }
+  RowMatrixXf& Mus() { return mus_; }
+  const RowMatrixXf& Mus() const { return mus_; }
+  const RowMatrixXf& Violations() const { return violations_; }
+
+ private:
+  // A constraint and the input it applies to: either the state (if `player`
+  // is negative) or the given player's control.
+  struct ConstrainedInput {
+    std::shared_ptr<Constraint> constraint;
+    int player;
+  };
+
+  // Constraints, in the order of rows.
+  std::vector<ConstrainedInput> constraints_;
+
+  // Multipliers, augmented multipliers, and last evaluated constraint values.
+  RowMatrixXf lambdas_;
+  RowMatrixXf mus_;
+  RowMatrixXf violations_;
+
+  // Lower bounds on multipliers (zero for inequality constraints, and
+  // negative infinity for equality constraints).
+  VectorXf lower_bounds_;
+};  // class ConstraintMultipliers
+
+}  // namespace ilqgames
+
+#endif
@@ -36,8 +36,8 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-// Set the position dimensions of an operating point to follow a given route
-// polyline.
+// Set the position dimensions of an operating point (or of a problem's current
+// solution) to follow a given route polyline.
 //
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -45,6 +45,7 @@
 #define ILQGAMES_UTILS_INITIALIZE_ALONG_ROUTE_H
 
 #include <ilqgames/geometry/polyline2.h>
+#include <ilqgames/solver/problem.h>
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/types.h>
 
@@ -54,12 +55,22 @@
 namespace ilqgames {
 
 // Set the position dimensions of the given operating point to follow the given
-// route at the given speed, starting at the given route position.
+// route at the given speed, starting at the given route position. Assumes the
+// operating point is discretized at the given time step.
 void InitializeAlongRoute(const Polyline2& route, float initial_route_pos,
-                          float nominal_speed,
+                          float nominal_speed, Time time_step,
                           const std::pair<Dimension, Dimension>& position_dims,
                           OperatingPoint* operating_point);
 
+// Likewise, but seed the given problem's current solution (on its own time
+// grid, which need not be uniform), leaving its strategies unchanged. This is
+// useful to start each of several problems along a different route (e.g., for
+// a MultiStartSolver).
+void InitializeAlongRoute(const Polyline2& route, float initial_route_pos,
+                          float nominal_speed,
+                          const std::pair<Dimension, Dimension>& position_dims,
+                          Problem* problem);
+
 }  // namespace ilqgames
 
 #endif
@@ -37,7 +37,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Container to store a linear approximation of the dynamics at a particular
-// time.
+// time. Optionally records a block structure, as in systems which concatenate
+// independent single-player subsystems, so that LQ solvers can skip products
+// with blocks that are known to be zero. Also optionally records an additive
+// drift term, e.g., the defect between shooting segments of an operating point
+// which is not dynamically feasible.
 //
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -54,6 +58,17 @@ struct LinearDynamicsApproximation {
   MatrixXf A;
   std::vector<MatrixXf> Bs;
 
+  // Optional (player-indexed) block structure. If nonempty, player ii's state
+  // occupies `x_block_dims[ii]` dimensions starting at `x_block_starts[ii]`,
+  // `A` is block diagonal with these blocks, and `Bs[ii]` is zero outside of
+  // player ii's rows.
+  std::vector<Dimension> x_block_starts;
+  std::vector<Dimension> x_block_dims;
+
+  // Optional drift term `c`, i.e., dx_{k+1} = A dx_k + \sum_i Bs[i] du_i + c.
+  // Empty if zero.
+  VectorXf c;
+
   // Default constructor.
   LinearDynamicsApproximation() {}
 
@@ -68,6 +83,12 @@ struct LinearDynamicsApproximation {
       Bs[ii] = MatrixXf::Zero(system.XDim(), system.UDim(ii));
   }
 
+  // Is this linearization block structured?
+  bool HasBlockStructure() const { return !x_block_starts.empty(); }
+
+  // Does this linearization have a drift term?
+  bool HasDrift() const { return c.size() > 0; }
+
   EIGEN_MAKE_ALIGNED_OPERATOR_NEW
 };  // struct LinearDynamicsApproximation
 
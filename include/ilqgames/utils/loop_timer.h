@@ -50,7 +50,7 @@
 
 #include <glog/logging.h>
 #include <chrono>
-#include <list>
+#include <vector>
 
 namespace ilqgames {
 
@@ -58,8 +58,9 @@ class LoopTimer {
  public:
   ~LoopTimer() {}
   LoopTimer(size_t max_samples = 10)
-      : max_samples_(max_samples), total_time_(0.0) {
+      : max_samples_(max_samples), oldest_(0), total_time_(0.0) {
     CHECK_GT(max_samples, 1);
+    loop_times_.reserve(max_samples_);
 
     // For defined behavior, starting with a Tic().
     Tic();
@@ -81,8 +82,11 @@ class LoopTimer {
   // Most recent timer start time.
   std::chrono::time_point<std::chrono::high_resolution_clock> start_;
 
-  // Queue of observed loop times.
-  std::list<Time> loop_times_;
+  // Ring buffer of observed loop times, and the index of the oldest one (which
+  // is overwritten next once the buffer is full). Storage is allocated up
+  // front, so that timing never allocates.
+  std::vector<Time> loop_times_;
+  size_t oldest_;
 
   // Running sum of times in the queue.
   Time total_time_;
@@ -46,6 +46,12 @@
 // -- Rs[ii] is the Hessian with respect to the control input of player ii
 // -- rs[ii] is the gradient with respect to the control input of player ii
 //
+// Rs and rs are stored densely by player index, along with a mask indicating
+// which players' controls this cost actually depends upon. The state Hessian
+// is always stored densely, but may also carry a sparsity pattern. PlayerCost
+// uses it to reset only the pattern between quadraticizations, and
+// LQFeedbackSolver to add only the nonzero entries into its value function.
+//
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef ILQGAMES_UTILS_QUADRATIC_COST_APPROXIMATION_H
@@ -54,7 +60,8 @@
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
-#include <unordered_map>
+#include <algorithm>
+#include <vector>
 
 namespace ilqgames {
 
@@ -62,6 +69,12 @@ struct SingleCostApproximation {
   MatrixXf hess;
   VectorXf grad;
 
+  // Optional sparsity pattern. If `is_hess_sparse` is true, `hess` is a
+  // multiple of the identity (i.e., pure regularization) except in the rows
+  // and columns of `hess_dims`, which are sorted and unique.
+  bool is_hess_sparse = false;
+  std::vector<Dimension> hess_dims;
+
   // Construct from matrix/vector directly.
   SingleCostApproximation(const MatrixXf& hessian, const VectorXf& gradient)
       : hess(hessian), grad(gradient) {
@@ -77,12 +90,71 @@ struct SingleCostApproximation {
 
 struct QuadraticCostApproximation {
   SingleCostApproximation state;
-  PlayerMap<SingleCostApproximation> control;
+
+  // Player-indexed control cost approximations, stored densely. Only entries
+  // for which `has_control` is true are meaningful; the rest are storage kept
+  // around for reuse.
+  std::vector<SingleCostApproximation> control;
+  std::vector<bool> has_control;
 
   // Construct from state dimension.
   explicit QuadraticCostApproximation(Dimension xdim,
                                       float regularization = 0.0)
       : state(xdim, regularization) {}
+
+  // Does this player's cost depend on the given player's control?
+  bool HasControl(PlayerIndex player_idx) const {
+    return player_idx < has_control.size() && has_control[player_idx];
+  }
+
+  // Mark all control entries absent, without releasing their storage.
+  void ClearControls() {
+    std::fill(has_control.begin(), has_control.end(), false);
+  }
+
+  // Reset the given player's control entry to `regularization` times the
+  // identity with zero gradient, and mark it present. Only allocates memory
+  // if this entry has not been used before with the same dimension.
+  SingleCostApproximation& AddControl(PlayerIndex player_idx, Dimension udim,
+                                      float regularization = 0.0) {
+    if (player_idx >= control.size()) {
+      control.resize(player_idx + 1, SingleCostApproximation(0));
+      has_control.resize(player_idx + 1, false);
+    }
+
+    SingleCostApproximation& entry = control[player_idx];
+    entry.hess.setIdentity(udim, udim);
+    entry.hess *= regularization;
+    entry.grad.setZero(udim);
+    has_control[player_idx] = true;
+    return entry;
+  }
+
+  // Set the given player's control entry directly.
+  void SetControl(PlayerIndex player_idx,
+                  const SingleCostApproximation& approximation) {
+    AddControl(player_idx, approximation.grad.size()) = approximation;
+  }
+
+  // Scale all (present) Hessians and gradients by the given factor.
+  void Scale(float scale) {
+    state.hess *= scale;
+    state.grad *= scale;
+    for (PlayerIndex ii = 0; ii < control.size(); ii++) {
+      if (!has_control[ii]) continue;
+      control[ii].hess *= scale;
+      control[ii].grad *= scale;
+    }
+  }
+
+  // Scale only the (present) gradients by the given factor, e.g. when Hessians
+  // have not been computed.
+  void ScaleGradients(float scale) {
+    state.grad *= scale;
+    for (PlayerIndex ii = 0; ii < control.size(); ii++) {
+      if (has_control[ii]) control[ii].grad *= scale;
+    }
+  }
 };  // struct QuadraticCostApproximation
 
 }  // namespace ilqgames
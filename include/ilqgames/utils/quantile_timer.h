@@ -36,36 +36,60 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-// Single player dynamics modeling a car. 5 states and 2 control inputs.
-// State is [x, y, theta, phi, v, a], control is [omega, j], and dynamics are:
-//                     \dot px    = v cos theta
-//                     \dot py    = v sin theta
-//                     \dot theta = (v / L) * tan phi
-//                     \dot phi   = omega
-//                     \dot v     = a
-//                     \dot a     = j
-// Please refer to
-// https://www.sciencedirect.com/science/article/pii/S2405896316301215
-// for further details.
+// Keeps track of the runtime of a repeated task (e.g., one phase of a solver
+// iteration) and predicts the runtime of the next repetition as a quantile of
+// the runtimes observed in a moving window. Unlike the mean-plus-deviation
+// bound used by LoopTimer, quantiles are insensitive to a few very slow
+// samples and do not presume that runtimes are normally distributed.
+//
+// Storage is allocated up front, so timing and prediction never allocate.
 //
 ///////////////////////////////////////////////////////////////////////////////
 
-#include <ilqgames/dynamics/single_player_car_6d.h>
+#ifndef ILQGAMES_UTILS_QUANTILE_TIMER_H
+#define ILQGAMES_UTILS_QUANTILE_TIMER_H
+
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <chrono>
+#include <vector>
 
 namespace ilqgames {
 
-// Constexprs for state indices.
-const Dimension SinglePlayerCar6D::kNumXDims = 6;
-const Dimension SinglePlayerCar6D::kPxIdx = 0;
-const Dimension SinglePlayerCar6D::kPyIdx = 1;
-const Dimension SinglePlayerCar6D::kThetaIdx = 2;
-const Dimension SinglePlayerCar6D::kPhiIdx = 3;
-const Dimension SinglePlayerCar6D::kVIdx = 4;
-const Dimension SinglePlayerCar6D::kAIdx = 5;
+class QuantileTimer {
+ public:
+  ~QuantileTimer() {}
+  explicit QuantileTimer(size_t max_samples = 20);
+
+  // Tic and toc. Start and stop timer.
+  void Tic();
+  Time Toc();
+
+  // Predicted runtime of the next repetition, i.e., the given quantile of
+  // recent runtimes, with initial guess to be returned if no data has been
+  // observed yet.
+  Time RuntimeQuantile(float quantile, Time initial_guess = 0.0) const;
 
-// Constexprs for control indices.
-const Dimension SinglePlayerCar6D::kNumUDims = 2;
-const Dimension SinglePlayerCar6D::kOmegaIdx = 0;
-const Dimension SinglePlayerCar6D::kJerkIdx = 1;
+  // Number of runtimes currently in the window.
+  size_t NumSamples() const { return runtimes_.size(); }
+
+ private:
+  // Maximum number of samples in the window.
+  const size_t max_samples_;
+
+  // Most recent timer start time.
+  std::chrono::time_point<std::chrono::high_resolution_clock> start_;
+
+  // Ring buffer of observed runtimes, and the index of the oldest one (which
+  // is overwritten next once the buffer is full).
+  std::vector<Time> runtimes_;
+  size_t oldest_;
+
+  // Scratch space for computing quantiles.
+  mutable std::vector<Time> sorted_runtimes_;
+};  // class QuantileTimer
 
 }  // namespace ilqgames
+
+#endif
@@ -45,6 +45,7 @@
 #ifndef ILQGAMES_UTILS_RELATIVE_TIME_TRACKER_H
 #define ILQGAMES_UTILS_RELATIVE_TIME_TRACKER_H
 
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
@@ -55,33 +56,42 @@ class RelativeTimeTracker {
  public:
   virtual ~RelativeTimeTracker() {}
 
-  // Access and reset initial time.
-  static void ResetInitialTime(Time t0) { initial_time_ = t0; };
-  static Time InitialTime() { return initial_time_; }
+  // Access and reset initial time of the problem this object belongs to.
+  virtual void ResetInitialTime(Time t0) { initial_time_ = t0; }
+  Time InitialTime() const { return initial_time_; }
 
-  // Convert between time step and initial time.
-  static Time RelativeTime(size_t kk) {
-    return static_cast<Time>(kk) * time::kTimeStep;
+  // Set the time discretization of the problem this object belongs to. The
+  // number of time steps is unused here, but constraints need it to size their
+  // multipliers.
+  virtual void SetTimeDiscretization(const TimeGrid& time_grid,
+                                     size_t /* num_time_steps */) {
+    time_grid_ = time_grid;
   }
-  static Time AbsoluteTime(size_t kk) {
-    return initial_time_ + static_cast<Time>(kk) * time::kTimeStep;
-  }
-  static size_t TimeIndex(Time t) {
+  const TimeGrid& Grid() const { return time_grid_; }
+
+  // Convert from absolute time to time step.
+  size_t TimeIndex(Time t) const {
     CHECK_GE(t, initial_time_);
-    return static_cast<size_t>((t - initial_time_) / time::kTimeStep);
+    return time_grid_.Index(t - initial_time_);
   }
 
   // Access the name of this object.
   const std::string& Name() const { return name_; }
 
  protected:
-  RelativeTimeTracker(const std::string& name) : name_(name) {}
+  RelativeTimeTracker(const std::string& name)
+      : name_(name),
+        time_grid_(time::kDefaultTimeStep),
+        initial_time_(0.0) {}
 
   // Name associated to every cost.
   const std::string name_;
 
-  // Initial time.
-  static Time initial_time_;
+  // Time discretization.
+  TimeGrid time_grid_;
+
+  // Initial time (s).
+  Time initial_time_;
 };  //\class Cost
 
 }  // namespace ilqgames
@@ -44,7 +44,9 @@
 #define ILQGAMES_UTILS_LOG_H
 
 #include <ilqgames/utils/operating_point.h>
+#include <ilqgames/utils/solver_telemetry.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 #include <ilqgames/utils/uncopyable.h>
 
@@ -56,30 +58,76 @@ namespace ilqgames {
 // Default experiment name to use.
 std::string DefaultExperimentName();
 
+// Quality of the final iterate in a solver log, from best to worst.
+// - CONVERGED: the solver converged.
+// - IMPROVED: the solver accepted at least one step, but stopped before it
+//   converged (e.g., at a deadline or after a linesearch failure).
+// - NOT_IMPROVED: the solver stopped before accepting any step, so the final
+//   iterate is the initial one.
+enum SolutionQuality { CONVERGED, IMPROVED, NOT_IMPROVED };
+
 class SolverLog : private Uncopyable {
  public:
   ~SolverLog() {}
-  SolverLog() {}
+  explicit SolverLog(Time time_step)
+      : time_grid_(time_step),
+        quality_(NOT_IMPROVED),
+        reached_deadline_(false) {}
+  explicit SolverLog(const TimeGrid& time_grid)
+      : time_grid_(time_grid),
+        quality_(NOT_IMPROVED),
+        reached_deadline_(false) {}
 
   // Add a new solver iterate.
-  void AddSolverIterate(const OperatingPoint& operating_point,
-                        const std::vector<Strategy>& strategies,
-                        const std::vector<float>& total_costs,
-                        Time cumulative_runtime, bool was_converged) {
+  void AddSolverIterate(
+      const OperatingPoint& operating_point,
+      const std::vector<Strategy>& strategies,
+      const std::vector<float>& total_costs, Time cumulative_runtime,
+      bool was_converged,
+      const IterateTelemetry& telemetry = IterateTelemetry()) {
     operating_points_.push_back(operating_point);
     strategies_.push_back(strategies);
     total_player_costs_.push_back(total_costs);
     cumulative_runtimes_.push_back(cumulative_runtime);
     was_converged_.push_back(was_converged);
+    telemetry_.push_back(telemetry);
+  }
+
+  // Make room for the given number of iterates, so that adding them only
+  // allocates copies of each iterate and never reallocates the log's storage.
+  void Reserve(size_t num_iterates) {
+    operating_points_.reserve(num_iterates);
+    strategies_.reserve(num_iterates);
+    total_player_costs_.reserve(num_iterates);
+    cumulative_runtimes_.reserve(num_iterates);
+    was_converged_.reserve(num_iterates);
+    telemetry_.reserve(num_iterates);
   }
 
-  // Add a whole other log.
+  // Trace events recorded by the solver (if it was asked to record them).
+  std::vector<TraceEvent>* MutableTraceEvents() { return &trace_events_; }
+  const std::vector<TraceEvent>& TraceEvents() const { return trace_events_; }
+
+  // Record how the solver terminated.
+  void SetQuality(SolutionQuality quality) { quality_ = quality; }
+  void SetReachedDeadline(bool reached_deadline) {
+    reached_deadline_ = reached_deadline;
+  }
+
+  // Add a whole other log. Its final iterate becomes this log's final iterate,
+  // so its quality carries over as well.
   void AddLog(const SolverLog& log) {
     for (size_t ii = 0; ii < log.NumIterates(); ii++) {
       AddSolverIterate(log.operating_points_[ii], log.strategies_[ii],
                        log.total_player_costs_[ii],
-                       log.cumulative_runtimes_[ii], log.was_converged_[ii]);
+                       log.cumulative_runtimes_[ii], log.was_converged_[ii],
+                       log.telemetry_[ii]);
     }
+    trace_events_.insert(trace_events_.end(), log.trace_events_.begin(),
+                         log.trace_events_.end());
+
+    quality_ = log.quality_;
+    reached_deadline_ |= log.reached_deadline_;
   }
 
   // Clear all but first entry. Used by the solver to return initial conditions
@@ -93,11 +141,19 @@ class SolverLog : private Uncopyable {
     total_player_costs_.resize(kOneIterate);
     cumulative_runtimes_.resize(kOneIterate);
     was_converged_.resize(kOneIterate);
+    telemetry_.resize(kOneIterate);
+    quality_ = NOT_IMPROVED;
   }
 
   // Accessors.
   bool WasConverged() const { return was_converged_.back(); }
   bool WasConverged(size_t idx) const { return was_converged_[idx]; }
+  const IterateTelemetry& Telemetry() const { return telemetry_.back(); }
+  const IterateTelemetry& Telemetry(size_t idx) const {
+    return telemetry_[idx];
+  }
+  SolutionQuality Quality() const { return quality_; }
+  bool ReachedDeadline() const { return reached_deadline_; }
   Time InitialTime() const {
     return (NumIterates() > 0) ? operating_points_[0].t0 : 0.0;
   }
@@ -105,6 +161,12 @@ class SolverLog : private Uncopyable {
     return (NumIterates() > 0) ? IndexToTime(operating_points_[0].xs.size() - 1)
                                : 0.0;
   }
+  const TimeGrid& Grid() const { return time_grid_; }
+  Time TimeStep() const { return time_grid_.TimeStep(0); }
+  Time TimeStep(size_t idx) const { return time_grid_.TimeStep(idx); }
+  size_t NumTimeSteps() const {
+    return (NumIterates() > 0) ? operating_points_[0].xs.size() : 0;
+  }
   PlayerIndex NumPlayers() const { return strategies_[0].size(); }
   size_t NumIterates() const { return operating_points_.size(); }
   std::vector<float> TotalCosts() const { return total_player_costs_.back(); }
@@ -163,21 +225,29 @@ class SolverLog : private Uncopyable {
 
   // Get index corresponding to the time step immediately before the given time.
   size_t TimeToIndex(Time t) const {
-    return static_cast<size_t>(
-        std::max<Time>(constants::kSmallNumber, t - InitialTime()) /
-        time::kTimeStep);
+    return time_grid_.Index(
+        std::max<Time>(constants::kSmallNumber, t - InitialTime()));
   }
 
   // Get time stamp corresponding to a particular index.
   Time IndexToTime(size_t idx) const {
-    return InitialTime() + time::kTimeStep * static_cast<Time>(idx);
+    return InitialTime() + time_grid_.RelativeTime(idx);
   }
 
-  // Save to disk.
+  // Save to disk. If any trace events were recorded, they are saved as a
+  // Chrome trace as well.
   bool Save(bool only_last_trajectory = false,
             const std::string& experiment_name = DefaultExperimentName()) const;
 
+  // Save trace events to the given file in the Chrome trace event format,
+  // which may be viewed in chrome://tracing or Perfetto. Times are relative to
+  // the first event.
+  bool SaveChromeTrace(const std::string& filename) const;
+
  private:
+  // Time discretization of all operating points and strategies.
+  const TimeGrid time_grid_;
+
   // Operating points, strategies, total costs, and cumulative runtime indexed
   // by solver iterate.
   std::vector<OperatingPoint> operating_points_;
@@ -185,6 +255,14 @@ class SolverLog : private Uncopyable {
   std::vector<std::vector<float>> total_player_costs_;
   std::vector<Time> cumulative_runtimes_;
   std::vector<bool> was_converged_;
+  std::vector<IterateTelemetry> telemetry_;
+
+  // Timed phases of all iterates, in the order in which they finished.
+  std::vector<TraceEvent> trace_events_;
+
+  // Quality of the final iterate, and whether the solver stopped at a deadline.
+  SolutionQuality quality_;
+  bool reached_deadline_;
 };  // class SolverLog
 
 // Utility to save a list of logs.
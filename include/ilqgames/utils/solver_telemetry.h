@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+///////////////////////////////////////////////////////////////////////////////
+//
+// Per-iterate solver telemetry: how long each phase of an iterate took, and
+// how the linesearch went. Phases may also be recorded as timed events, for
+// export as a Chrome trace (see `SolverLog::SaveChromeTrace`).
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ILQGAMES_UTILS_SOLVER_TELEMETRY_H
+#define ILQGAMES_UTILS_SOLVER_TELEMETRY_H
+
+#include <ilqgames/utils/types.h>
+#include <ilqgames/utils/uncopyable.h>
+
+#include <chrono>
+#include <vector>
+
+namespace ilqgames {
+
+struct IterateTelemetry {
+  // Wall time (s) spent in each phase of the iterate. Linesearch time includes
+  // the rollouts and quadraticizations which happen inside the linesearch,
+  // except that a speculative linesearch rolls out and scores its candidates
+  // concurrently, which only counts towards the linesearch.
+  Time linearization_time = 0.0;
+  Time quadraticization_time = 0.0;
+  Time lq_solve_time = 0.0;
+  Time rollout_time = 0.0;
+  Time linesearch_time = 0.0;
+
+  // Number of trial steps rejected by the linesearch before it accepted one.
+  size_t num_backtracking_steps = 0;
+
+  // Merit function value at the iterate, expected decrease (per unit step
+  // size) of the LQ step which led to it, and the step size which was
+  // accepted. The merit function value is infinite if it was not evaluated
+  // (e.g., at the initial iterate, or without a linesearch).
+  float merit_function_value = constants::kInfinity;
+  float expected_decrease = 0.0;
+  float step_size = 0.0;
+};  // struct IterateTelemetry
+
+// A named phase which started at the given time and took the given duration
+// (s). Names must be string literals (or otherwise outlive the event).
+struct TraceEvent {
+  const char* name;
+  std::chrono::time_point<Clock> start;
+  Time duration;
+};  // struct TraceEvent
+
+// Times a phase for as long as it is in scope. On destruction, adds the
+// elapsed time to the given total (if any) and records a trace event in the
+// given list (if any).
+class ScopedPhaseTimer : private Uncopyable {
+ public:
+  ~ScopedPhaseTimer() {
+    const auto stop = Clock::now();
+    const Time duration = std::chrono::duration<Time>(stop - start_).count();
+    if (total_) *total_ += duration;
+    if (events_) events_->push_back({name_, start_, duration});
+  }
+  ScopedPhaseTimer(const char* name, Time* total,
+                   std::vector<TraceEvent>* events = nullptr)
+      : name_(name), total_(total), events_(events), start_(Clock::now()) {}
+
+ private:
+  const char* const name_;
+  Time* const total_;
+  std::vector<TraceEvent>* const events_;
+  const std::chrono::time_point<Clock> start_;
+};  // class ScopedPhaseTimer
+
+}  // namespace ilqgames
+
+#endif
@@ -75,6 +75,15 @@ struct Strategy {
     return u_ref - Ps[time_index] * delta_x - alphas[time_index];
   }
 
+  // Same as above, but write the control into `u`. Does not allocate memory if
+  // `u` is already the right size.
+  void operator()(size_t time_index, const VectorXf& delta_x,
+                  const VectorXf& u_ref, VectorXf* u) const {
+    CHECK_NOTNULL(u);
+    *u = u_ref - alphas[time_index];
+    u->noalias() -= Ps[time_index] * delta_x;
+  }
+
   // Number of variables.
   size_t NumVariables() const {
     const size_t horizon = Ps.size();
@@ -36,29 +36,66 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-// Single player dynamics modeling a unicycle. 4 states and 2 control inputs.
-// State is [x, y, theta, v], control is [omega, a], and dynamics are:
-//                     \dot px    = v cos theta
-//                     \dot py    = v sin theta
-//                     \dot theta = omega
-//                     \dot v     = a
+// Fixed-size pool of worker threads for data-parallel loops. Work is split into
+// contiguous blocks of indices, one per thread, so that every index is always
+// handled exactly once. Provided the loop body writes only to storage
+// associated with its own index, results are identical to a serial loop.
 //
 ///////////////////////////////////////////////////////////////////////////////
 
-#include <ilqgames/dynamics/single_player_unicycle_4d.h>
+#ifndef ILQGAMES_UTILS_THREAD_POOL_H
+#define ILQGAMES_UTILS_THREAD_POOL_H
+
+#include <ilqgames/utils/types.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 namespace ilqgames {
 
-// Constexprs for state indices.
-const Dimension SinglePlayerUnicycle4D::kNumXDims = 4;
-const Dimension SinglePlayerUnicycle4D::kPxIdx = 0;
-const Dimension SinglePlayerUnicycle4D::kPyIdx = 1;
-const Dimension SinglePlayerUnicycle4D::kThetaIdx = 2;
-const Dimension SinglePlayerUnicycle4D::kVIdx = 3;
+class ThreadPool {
+ public:
+  ~ThreadPool();
+
+  // Construct with the given total number of threads, including the calling
+  // thread (which also does work during each call to ParallelFor).
+  explicit ThreadPool(size_t num_threads);
+
+  // Evaluate f(ii) for ii in [0, num_tasks). Blocks until all calls complete.
+  void ParallelFor(size_t num_tasks, const std::function<void(size_t)>& f);
+
+  // Total number of threads, including the calling thread.
+  size_t NumThreads() const { return workers_.size() + 1; }
+
+ private:
+  // Run the given block of the current task.
+  void RunBlock(size_t block_idx) const;
+
+  // Main loop for each worker thread.
+  void WorkerLoop(size_t block_idx);
+
+  // Worker threads. These handle blocks 1, ..., NumThreads() - 1.
+  std::vector<std::thread> workers_;
+
+  // Current task, number of indices, and a counter of how many tasks have been
+  // issued so that workers can tell when new work arrives.
+  const std::function<void(size_t)>* task_;
+  size_t num_tasks_;
+  size_t generation_;
+
+  // Number of workers yet to finish the current task, and whether to shut down.
+  size_t num_pending_;
+  bool shutdown_;
+
+  // Synchronization.
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable work_done_;
+};  // class ThreadPool
 
-// Constexprs for control indices.
-const Dimension SinglePlayerUnicycle4D::kNumUDims = 2;
-const Dimension SinglePlayerUnicycle4D::kOmegaIdx = 0;
-const Dimension SinglePlayerUnicycle4D::kAIdx = 1;
+}  // namespace ilqgames
 
-}
+#endif
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+///////////////////////////////////////////////////////////////////////////////
+//
+// Time discretization of a problem's horizon. A grid may either be uniform,
+// with a single time step, or non-uniform, with an arbitrary sequence of time
+// steps (e.g., fine near the initial time and coarse toward the end of the
+// horizon). Beyond the end of its explicit time steps, a non-uniform grid
+// continues uniformly with the last time step.
+//
+// All times are relative to the start of the grid, and the kk-th time step
+// spans [RelativeTime(kk), RelativeTime(kk + 1)).
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ILQGAMES_UTILS_TIME_GRID_H
+#define ILQGAMES_UTILS_TIME_GRID_H
+
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <vector>
+
+namespace ilqgames {
+
+class TimeGrid {
+ public:
+  ~TimeGrid() {}
+
+  // Uniform grid with the given time step.
+  explicit TimeGrid(Time time_step);
+
+  // Non-uniform grid with the given sequence of time steps.
+  explicit TimeGrid(const std::vector<Time>& time_steps);
+
+  // Non-uniform grid whose time steps grow linearly from the initial to the
+  // final time step over the given horizon. Time steps are rescaled slightly
+  // so that they exactly span the horizon.
+  static TimeGrid Graded(Time initial_time_step, Time final_time_step,
+                         Time time_horizon);
+
+  // Grid consisting of time steps [first, last) of this grid followed by all
+  // time steps of the next grid. This is uniform if both grids are uniform
+  // with the same time step.
+  TimeGrid Splice(size_t first, size_t last, const TimeGrid& next) const;
+
+  // Is this grid uniform?
+  bool IsUniform() const { return time_steps_.empty(); }
+
+  // Length of the kk-th time step.
+  Time TimeStep(size_t kk) const {
+    if (IsUniform()) return time_step_;
+    return (kk < time_steps_.size()) ? time_steps_[kk] : time_steps_.back();
+  }
+
+  // Start of the kk-th time step.
+  Time RelativeTime(size_t kk) const {
+    if (IsUniform()) return time_step_ * static_cast<Time>(kk);
+    if (kk < times_.size()) return times_[kk];
+    return times_.back() +
+           time_steps_.back() * static_cast<Time>(kk + 1 - times_.size());
+  }
+
+  // Index of the time step containing the given relative time.
+  size_t Index(Time relative_t) const;
+
+  // Number of whole time steps in the given horizon. For uniform grids this
+  // matches `time::NumTimeSteps`.
+  size_t NumTimeSteps(Time time_horizon) const {
+    return Index(time_horizon + constants::kSmallNumber);
+  }
+
+  // Number of whole time steps, starting with the kk-th, which fit in the
+  // given duration (up to a small tolerance).
+  size_t NumTimeStepsWithin(size_t kk, Time duration) const;
+
+  // Total length of the given number of time steps, starting with the kk-th.
+  Time Duration(size_t kk, size_t num_time_steps) const {
+    if (IsUniform()) return time_step_ * static_cast<Time>(num_time_steps);
+    return RelativeTime(kk + num_time_steps) - RelativeTime(kk);
+  }
+
+  // Weight of the kk-th time step in a time-additive cost, i.e. its length
+  // relative to the initial time step. This is always 1 for uniform grids.
+  float CostWeight(size_t kk) const {
+    return (IsUniform()) ? 1.0 : TimeStep(kk) / TimeStep(0);
+  }
+
+ private:
+  // Time step, if uniform.
+  Time time_step_;
+
+  // Time steps and their start times (with the end of the last one appended),
+  // if non-uniform. Both are empty if the grid is uniform.
+  std::vector<Time> time_steps_;
+  std::vector<Time> times_;
+};  // class TimeGrid
+
+}  // namespace ilqgames
+
+#endif
@@ -131,15 +131,21 @@ static constexpr float kDefaultMu = 10.0;
 }  // namespace constants
 
 namespace time {
-// Time discretization (s).
-static constexpr Time kTimeStep = 0.1;
+// Default time discretization (s). Each Problem may choose its own.
+static constexpr Time kDefaultTimeStep = 0.1;
 
-// Time horizon (s).
-static constexpr Time kTimeHorizon = 10.0;
+// Default time horizon (s). Each Problem may choose its own.
+static constexpr Time kDefaultTimeHorizon = 10.0;
 
-// Number of time steps.
-static constexpr size_t kNumTimeSteps =
-    static_cast<size_t>((kTimeHorizon + constants::kSmallNumber) / kTimeStep);
+// Number of time steps for a given horizon and discretization.
+inline constexpr size_t NumTimeSteps(Time time_horizon, Time time_step) {
+  return static_cast<size_t>((time_horizon + constants::kSmallNumber) /
+                             time_step);
+}
+
+// Number of time steps in the default discretization.
+static constexpr size_t kDefaultNumTimeSteps =
+    NumTimeSteps(kDefaultTimeHorizon, kDefaultTimeStep);
 }  // namespace time
 
 // ---------------------------- SIMPLE FUNCTIONS ---------------------------- //
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Parallel-in-time rollout of an affine recursion.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/utils/affine_scan.h>
+#include <ilqgames/utils/thread_pool.h>
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <vector>
+
+namespace ilqgames {
+
+AffineScan::AffineScan(Dimension xdim, size_t num_chunks)
+    : composite_Fs_(num_chunks, MatrixXf(xdim, xdim)),
+      composite_fs_(num_chunks, VectorXf(xdim)),
+      temporary_Fs_(num_chunks, MatrixXf(xdim, xdim)),
+      temporary_fs_(num_chunks, VectorXf(xdim)) {
+  CHECK_GE(num_chunks, 1);
+}
+
+void AffineScan::Solve(const std::vector<MatrixXf>& Fs,
+                       const std::vector<VectorXf>& fs, const VectorXf& x0,
+                       ThreadPool* thread_pool, std::vector<VectorXf>* xs) {
+  CHECK_NOTNULL(xs);
+  CHECK_EQ(Fs.size(), fs.size());
+  const size_t num_time_steps = Fs.size();
+  if (xs->size() != num_time_steps + 1) xs->resize(num_time_steps + 1);
+
+  // (1) Compose the maps in each chunk, other than the last (whose composite
+  // map is never needed).
+  const size_t num_chunks = NumChunks();
+  ParallelFor(num_chunks - 1, thread_pool, [&](size_t chunk) {
+    MatrixXf& composite_F = composite_Fs_[chunk];
+    VectorXf& composite_f = composite_fs_[chunk];
+    MatrixXf& temporary_F = temporary_Fs_[chunk];
+    VectorXf& temporary_f = temporary_fs_[chunk];
+    composite_F.setIdentity();
+    composite_f.setZero();
+    for (size_t kk = ChunkStart(chunk, num_time_steps);
+         kk < ChunkStart(chunk + 1, num_time_steps); kk++) {
+      temporary_F.noalias() = Fs[kk] * composite_F;
+      composite_F.swap(temporary_F);
+      temporary_f = fs[kk];
+      temporary_f.noalias() += Fs[kk] * composite_f;
+      composite_f.swap(temporary_f);
+    }
+  });
+
+  // (2) Find the state at the start of each chunk.
+  (*xs)[0] = x0;
+  for (size_t chunk = 0; chunk < num_chunks - 1; chunk++) {
+    const size_t start = ChunkStart(chunk, num_time_steps);
+    const size_t next_start = ChunkStart(chunk + 1, num_time_steps);
+    if (start == next_start) continue;
+
+    const VectorXf& x = (*xs)[start];
+    VectorXf& next_x = (*xs)[next_start];
+    next_x = composite_fs_[chunk];
+    next_x.noalias() += composite_Fs_[chunk] * x;
+  }
+
+  // (3) Roll out each chunk from its start. Each chunk writes all states up to
+  // (but not including) the start of the next one, except the last chunk,
+  // which also writes the final state.
+  ParallelFor(num_chunks, thread_pool, [&](size_t chunk) {
+    const size_t stop = (chunk + 1 < num_chunks)
+                            ? ChunkStart(chunk + 1, num_time_steps)
+                            : num_time_steps + 1;
+    for (size_t kk = ChunkStart(chunk, num_time_steps); kk + 1 < stop; kk++) {
+      VectorXf& next_x = (*xs)[kk + 1];
+      next_x = fs[kk];
+      next_x.noalias() += Fs[kk] * (*xs)[kk];
+    }
+  });
+}
+
+}  // namespace ilqgames
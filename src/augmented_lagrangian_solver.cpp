@@ -52,6 +52,7 @@
 #include <ilqgames/solver/lq_solver.h>
 #include <ilqgames/solver/problem.h>
 #include <ilqgames/solver/solver_params.h>
+#include <ilqgames/utils/constraint_multipliers.h>
 #include <ilqgames/utils/linear_dynamics_approximation.h>
 #include <ilqgames/utils/loop_timer.h>
 #include <ilqgames/utils/operating_point.h>
@@ -111,36 +112,14 @@ std::shared_ptr<SolverLog> AugmentedLagrangianSolver::Solve(bool* success,
     // Start loop timer.
     timer_.Tic();
 
-    // Increment multiplers in player costs, and in parallel compute the total
-    // squared constraint error.
-    max_constraint_error = -constants::kInfinity;
-    const OperatingPoint& op = log->FinalOperatingPoint();
-    for (auto& pc : problem_->PlayerCosts()) {
-      for (size_t kk = 0; kk < op.xs.size(); kk++) {
-        const Time t = op.t0 + time::kTimeStep * static_cast<float>(kk);
-        const auto& x = op.xs[kk];
-        const auto& us = op.us[kk];
-
-        // Scale each lambda.
-        for (const auto& constraint : pc.StateConstraints()) {
-          const float constraint_error = constraint->Evaluate(t, x);
-          max_constraint_error =
-              std::max(max_constraint_error, constraint_error);
-          constraint->IncrementLambda(t, constraint_error);
-        }
-
-        for (const auto& pair : pc.ControlConstraints()) {
-          const float constraint_error =
-              pair.second->Evaluate(t, us[pair.first]);
-          max_constraint_error =
-              std::max(max_constraint_error, constraint_error);
-          pair.second->IncrementLambda(t, constraint_error);
-        }
-      }
-    }
+    // Evaluate all constraints at once, then increment all multipliers.
+    ConstraintMultipliers& multipliers = problem_->Multipliers();
+    max_constraint_error =
+        multipliers.EvaluateViolations(log->FinalOperatingPoint());
+    multipliers.IncrementLambdas();
 
     // Scale mu.
-    Constraint::ScaleMu(params_.geometric_mu_scaling);
+    ScaleMu(params_.geometric_mu_scaling);
 
     // Log squared constraint violation.
     VLOG(2) << "Max constraint violation at iteration " << log->NumIterates()
@@ -167,14 +146,10 @@ std::shared_ptr<SolverLog> AugmentedLagrangianSolver::Solve(bool* success,
       VLOG(2) << "Unconstrained solver failed at iteration "
               << log->NumIterates();
       VLOG(2) << "Downscaling all multipliers.";
-      for (auto& pc : problem_->PlayerCosts()) {
-        for (const auto& constraint : pc.StateConstraints())
-          constraint->ScaleLambdas(params_.geometric_lambda_downscaling);
-        for (const auto& pair : pc.ControlConstraints())
-          pair.second->ScaleLambdas(params_.geometric_lambda_downscaling);
-      }
-
-      Constraint::ScaleMu(params_.geometric_mu_downscaling);
+      problem_->Multipliers().ScaleLambdas(
+          params_.geometric_lambda_downscaling);
+
+      ScaleMu(params_.geometric_mu_downscaling);
     }
 
     if (success) *success &= unconstrained_success;
@@ -195,18 +170,17 @@ std::shared_ptr<SolverLog> AugmentedLagrangianSolver::Solve(bool* success,
     problem_->OverwriteSolution(initial_op, initial_strategies);
 
   // Reset all multipliers.
-  if (params_.reset_lambdas) {
-    for (auto& pc : problem_->PlayerCosts()) {
-      for (const auto& constraint : pc.StateConstraints())
-        constraint->ScaleLambdas(constants::kDefaultLambda);
-      for (const auto& pair : pc.ControlConstraints())
-        pair.second->ScaleLambdas(constants::kDefaultLambda);
-    }
-  }
+  if (params_.reset_lambdas)
+    problem_->Multipliers().ScaleLambdas(constants::kDefaultLambda);
 
-  if (params_.reset_mu) Constraint::GlobalMu() = constants::kDefaultMu;
+  // Reset all augmented multipliers.
+  if (params_.reset_mu) problem_->Multipliers().SetMu(constants::kDefaultMu);
 
   return log;
 }
 
+void AugmentedLagrangianSolver::ScaleMu(float scale) {
+  problem_->Multipliers().ScaleMu(scale);
+}
+
 }  // namespace ilqgames
@@ -44,10 +44,12 @@
 #include <ilqgames/cost/player_cost.h>
 #include <ilqgames/dynamics/multi_player_flat_system.h>
 #include <ilqgames/dynamics/multi_player_integrable_system.h>
+#include <ilqgames/utils/check_local_nash_equilibrium.h>
 #include <ilqgames/utils/compute_strategy_costs.h>
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/quadratic_cost_approximation.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
@@ -62,7 +64,18 @@ bool NumericalCheckLocalNashEquilibrium(
     const std::vector<Strategy>& strategies,
     const OperatingPoint& operating_point,
     const MultiPlayerIntegrableSystem& dynamics, const VectorXf& x0,
-    float max_perturbation, bool open_loop) {
+    Time time_step, float max_perturbation, bool open_loop) {
+  return NumericalCheckLocalNashEquilibrium(
+      player_costs, strategies, operating_point, dynamics, x0,
+      TimeGrid(time_step), max_perturbation, open_loop);
+}
+
+bool NumericalCheckLocalNashEquilibrium(
+    const std::vector<PlayerCost>& player_costs,
+    const std::vector<Strategy>& strategies,
+    const OperatingPoint& operating_point,
+    const MultiPlayerIntegrableSystem& dynamics, const VectorXf& x0,
+    const TimeGrid& time_grid, float max_perturbation, bool open_loop) {
   CHECK_EQ(strategies.size(), player_costs.size());
   CHECK_EQ(strategies.size(), dynamics.NumPlayers());
   CHECK_EQ(x0.size(), dynamics.XDim());
@@ -72,12 +85,10 @@ bool NumericalCheckLocalNashEquilibrium(
 
   // Compute nominal equilibrium cost and be sure to use only 1-step Euler
   // integration.
-  const bool was_integrating_using_euler =
-      MultiPlayerIntegrableSystem::IntegrationUsesEuler();
-  if (!was_integrating_using_euler)
-    MultiPlayerIntegrableSystem::IntegrateUsingEuler();
+  constexpr bool kIntegrateUsingEuler = true;
   const std::vector<float> nominal_costs = ComputeStrategyCosts(
-      player_costs, strategies, operating_point, dynamics, x0, open_loop);
+      player_costs, strategies, operating_point, dynamics, x0, time_grid,
+      open_loop, kIntegrateUsingEuler);
 
   // For each player, perturb strategies with Gaussian noise a bunch of times
   // and if cost decreases then return false.
@@ -95,10 +106,12 @@ bool NumericalCheckLocalNashEquilibrium(
         // Compute new costs.
         const std::vector<float> perturbed_costs_lower =
             ComputeStrategyCosts(player_costs, perturbed_strategies_lower,
-                                 operating_point, dynamics, x0, open_loop);
+                                 operating_point, dynamics, x0, time_grid,
+                                 open_loop, kIntegrateUsingEuler);
         const std::vector<float> perturbed_costs_upper =
             ComputeStrategyCosts(player_costs, perturbed_strategies_upper,
-                                 operating_point, dynamics, x0, open_loop);
+                                 operating_point, dynamics, x0, time_grid,
+                                 open_loop, kIntegrateUsingEuler);
 
         // Check Nash condition.
         if (std::min(perturbed_costs_lower[ii], perturbed_costs_upper[ii]) <
@@ -113,10 +126,6 @@ bool NumericalCheckLocalNashEquilibrium(
           //           << strategies[ii].alphas[kk].transpose()
           //           << ", vs. perturbed " << alphak_lower.transpose()
           //           << std::endl;
-
-          // Other users will likely want RK4 integration.
-          if (!was_integrating_using_euler)
-            MultiPlayerIntegrableSystem::IntegrateUsingRK4();
           return false;
         }
 
@@ -127,8 +136,6 @@ bool NumericalCheckLocalNashEquilibrium(
     }
   }
 
-  // Other users will likely want RK4 integration.
-  MultiPlayerIntegrableSystem::IntegrateUsingRK4();
   return true;
 }
 
@@ -138,13 +145,21 @@ bool NumericalCheckLocalNashEquilibrium(const Problem& problem,
   return NumericalCheckLocalNashEquilibrium(
       problem.PlayerCosts(), problem.CurrentStrategies(),
       problem.CurrentOperatingPoint(), *problem.Dynamics(),
-      problem.InitialState(), max_perturbation, open_loop);
+      problem.InitialState(), problem.Grid(), max_perturbation, open_loop);
 }
 
 bool CheckSufficientLocalNashEquilibrium(
     const std::vector<PlayerCost>& player_costs,
-    const OperatingPoint& operating_point,
-    const std::shared_ptr<const MultiPlayerIntegrableSystem> dynamics) {
+    const OperatingPoint& operating_point, Time time_step,
+    const std::shared_ptr<const MultiPlayerIntegrableSystem>& dynamics) {
+  return CheckSufficientLocalNashEquilibrium(player_costs, operating_point,
+                                             TimeGrid(time_step), dynamics);
+}
+
+bool CheckSufficientLocalNashEquilibrium(
+    const std::vector<PlayerCost>& player_costs,
+    const OperatingPoint& operating_point, const TimeGrid& time_grid,
+    const std::shared_ptr<const MultiPlayerIntegrableSystem>& dynamics) {
   // Unpack number of players and number of time steps.
   const PlayerIndex num_players = player_costs.size();
   const size_t num_time_steps = operating_point.xs.size();
@@ -156,7 +171,7 @@ bool CheckSufficientLocalNashEquilibrium(
 
   // Quadraticize costs and check PSD conditions.
   for (size_t kk = 0; kk < num_time_steps; kk++) {
-    const Time t = operating_point.t0 + static_cast<Time>(kk) * time::kTimeStep;
+    const Time t = operating_point.t0 + time_grid.RelativeTime(kk);
     VectorXf x = operating_point.xs[kk];
     std::vector<VectorXf> us = operating_point.us[kk];
 
@@ -188,9 +203,11 @@ bool CheckSufficientLocalNashEquilibrium(
         return false;
       }
 
-      for (const auto& entry : q.control) {
+      for (PlayerIndex jj = 0; jj < q.control.size(); jj++) {
+        if (!q.HasControl(jj)) continue;
+
         const auto eig_R =
-            Eigen::SelfAdjointEigenSolver<MatrixXf>(entry.second.hess);
+            Eigen::SelfAdjointEigenSolver<MatrixXf>(q.control[jj].hess);
         if (eig_R.eigenvalues().minCoeff() < -kErrorMargin) return false;
       }
     }
@@ -200,9 +217,9 @@ bool CheckSufficientLocalNashEquilibrium(
 }
 
 bool CheckSufficientLocalNashEquilibrium(const Problem& problem) {
-  return CheckSufficientLocalNashEquilibrium(problem.PlayerCosts(),
-                                             problem.CurrentOperatingPoint(),
-                                             problem.Dynamics());
+  return CheckSufficientLocalNashEquilibrium(
+      problem.PlayerCosts(), problem.CurrentOperatingPoint(),
+      problem.Grid(), problem.Dynamics());
 }
 
 }  // namespace ilqgames
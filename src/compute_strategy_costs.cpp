@@ -63,7 +63,18 @@ std::vector<float> ComputeStrategyCosts(
     const std::vector<Strategy>& strategies,
     const OperatingPoint& operating_point,
     const MultiPlayerIntegrableSystem& dynamics, const VectorXf& x0,
-    bool open_loop) {
+    Time time_step, bool open_loop, bool integrate_using_euler) {
+  return ComputeStrategyCosts(player_costs, strategies, operating_point,
+                              dynamics, x0, TimeGrid(time_step), open_loop,
+                              integrate_using_euler);
+}
+
+std::vector<float> ComputeStrategyCosts(
+    const std::vector<PlayerCost>& player_costs,
+    const std::vector<Strategy>& strategies,
+    const OperatingPoint& operating_point,
+    const MultiPlayerIntegrableSystem& dynamics, const VectorXf& x0,
+    const TimeGrid& time_grid, bool open_loop, bool integrate_using_euler) {
   // Start at the initial state.
   VectorXf x(x0);
   Time t = 0.0;
@@ -84,8 +95,11 @@ std::vector<float> ComputeStrategyCosts(
                                 operating_point.us[kk][ii]);
     }
 
-    const VectorXf next_x = dynamics.Integrate(t, time::kTimeStep, x, us);
-    const Time next_t = t + time::kTimeStep;
+    const Time time_step = time_grid.TimeStep(kk);
+    const VectorXf next_x =
+        (integrate_using_euler) ? dynamics.IntegrateEuler(t, time_step, x, us)
+                                : dynamics.Integrate(t, time_step, x, us);
+    const Time next_t = t + time_step;
 
     // Update costs.
     for (PlayerIndex ii = 0; ii < dynamics.NumPlayers(); ii++) {
@@ -93,7 +107,7 @@ std::vector<float> ComputeStrategyCosts(
           (open_loop) ? player_costs[ii].EvaluateOffset(t, next_t, next_x, us)
                       : player_costs[ii].Evaluate(t, x, us);
 
-      total_costs[ii] += cost;
+      total_costs[ii] += time_grid.CostWeight(kk) * cost;
     }
 
     // Update state and time
@@ -109,7 +123,7 @@ std::vector<float> ComputeStrategyCosts(const Problem& problem,
   return ComputeStrategyCosts(
       problem.PlayerCosts(), problem.CurrentStrategies(),
       problem.CurrentOperatingPoint(), *problem.Dynamics(),
-      problem.InitialState(), open_loop);
+      problem.InitialState(), problem.Grid(), open_loop);
 }
 
 }  // namespace ilqgames
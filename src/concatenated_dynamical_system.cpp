@@ -84,26 +84,41 @@ VectorXf ConcatenatedDynamicalSystem::Evaluate(
 }
 
 LinearDynamicsApproximation ConcatenatedDynamicalSystem::Linearize(
-    Time t, const VectorXf& x, const std::vector<VectorXf>& us) const {
+    Time t, Time time_step, const VectorXf& x,
+    const std::vector<VectorXf>& us) const {
+  LinearDynamicsApproximation linearization(*this);
+  Linearize(t, time_step, x, us, &linearization);
+  return linearization;
+}
+
+void ConcatenatedDynamicalSystem::Linearize(
+    Time t, Time time_step, const VectorXf& x, const std::vector<VectorXf>& us,
+    LinearDynamicsApproximation* linearization) const {
+  CHECK_NOTNULL(linearization);
   CHECK_EQ(us.size(), NumPlayers());
 
-  // Populate a block-diagonal A, as well as Bs.
-  LinearDynamicsApproximation linearization(*this);
+  // Reset to identity A and zero Bs, since subsystems only write to their own
+  // blocks.
+  linearization->A.setIdentity(xdim_, xdim_);
+  linearization->Bs.resize(NumPlayers());
+  linearization->x_block_starts.resize(NumPlayers());
+  linearization->x_block_dims.resize(NumPlayers());
 
-  Dimension dims_so_far = 0;
+  // Populate a block-diagonal A, as well as Bs, and record the blocks.
   for (size_t ii = 0; ii < NumPlayers(); ii++) {
     const auto& subsystem = subsystems_[ii];
+    const Dimension start_dim = subsystem_start_dims_[ii];
     const Dimension xdim = subsystem->XDim();
     const Dimension udim = subsystem->UDim();
+    linearization->Bs[ii].setZero(xdim_, udim);
     subsystem->Linearize(
-        t, x.segment(dims_so_far, xdim), us[ii],
-        linearization.A.block(dims_so_far, dims_so_far, xdim, xdim),
-        linearization.Bs[ii].block(dims_so_far, 0, xdim, udim));
+        t, time_step, x.segment(start_dim, xdim), us[ii],
+        linearization->A.block(start_dim, start_dim, xdim, xdim),
+        linearization->Bs[ii].block(start_dim, 0, xdim, udim));
 
-    dims_so_far += subsystem->XDim();
+    linearization->x_block_starts[ii] = start_dim;
+    linearization->x_block_dims[ii] = xdim;
   }
-
-  return linearization;
 }
 
 float ConcatenatedDynamicalSystem::DistanceBetween(const VectorXf& x0,
@@ -83,7 +83,7 @@ VectorXf ConcatenatedFlatSystem::Evaluate(
   return xdot;
 }
 
-void ConcatenatedFlatSystem::ComputeLinearizedSystem() const {
+void ConcatenatedFlatSystem::ComputeLinearizedSystem(Time time_step) const {
   // Populate a block-diagonal A, as well as Bs.
   LinearDynamicsApproximation linearization(*this);
 
@@ -93,19 +93,24 @@ void ConcatenatedFlatSystem::ComputeLinearizedSystem() const {
     const Dimension xdim = subsystem->XDim();
     const Dimension udim = subsystem->UDim();
     subsystem->LinearizedSystem(
-        linearization.A.block(dims_so_far, dims_so_far, xdim, xdim),
+        time_step, linearization.A.block(dims_so_far, dims_so_far, xdim, xdim),
         linearization.Bs[ii].block(dims_so_far, 0, xdim, udim));
 
+    // Record the block structure.
+    linearization.x_block_starts.push_back(dims_so_far);
+    linearization.x_block_dims.push_back(xdim);
+
     dims_so_far += xdim;
   }
 
   discrete_linear_system_.reset(new LinearDynamicsApproximation(linearization));
+  discrete_time_step_ = time_step;
 
   // Reconstruct the continuous system.
   linearization.A -= MatrixXf::Identity(xdim_, xdim_);
-  linearization.A /= time::kTimeStep;
+  linearization.A /= time_step;
   for (size_t ii = 0; ii < NumPlayers(); ii++)
-    linearization.Bs[ii] /= time::kTimeStep;
+    linearization.Bs[ii] /= time_step;
   continuous_linear_system_.reset(
       new LinearDynamicsApproximation(linearization));
 }
@@ -331,6 +336,7 @@ void ConcatenatedFlatSystem::ChangeCostCoordinates(
     //             << "-----------------\n";
     // }
     (*q)[pp].state.hess.swap(hess_xs[pp]);
+    (*q)[pp].state.is_hess_sparse = false;
   }
 
   // For loop for gradient.
@@ -396,9 +402,11 @@ void ConcatenatedFlatSystem::ChangeControlCostCoordinates(
 
   // Convert Rs.
   for (size_t ii = 0; ii < NumPlayers(); ii++) {
-    for (auto& element : (*q)[ii].control) {
-      element.second.hess = M_invs[element.first].transpose() *
-                            element.second.hess * M_invs[element.first];
+    for (PlayerIndex jj = 0; jj < NumPlayers(); jj++) {
+      if (!(*q)[ii].HasControl(jj)) continue;
+
+      auto& element = (*q)[ii].control[jj];
+      element.hess = M_invs[jj].transpose() * element.hess * M_invs[jj];
     }
   }
 }
@@ -58,13 +58,12 @@
 
 namespace ilqgames {
 
-float Constraint::mu_ = constants::kDefaultMu;
-
 void Constraint::ModifyDerivatives(Time t, float g, float* dx, float* ddx,
                                    float* dy, float* ddy, float* dxdy) const {
   // Unpack lambda.
-  const float lambda = lambdas_[TimeIndex(t)];
-  const float mu = Mu(lambda, g);
+  const size_t kk = TimeIndex(t);
+  const float lambda = lambdas_[kk];
+  const float mu = Mu(mus_[kk], lambda, g);
 
   // Assumes that these are just the derivatives of g(x, y), and modifies them
   // to be derivatives of lambda g(x) + mu g(x) g(x) / 2.
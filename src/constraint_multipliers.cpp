@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Contiguous storage for the Lagrange multipliers of every constraint in a
+// problem.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/constraint/constraint.h>
+#include <ilqgames/cost/player_cost.h>
+#include <ilqgames/utils/constraint_multipliers.h>
+#include <ilqgames/utils/operating_point.h>
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace ilqgames {
+
+void ConstraintMultipliers::Bind(const std::vector<PlayerCost>& player_costs,
+                                 size_t num_time_steps) {
+  // Gather distinct constraints.
+  constraints_.clear();
+  auto add_constraint = [this](const std::shared_ptr<Constraint>& constraint,
+                               int player) {
+    for (const auto& entry : constraints_) {
+      if (entry.constraint == constraint) return;
+    }
+
+    constraints_.push_back({constraint, player});
+  };
+
+  for (const auto& pc : player_costs) {
+    for (const auto& constraint : pc.StateConstraints())
+      add_constraint(constraint, -1);
+    for (const auto& pair : pc.ControlConstraints())
+      add_constraint(pair.second, pair.first);
+  }
+
+  // Bind each constraint to a row of a new matrix, which copies its current
+  // multipliers, before releasing any old storage.
+  RowMatrixXf lambdas(constraints_.size(), num_time_steps);
+  RowMatrixXf mus(constraints_.size(), num_time_steps);
+  lower_bounds_.resize(constraints_.size());
+  for (size_t ii = 0; ii < constraints_.size(); ii++) {
+    const auto& constraint = constraints_[ii].constraint;
+    CHECK_EQ(constraint->NumTimeSteps(), num_time_steps);
+    constraint->BindMultipliers(lambdas.row(ii).data(), mus.row(ii).data());
+    lower_bounds_(ii) =
+        (constraint->IsEquality()) ? -constants::kInfinity : 0.0;
+  }
+
+  // Swapping dynamic Eigen matrices swaps their data pointers, so the rows
+  // bound above remain valid.
+  lambdas_.swap(lambdas);
+  mus_.swap(mus);
+  violations_.setZero(constraints_.size(), num_time_steps);
+}
+
+float ConstraintMultipliers::EvaluateViolations(const OperatingPoint& op) {
+  CHECK_LE(op.xs.size(), static_cast<size_t>(violations_.cols()));
+  if (constraints_.empty()) return -constants::kInfinity;
+
+  // Evaluate one constraint at a time so that each row is written
+  // contiguously. Time steps which round to the same multiplier index (see
+  // `RelativeTimeTracker::TimeIndex`) accumulate, just as they would with
+  // successive scalar updates.
+  violations_.setZero();
+  for (size_t ii = 0; ii < constraints_.size(); ii++) {
+    const Constraint& constraint = *constraints_[ii].constraint;
+    const int player = constraints_[ii].player;
+    for (size_t kk = 0; kk < op.xs.size(); kk++) {
+      const Time t = op.t0 + constraint.Grid().RelativeTime(kk);
+      violations_(ii, constraint.TimeIndex(t)) +=
+          constraint.Evaluate(t, (player < 0) ? op.xs[kk] : op.us[kk][player]);
+    }
+  }
+
+  return violations_.maxCoeff();
+}
+
+void ConstraintMultipliers::IncrementLambdas() {
+  lambdas_ += mus_.cwiseProduct(violations_);
+  lambdas_ = lambdas_.cwiseMax(lower_bounds_.replicate(1, lambdas_.cols()));
+}
+
+void ConstraintMultipliers::Shift(Time offset, const TimeGrid& time_grid) {
+  CHECK_GE(offset, 0.0);
+  if (constraints_.empty()) return;
+
+  // Since the offset is nonnegative, each source column is at or after its
+  // destination, so columns may be copied forward in place.
+  const size_t num_time_steps = lambdas_.cols();
+  for (size_t kk = 0; kk < num_time_steps; kk++) {
+    const size_t source =
+        time_grid.Index(offset + time_grid.RelativeTime(kk) +
+                        constants::kSmallNumber * time_grid.TimeStep(kk));
+    if (source < num_time_steps) {
+      if (source == kk) continue;
+      lambdas_.col(kk) = lambdas_.col(source);
+      mus_.col(kk) = mus_.col(source);
+    } else {
+      lambdas_.col(kk).setConstant(constants::kDefaultLambda);
+      mus_.col(kk).setConstant(constants::kDefaultMu);
+    }
+  }
+}
+
+Time ConstraintMultipliers::InitialTime() const {
+  return (constraints_.empty())
+             ? 0.0
+             : constraints_.front().constraint->InitialTime();
+}
+
+void ConstraintMultipliers::ScaleMu(float scale) {
+  for (const auto& entry : constraints_) entry.constraint->ScaleMu(scale);
+}
+
+void ConstraintMultipliers::SetMu(float mu) {
+  for (const auto& entry : constraints_) entry.constraint->SetMu(mu);
+}
+
+}  // namespace ilqgames
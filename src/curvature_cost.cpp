@@ -55,12 +55,13 @@ float CurvatureCost::Evaluate(const VectorXf& input) const {
 
 void CurvatureCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
                                  VectorXf* grad) const {
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
 
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Populate Hessian and gradient.
@@ -79,10 +80,12 @@ void CurvatureCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
   (*grad)(omega_idx_) += domega;
   (*grad)(v_idx_) += dv;
 
-  (*hess)(omega_idx_, omega_idx_) += ddomega;
-  (*hess)(omega_idx_, v_idx_) += domega_dv;
-  (*hess)(v_idx_, omega_idx_) += domega_dv;
-  (*hess)(v_idx_, v_idx_) += ddv;
+  if (hess) {
+    (*hess)(omega_idx_, omega_idx_) += ddomega;
+    (*hess)(omega_idx_, v_idx_) += domega_dv;
+    (*hess)(v_idx_, omega_idx_) += domega_dv;
+    (*hess)(v_idx_, v_idx_) += ddv;
+  }
 }
 
 }  // namespace ilqgames
@@ -72,12 +72,6 @@
 namespace ilqgames {
 
 namespace {
-// Time.
-static constexpr Time kTimeStep = 0.1;      // s
-static constexpr Time kTimeHorizon = 10.0;  // s
-static constexpr size_t kNumTimeSteps =
-    static_cast<size_t>(kTimeHorizon / kTimeStep);
-
 // Cost weights.
 static constexpr float kAuxCostWeight = 4.0;
 static constexpr float kGoalCostWeight = 10.0;
@@ -215,14 +209,14 @@ void FlatRoundaboutMergingExample::ConstructInitialState() {
 
 void FlatRoundaboutMergingExample::ConstructInitialOperatingPoint() {
   // Initialize operating points to follow these lanes at the nominal speed.
-  InitializeAlongRoute(lane1, 0.0, kP1InitialSpeed, {kP1XIdx, kP1YIdx},
-                       operating_point_.get());
-  InitializeAlongRoute(lane2, 0.0, kP2InitialSpeed, {kP2XIdx, kP2YIdx},
-                       operating_point_.get());
-  InitializeAlongRoute(lane3, 0.0, kP3InitialSpeed, {kP3XIdx, kP3YIdx},
-                       operating_point_.get());
-  InitializeAlongRoute(lane4, 0.0, kP4InitialSpeed, {kP4XIdx, kP4YIdx},
-                       operating_point_.get());
+  InitializeAlongRoute(lane1, 0.0, kP1InitialSpeed, time_step_,
+                       {kP1XIdx, kP1YIdx}, operating_point_.get());
+  InitializeAlongRoute(lane2, 0.0, kP2InitialSpeed, time_step_,
+                       {kP2XIdx, kP2YIdx}, operating_point_.get());
+  InitializeAlongRoute(lane3, 0.0, kP3InitialSpeed, time_step_,
+                       {kP3XIdx, kP3YIdx}, operating_point_.get());
+  InitializeAlongRoute(lane4, 0.0, kP4InitialSpeed, time_step_,
+                       {kP4XIdx, kP4YIdx}, operating_point_.get());
 }
 
 void FlatRoundaboutMergingExample::ConstructPlayerCosts() {
@@ -50,10 +50,13 @@
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/quadratic_cost_approximation.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/thread_pool.h>
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <numeric>
 #include <vector>
@@ -74,139 +77,366 @@ void ScaleAlphas(float scaling, std::vector<Strategy>* strategies) {
 }  // anonymous namespace
 
 std::shared_ptr<SolverLog> ILQSolver::Solve(bool* success, Time max_runtime) {
-  const auto solver_call_time = Clock::now();
+  Start(max_runtime);
+  while (Step()) continue;
+  return Finish(success);
+}
+
+const std::shared_ptr<SolverLog>& ILQSolver::Start(Time max_runtime) {
+  solver_call_time_ = Clock::now();
+  max_runtime_ = max_runtime;
+  reached_deadline_ = false;
+  last_merit_function_value_ = constants::kInfinity;
 
-  // Create a new log.
-  std::shared_ptr<SolverLog> log = CreateNewLog();
+  // Create a new log, with room for every iterate this solve might add: the
+  // initial one, one per iteration, and maybe a single shooting rollout (see
+  // `Finish`).
+  log_ = CreateNewLog();
+  log_->Reserve(params_.max_solver_iters + 2);
 
-  // Last and current operating points. Make sure the last one starts from the
-  // current state so that the current one will start there as well.
+  // Make sure the last operating point starts from the current state so that
+  // the current one will start there as well.
   // NOTE: setting the current operating point to start at x0 is critical to the
   // constraint satisfaction check at the first iteration.
-  OperatingPoint last_operating_point(problem_->CurrentOperatingPoint());
-  OperatingPoint current_operating_point(problem_->CurrentOperatingPoint());
-  current_operating_point.xs[0] = problem_->InitialState();
-  last_operating_point.xs[0] = problem_->InitialState();
+  last_operating_point_ = problem_->CurrentOperatingPoint();
+  last_operating_point_.xs[0] = problem_->InitialState();
+  current_operating_point_ = last_operating_point_;
 
   // Current strategies.
-  std::vector<Strategy> current_strategies(problem_->CurrentStrategies());
+  current_strategies_ = problem_->CurrentStrategies();
 
   // Things to keep track of during each iteration.
-  size_t num_iterations = 0;
-  bool has_converged = false;
-
-  // Swap operating points and compute new current operating point. Future
-  // operating points will be computed during the call to `ModifyLQStrategies`
-  // which occurs after solving the LQ game.
-  std::vector<float> total_costs;
-  last_operating_point.swap(current_operating_point);
-  CurrentOperatingPoint(last_operating_point, current_strategies,
-                        &current_operating_point);
+  num_iterations_ = 0;
+  has_converged_ = false;
+  failed_ = false;
+  terminated_ = false;
+  elapsed_ = 0.0;
+  telemetry_ = IterateTelemetry();
+
+  // Clear lazy relinearization and requadraticization caches, which may be
+  // stale if initial times or constraint multipliers have changed.
+  has_linearization_reference_ = false;
+  has_quadraticization_reference_ = false;
+  num_reused_linearizations_ = 0;
+  num_reused_quadraticizations_ = 0;
+
+  // Compute new current operating point. Future operating points will be
+  // computed during the call to `ModifyLQStrategies` which occurs after solving
+  // the LQ game.
+  // NOTE: this is always a single shooting rollout, so that every iterate is
+  // dynamically feasible unless multiple shooting is enabled.
+  current_operating_point_.t0 = last_operating_point_.t0;
+  {
+    ScopedPhaseTimer phase("rollout", &telemetry_.rollout_time, TraceEvents());
+    RollOut(0, problem_->NumTimeSteps(), last_operating_point_,
+            current_strategies_, &delta_x_, &integration_workspace_,
+            &current_operating_point_);
+  }
 
   // Compute total costs.
-  TotalCosts(current_operating_point, &total_costs);
-
-  // Log current iterate.
-  Time elapsed = 0.0;
-  log->AddSolverIterate(current_operating_point, current_strategies,
-                        total_costs, elapsed, has_converged);
+  TotalCosts(current_operating_point_, &total_costs_);
 
   // Quadraticize costs before first iteration. Subsequent quadraticizations
   // will happen inside the linesearch every time we compute the merit function.
-  ComputeCostQuadraticization(current_operating_point, &cost_quadraticization_);
-
-  // Maintain delta_xs and costates for linesearch.
-  std::vector<VectorXf> delta_xs;
-  std::vector<std::vector<VectorXf>> costates;
-
-  // Main loop with timer for anytime execution.
-  while (num_iterations < params_.max_solver_iters && !has_converged &&
-         elapsed < max_runtime - timer_.RuntimeUpperBound()) {
-    // Start loop timer.
-    timer_.Tic();
-
-    // New iteration.
-    num_iterations++;
-
-    // Linearize dynamics about the new operating point, only if the system
-    // can't be treated as linear from the outset, in which case we've already
-    // linearized it.
-    // NOTE: we are already computing a new quadraticization
-    // during the linesearch process.
-    if (!problem_->Dynamics()->TreatAsLinear())
-      ComputeLinearization(current_operating_point, &linearization_);
-
-    // Solve LQ game.
-    current_strategies =
-        lq_solver_->Solve(linearization_, cost_quadraticization_,
-                          problem_->InitialState(), &delta_xs, &costates);
-
-    // Modify this LQ solution.
-    if (!ModifyLQStrategies(delta_xs, costates, &current_strategies,
-                            &current_operating_point, &has_converged)) {
-      // Maybe emit warning if exiting early.
-      VLOG(1) << "Solver exited due to linesearch failure.";
-
-      // Handle success flag.
-      if (success) *success = false;
-
-      return log;
-    }
+  {
+    ScopedPhaseTimer phase("quadraticization",
+                           &telemetry_.quadraticization_time, TraceEvents());
+    ComputeCostQuadraticization(current_operating_point_,
+                                &cost_quadraticization_);
+  }
 
-    // Compute total costs and check if we've converged.
-    TotalCosts(current_operating_point, &total_costs);
+  // Log current iterate.
+  log_->AddSolverIterate(current_operating_point_, current_strategies_,
+                         total_costs_, elapsed_, has_converged_, telemetry_);
 
-    // Record loop runtime.
-    elapsed += timer_.Toc();
+  return log_;
+}
 
-    // Log current iterate.
-    log->AddSolverIterate(current_operating_point, current_strategies,
-                          total_costs, elapsed, has_converged);
+bool ILQSolver::Step() {
+  CHECK_NOTNULL(log_.get());
+  if (terminated_) return false;
+
+  // Check termination with timer for anytime execution. With a hard deadline,
+  // the timing checks happen before each phase of an iteration instead.
+  if (num_iterations_ >= params_.max_solver_iters || has_converged_ ||
+      (!params_.hard_deadline &&
+       elapsed_ >= max_runtime_ - timer_.RuntimeUpperBound())) {
+    terminated_ = true;
+    return false;
   }
 
+  // Start loop timer, and time this iterate as a whole for the trace.
+  timer_.Tic();
+  telemetry_ = IterateTelemetry();
+  ScopedPhaseTimer iterate_phase("iterate", nullptr, TraceEvents());
+
+  // New iteration.
+  num_iterations_++;
+
+  // Linearize, solve LQ game, and modify the LQ solution.
+  if (!Iterate(&current_strategies_, &current_operating_point_,
+               &has_converged_)) {
+    // Maybe emit warning if exiting early.
+    VLOG_IF(1, reached_deadline_) << "Solver stopped at its deadline.";
+    VLOG_IF(1, !reached_deadline_)
+        << "Solver exited due to linesearch failure.";
+
+    // Without a hard deadline, a linesearch failure is a failure. Otherwise,
+    // fall back on the last accepted iterate.
+    failed_ = !params_.hard_deadline;
+    terminated_ = true;
+    return false;
+  }
+
+  // Compute total costs and check if we've converged.
+  logging_timer_.Tic();
+  TotalCosts(current_operating_point_, &total_costs_);
+
+  // Record loop runtime.
+  elapsed_ += timer_.Toc();
+
+  // Log current iterate.
+  log_->AddSolverIterate(current_operating_point_, current_strategies_,
+                         total_costs_, elapsed_, has_converged_, telemetry_);
+  logging_timer_.Toc();
+
+  // Maybe stop early at the caller's request.
+  if (!has_converged_ && stop_callback_ && stop_callback_(*log_)) {
+    VLOG(1) << "Solver stopped by callback.";
+    terminated_ = true;
+    return false;
+  }
+
+  return true;
+}
+
+std::shared_ptr<SolverLog> ILQSolver::Finish(bool* success) {
+  CHECK_NOTNULL(log_.get());
+
+  // With multiple shooting, the last accepted iterate may have defects between
+  // segments unless the solver converged. If so, log a single shooting rollout
+  // which tracks it, so that the final iterate is dynamically feasible.
+  if (IsMultipleShooting() && log_->NumIterates() > 1 &&
+      ComputeDefects(log_->FinalOperatingPoint()) > params_.defect_tolerance)
+    LogSingleShootingRollout();
+
+  // Record the quality of the final iterate. This is the last one accepted (or
+  // a single shooting rollout which tracks it), which is always dynamically
+  // feasible.
+  if (failed_)
+    log_->SetQuality((num_iterations_ > 1) ? IMPROVED : NOT_IMPROVED);
+  else if (has_converged_)
+    log_->SetQuality(CONVERGED);
+  else
+    log_->SetQuality((log_->NumIterates() > 1) ? IMPROVED : NOT_IMPROVED);
+  log_->SetReachedDeadline(reached_deadline_);
+
   // Handle success flag.
-  if (success) *success = true;
+  if (success) *success = !failed_;
 
+  // Release the log so that the next solve starts a fresh one.
+  std::shared_ptr<SolverLog> log;
+  log.swap(log_);
   return log;
 }
 
+void ILQSolver::LogSingleShootingRollout() {
+  // Track the final iterate with its own feedback gains, and no feedforward
+  // term.
+  last_operating_point_ = log_->FinalOperatingPoint();
+  current_strategies_ = log_->FinalStrategies();
+  ScaleAlphas(0.0, &current_strategies_);
+
+  current_operating_point_.t0 = last_operating_point_.t0;
+  RollOut(0, problem_->NumTimeSteps(), last_operating_point_,
+          current_strategies_, &delta_x_, &integration_workspace_,
+          &current_operating_point_);
+  TotalCosts(current_operating_point_, &total_costs_);
+
+  constexpr bool kWasConverged = false;
+  log_->AddSolverIterate(current_operating_point_, current_strategies_,
+                         total_costs_, elapsed_, kWasConverged);
+}
+
+bool ILQSolver::HasTimeFor(const QuantileTimer& phase_timer) {
+  if (!params_.hard_deadline) return true;
+
+  // Leave time to log the result of this phase.
+  const Time predicted_runtime =
+      phase_timer.RuntimeQuantile(params_.deadline_runtime_quantile) +
+      logging_timer_.RuntimeQuantile(params_.deadline_runtime_quantile);
+  const Time elapsed =
+      std::chrono::duration<Time>(Clock::now() - solver_call_time_).count();
+  if (elapsed + predicted_runtime <= max_runtime_) return true;
+
+  reached_deadline_ = true;
+  return false;
+}
+
+bool ILQSolver::Iterate(std::vector<Strategy>* current_strategies,
+                        OperatingPoint* current_operating_point,
+                        bool* has_converged) {
+  CHECK_NOTNULL(current_strategies);
+  CHECK_NOTNULL(current_operating_point);
+  CHECK_NOTNULL(has_converged);
+
+  // Linearize dynamics about the new operating point, only if the system
+  // can't be treated as linear from the outset, in which case we've already
+  // linearized it.
+  // NOTE: we are already computing a new quadraticization
+  // during the linesearch process.
+  if (!problem_->Dynamics()->TreatAsLinear()) {
+    if (!HasTimeFor(linearization_timer_)) return false;
+    linearization_timer_.Tic();
+    {
+      ScopedPhaseTimer phase("linearization", &telemetry_.linearization_time,
+                             TraceEvents());
+      ComputeLinearization(*current_operating_point, &linearization_);
+    }
+    linearization_timer_.Toc();
+  }
+
+  // With multiple shooting, account for defects between segments as drift in
+  // the linearized dynamics at the end of each segment.
+  if (IsMultipleShooting()) {
+    ComputeDefects(*current_operating_point);
+    for (size_t jj = 1; jj < segment_starts_.size(); jj++)
+      linearization_[segment_starts_[jj] - 1].c = defects_[jj];
+  }
+
+  // Solve LQ game.
+  if (!HasTimeFor(lq_solve_timer_)) return false;
+  lq_solve_timer_.Tic();
+  {
+    ScopedPhaseTimer phase("lq_solve", &telemetry_.lq_solve_time,
+                           TraceEvents());
+    lq_solver_->Solve(linearization_, cost_quadraticization_,
+                      problem_->InitialState(), current_strategies, &delta_xs_,
+                      &costates_);
+  }
+  lq_solve_timer_.Toc();
+  if (IsMultipleShooting()) ComputeSegmentSteps(*current_strategies);
+
+  // Modify this LQ solution.
+  {
+    ScopedPhaseTimer phase("linesearch", &telemetry_.linesearch_time,
+                           TraceEvents());
+    if (!ModifyLQStrategies(delta_xs_, costates_, current_strategies,
+                            current_operating_point, has_converged))
+      return false;
+  }
+
+  // With multiple shooting, the solver has not converged until all segments
+  // join up.
+  if (*has_converged && IsMultipleShooting()) {
+    *has_converged =
+        ComputeDefects(*current_operating_point) <= params_.defect_tolerance;
+  }
+
+  return true;
+}
+
+void ILQSolver::CurrentOperatingPoint(
+    const OperatingPoint& last_operating_point,
+    const std::vector<Strategy>& current_strategies, float step_size,
+    OperatingPoint* current_operating_point) {
+  ScopedPhaseTimer phase("rollout", &telemetry_.rollout_time, TraceEvents());
+  if (!IsMultipleShooting() || !thread_pool_) {
+    CurrentOperatingPoint(last_operating_point, current_strategies, step_size,
+                          &delta_x_, &integration_workspace_,
+                          current_operating_point);
+    return;
+  }
+
+  // Roll out all segments in parallel.
+  CHECK_NOTNULL(current_operating_point);
+  current_operating_point->t0 = last_operating_point.t0;
+  ParallelFor(segment_starts_.size(), [&](size_t jj) {
+    RollOutSegment(jj, last_operating_point, current_strategies, step_size,
+                   &segment_delta_xs_[jj], &segment_integration_workspaces_[jj],
+                   current_operating_point);
+  });
+}
+
 void ILQSolver::CurrentOperatingPoint(
     const OperatingPoint& last_operating_point,
-    const std::vector<Strategy>& current_strategies,
+    const std::vector<Strategy>& current_strategies, float step_size,
+    VectorXf* delta_x,
+    MultiPlayerIntegrableSystem::IntegrationWorkspace* integration_workspace,
     OperatingPoint* current_operating_point) const {
   CHECK_NOTNULL(current_operating_point);
 
-  // Initialize time.
   current_operating_point->t0 = last_operating_point.t0;
+  for (size_t jj = 0; jj < segment_starts_.size(); jj++) {
+    RollOutSegment(jj, last_operating_point, current_strategies, step_size,
+                   delta_x, integration_workspace, current_operating_point);
+  }
+}
+
+void ILQSolver::RollOutSegment(
+    size_t segment, const OperatingPoint& last_operating_point,
+    const std::vector<Strategy>& current_strategies, float step_size,
+    VectorXf* delta_x,
+    MultiPlayerIntegrableSystem::IntegrationWorkspace* integration_workspace,
+    OperatingPoint* current_operating_point) const {
+  CHECK_NOTNULL(current_operating_point);
+
+  // Initialize state. The first segment always starts at the initial state,
+  // and others move along the last LQ step.
+  const size_t start = segment_starts_[segment];
+  const size_t stop = (segment + 1 < segment_starts_.size())
+                          ? segment_starts_[segment + 1]
+                          : problem_->NumTimeSteps();
+  current_operating_point->xs[start] = last_operating_point.xs[start];
+  if (segment > 0)
+    current_operating_point->xs[start] += step_size * segment_steps_[segment];
+
+  RollOut(start, stop, last_operating_point, current_strategies, delta_x,
+          integration_workspace, current_operating_point);
+}
+
+void ILQSolver::RollOut(
+    size_t start, size_t stop, const OperatingPoint& last_operating_point,
+    const std::vector<Strategy>& current_strategies, VectorXf* delta_x,
+    MultiPlayerIntegrableSystem::IntegrationWorkspace* integration_workspace,
+    OperatingPoint* current_operating_point) const {
+  CHECK_NOTNULL(delta_x);
+  CHECK_NOTNULL(integration_workspace);
+  CHECK_NOTNULL(current_operating_point);
+
+  // Initialize state, unless it is already set.
+  if (start == 0)
+    current_operating_point->xs[0] = last_operating_point.xs[0];
 
   // Integrate dynamics and populate operating point, one time step at a time.
-  VectorXf x(last_operating_point.xs[0]);
-  for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
-    const Time t = RelativeTimeTracker::RelativeTime(kk);
+  // NOTE: we integrate directly into the next state, and keep all temporaries
+  // in preallocated workspaces to avoid allocating memory.
+  for (size_t kk = start; kk < stop; kk++) {
+    const Time t = current_operating_point->t0 + problem_->RelativeTime(kk);
 
     // Unpack.
-    const VectorXf delta_x = x - last_operating_point.xs[kk];
+    const VectorXf& x = current_operating_point->xs[kk];
+    *delta_x = x - last_operating_point.xs[kk];
     const auto& last_us = last_operating_point.us[kk];
     auto& current_us = current_operating_point->us[kk];
 
-    // Record state.
-    current_operating_point->xs[kk] = x;
-
     // Compute and record control for each player.
     for (PlayerIndex jj = 0; jj < problem_->Dynamics()->NumPlayers(); jj++) {
       const auto& strategy = current_strategies[jj];
-      current_us[jj] = strategy(kk, delta_x, last_us[jj]);
+      strategy(kk, *delta_x, last_us[jj], &current_us[jj]);
     }
 
     // Integrate dynamics for one time step.
-    if (kk < time::kNumTimeSteps - 1)
-      x = problem_->Dynamics()->Integrate(t, time::kTimeStep, x, current_us);
+    if (kk < stop - 1)
+      problem_->Dynamics()->Integrate(
+          t, problem_->TimeStep(kk), x, current_us, integration_workspace,
+          &current_operating_point->xs[kk + 1]);
   }
 }
 
 // bool ILQSolver::HasConverged(const OperatingPoint& last_op,
 //                              const OperatingPoint& current_op) const {
-//   for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
+//   for (size_t kk = 0; kk < problem_->NumTimeSteps(); kk++) {
 //     const float delta_x_distance = StateDistance(
 //         current_op.xs[kk], last_op.xs[kk], params_.trust_region_dimensions);
 
@@ -217,7 +447,7 @@ void ILQSolver::CurrentOperatingPoint(
 // }
 
 void ILQSolver::TotalCosts(const OperatingPoint& current_op,
-                           std::vector<float>* total_costs) const {
+                           std::vector<float>* total_costs) {
   // Initialize appropriately.
   if (total_costs->size() != problem_->PlayerCosts().size())
     total_costs->resize(problem_->PlayerCosts().size());
@@ -231,24 +461,23 @@ void ILQSolver::TotalCosts(const OperatingPoint& current_op,
   }
 
   // Accumulate costs.
-  for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
-    const Time t = RelativeTimeTracker::RelativeTime(kk);
+  for (size_t kk = 0; kk < problem_->NumTimeSteps(); kk++) {
+    const Time t = current_op.t0 + problem_->RelativeTime(kk);
 
     for (size_t ii = 0; ii < problem_->PlayerCosts().size(); ii++) {
       const float current_cost = problem_->PlayerCosts()[ii].Evaluate(
           t, current_op.xs[kk], current_op.us[kk]);
 
       if (problem_->PlayerCosts()[ii].IsTimeAdditive())
-        (*total_costs)[ii] += problem_->PlayerCosts()[ii].Evaluate(
-            t, current_op.xs[kk], current_op.us[kk]);
+        (*total_costs)[ii] += problem_->Grid().CostWeight(kk) * current_cost;
       else if (problem_->PlayerCosts()[ii].IsMaxOverTime() &&
                current_cost > (*total_costs)[ii]) {
         (*total_costs)[ii] = current_cost;
-        problem_->PlayerCosts()[ii].SetTimeOfExtremeCost(kk);
+        times_of_extreme_costs_[ii] = kk;
       } else if (problem_->PlayerCosts()[ii].IsMinOverTime()) {
         if (current_cost < (*total_costs)[ii]) {
           (*total_costs)[ii] = current_cost;
-          problem_->PlayerCosts()[ii].SetTimeOfExtremeCost(kk);
+          times_of_extreme_costs_[ii] = kk;
         }
       }
     }
@@ -300,6 +529,7 @@ bool ILQSolver::ModifyLQStrategies(
 
   // Precompute expected decrease before we do anything else.
   expected_decrease_ = ExpectedDecrease(*strategies, delta_xs, costates);
+  telemetry_.expected_decrease = expected_decrease_;
 
   // Every computation of the merit function will overwrite the current cost
   // quadraticization, so first swap it with the previous one so we retain a
@@ -312,31 +542,63 @@ bool ILQSolver::ModifyLQStrategies(
   ScaleAlphas(params_.initial_alpha_scaling, strategies);
 
   // Compute next operating point and keep track of whether it satisfies the
-  // Armijo condition.
-  const OperatingPoint last_operating_point(*current_operating_point);
+  // Armijo condition. Maybe try several step sizes at once.
+  // NOTE: copy-assigning into a member reuses its storage.
+  last_operating_point_ = *current_operating_point;
+  if (params_.linesearch && !linesearch_candidates_.empty())
+    return SpeculativeLinesearch(strategies, current_operating_point,
+                                 has_converged);
+
+  // Time each trial step (rollout and merit function evaluation), so that we
+  // can stop before one which would overrun a hard deadline.
   float current_stepsize = params_.initial_alpha_scaling;
-  CurrentOperatingPoint(last_operating_point, *strategies,
+  if (!HasTimeFor(linesearch_timer_)) return false;
+  linesearch_timer_.Tic();
+  CurrentOperatingPoint(last_operating_point_, *strategies, current_stepsize,
                         current_operating_point);
-  if (!params_.linesearch) return true;
+  if (!params_.linesearch) {
+    linesearch_timer_.Toc();
+    telemetry_.step_size = current_stepsize;
+    return true;
+  }
 
   // Keep reducing alphas until we satisfy the Armijo condition.
   for (size_t ii = 0; ii < params_.max_backtracking_steps; ii++) {
-    // Compute merit function value.
+    // Compute merit function value. The first trial step is usually accepted,
+    // so compute a full quadraticization there; subsequent (backtracking)
+    // trials only need gradients, and Hessians are filled in once a step is
+    // accepted.
+    const bool full_quadraticization = (ii == 0);
     const float current_merit_function_value =
-        MeritFunction(*current_operating_point);
+        MeritFunction(*current_operating_point, full_quadraticization);
+    linesearch_timer_.Toc();
 
     // Check Armijo condition.
     if (CheckArmijoCondition(current_merit_function_value, current_stepsize)) {
-      // Success! Update cached terms and check convergence.
+      // Success! Complete the quadraticization if necessary.
+      if (!full_quadraticization) {
+        ScopedPhaseTimer phase("quadraticization",
+                               &telemetry_.quadraticization_time,
+                               TraceEvents());
+        ComputeCostQuadraticization(*current_operating_point,
+                                    &cost_quadraticization_);
+      }
+
+      // Update cached terms and check convergence.
       *has_converged = HasConverged(current_merit_function_value);
       last_merit_function_value_ = current_merit_function_value;
+      telemetry_.num_backtracking_steps = ii;
+      telemetry_.merit_function_value = current_merit_function_value;
+      telemetry_.step_size = current_stepsize;
       return true;
     }
 
     // Scale down the alphas and try again.
+    if (!HasTimeFor(linesearch_timer_)) return false;
+    linesearch_timer_.Tic();
     ScaleAlphas(params_.geometric_alpha_scaling, strategies);
     current_stepsize *= params_.geometric_alpha_scaling;
-    CurrentOperatingPoint(last_operating_point, *strategies,
+    CurrentOperatingPoint(last_operating_point_, *strategies, current_stepsize,
                           current_operating_point);
   }
 
@@ -345,6 +607,105 @@ bool ILQSolver::ModifyLQStrategies(
   return false;
 }
 
+bool ILQSolver::SpeculativeLinesearch(std::vector<Strategy>* strategies,
+                                      OperatingPoint* current_operating_point,
+                                      bool* has_converged) {
+  CHECK_NOTNULL(strategies);
+  CHECK_NOTNULL(current_operating_point);
+  CHECK_NOTNULL(has_converged);
+
+  float current_stepsize = params_.initial_alpha_scaling;
+  for (size_t ii = 0; ii < params_.max_backtracking_steps;
+       ii += linesearch_candidates_.size()) {
+    if (!HasTimeFor(linesearch_timer_)) return false;
+    linesearch_timer_.Tic();
+
+    // Set up candidate strategies with geometrically decreasing step sizes.
+    // Scale one step at a time, as the serial linesearch does, so that results
+    // match exactly.
+    const size_t num_trials = std::min(linesearch_candidates_.size(),
+                                       params_.max_backtracking_steps - ii);
+    linesearch_candidates_[0].strategies = *strategies;
+    linesearch_candidates_[0].step_size = current_stepsize;
+    for (size_t jj = 1; jj < num_trials; jj++) {
+      auto& candidate_strategies = linesearch_candidates_[jj].strategies;
+      candidate_strategies = linesearch_candidates_[jj - 1].strategies;
+      ScaleAlphas(params_.geometric_alpha_scaling, &candidate_strategies);
+      linesearch_candidates_[jj].step_size =
+          linesearch_candidates_[jj - 1].step_size *
+          params_.geometric_alpha_scaling;
+    }
+
+    // Roll out and score all candidates, possibly in parallel.
+    ParallelFor(num_trials, [this](size_t jj) {
+      EvaluateLinesearchCandidate(&linesearch_candidates_[jj]);
+    });
+    linesearch_timer_.Toc();
+
+    // Accept the largest step which satisfies the Armijo condition.
+    for (size_t jj = 0; jj < num_trials; jj++) {
+      auto& candidate = linesearch_candidates_[jj];
+      if (CheckArmijoCondition(candidate.merit_function_value,
+                               current_stepsize)) {
+        // Success! Swap in this candidate and complete the quadraticization.
+        strategies->swap(candidate.strategies);
+        current_operating_point->swap(candidate.operating_point);
+        {
+          ScopedPhaseTimer phase("quadraticization",
+                                 &telemetry_.quadraticization_time,
+                                 TraceEvents());
+          ComputeCostQuadraticization(*current_operating_point,
+                                      &cost_quadraticization_);
+        }
+
+        // Update cached terms and check convergence.
+        *has_converged = HasConverged(candidate.merit_function_value);
+        last_merit_function_value_ = candidate.merit_function_value;
+        telemetry_.num_backtracking_steps = ii + jj;
+        telemetry_.merit_function_value = candidate.merit_function_value;
+        telemetry_.step_size = current_stepsize;
+        return true;
+      }
+
+      current_stepsize *= params_.geometric_alpha_scaling;
+    }
+
+    // Continue from the next step after the smallest one in this round.
+    strategies->swap(linesearch_candidates_[num_trials - 1].strategies);
+    ScaleAlphas(params_.geometric_alpha_scaling, strategies);
+  }
+
+  // Output a warning. Solver should revert to last valid operating point.
+  CurrentOperatingPoint(last_operating_point_, *strategies, current_stepsize,
+                        current_operating_point);
+  VLOG(1) << "Exceeded maximum number of backtracking steps.";
+  return false;
+}
+
+void ILQSolver::EvaluateLinesearchCandidate(
+    LinesearchCandidate* candidate) const {
+  CHECK_NOTNULL(candidate);
+
+  CurrentOperatingPoint(last_operating_point_, candidate->strategies,
+                        candidate->step_size, &candidate->delta_x,
+                        &candidate->integration_workspace,
+                        &candidate->operating_point);
+
+  // Compute gradients one (time step, player) pair at a time.
+  const PlayerIndex num_players = problem_->Dynamics()->NumPlayers();
+  for (size_t kk = 0; kk < problem_->NumTimeSteps(); kk++) {
+    for (PlayerIndex ii = 0; ii < num_players; ii++) {
+      ComputeCostGradient(candidate->operating_point, kk, ii,
+                          &candidate->cost_gradients[kk][ii]);
+    }
+  }
+
+  candidate->merit_function_value =
+      MeritFunction(candidate->cost_gradients) +
+      DefectPenalty(candidate->operating_point,
+                    &candidate->integration_workspace, &candidate->delta_x);
+}
+
 bool ILQSolver::CheckArmijoCondition(float current_merit_function_value,
                                      float current_stepsize) const {
   // Adjust total expected decrease.
@@ -362,14 +723,15 @@ bool ILQSolver::CheckArmijoCondition(float current_merit_function_value,
 float ILQSolver::ExpectedDecrease(
     const std::vector<Strategy>& strategies,
     const std::vector<VectorXf>& delta_xs,
-    const std::vector<std::vector<VectorXf>>& costates) const {
+    const std::vector<std::vector<VectorXf>>& costates) {
   float expected_decrease = 0.0;
-  for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
+  for (size_t kk = 0; kk < problem_->NumTimeSteps(); kk++) {
     const auto& lin = linearization_[kk];
 
-    // Separate x expected decrease per step at each time (saves computation).
-    const size_t xdim = problem_->Dynamics()->XDim();
-    VectorXf expected_decrease_x = VectorXf::Zero(xdim);
+    // // Separate x expected decrease per step at each time (saves
+    // // computation).
+    // const size_t xdim = problem_->Dynamics()->XDim();
+    // VectorXf expected_decrease_x = VectorXf::Zero(xdim);
 
     for (PlayerIndex ii = 0; ii < problem_->Dynamics()->NumPlayers(); ii++) {
       const auto& quad = cost_quadraticization_[kk][ii];
@@ -378,10 +740,16 @@ float ILQSolver::ExpectedDecrease(
           strategies[ii].alphas[kk];  // NOTE: could also evaluate delta u on
                                       // delta x to be more precise.
 
-      // Handle control contribution.
-      expected_decrease -=
-          neg_ui.transpose() * quad.control.at(ii).hess *
-          (quad.control.at(ii).grad - lin.Bs[ii].transpose() * costate);
+      // Handle control contribution. Products are stored in preallocated
+      // temporaries to avoid allocating memory. As in the LQ solvers, each
+      // player must have a cost on its own control.
+      CHECK(quad.HasControl(ii))
+          << "Player " << ii << " is missing a control Hessian.";
+      const auto& control_quad = quad.control[ii];
+      control_grads_[ii] = control_quad.grad;
+      control_grads_[ii].noalias() -= lin.Bs[ii].transpose() * costate;
+      control_steps_[ii].noalias() = control_quad.hess * control_grads_[ii];
+      expected_decrease -= neg_ui.dot(control_steps_[ii]);
 
       // // Handle costate contribution (control). Keep this unmultiplied by
       // // costate for efficiency.
@@ -395,7 +763,7 @@ float ILQSolver::ExpectedDecrease(
       //   const auto& last_costate = costates[kk - 1][ii];
 
       //   VectorXf kx = quad.state.grad + last_costate;
-      //   if (kk == time::kNumTimeSteps - 1)
+      //   if (kk == problem_->NumTimeSteps() - 1)
       //     expected_decrease_costate += kx;
       //   else {
       //     kx -= lin.A.transpose() * costate;
@@ -414,21 +782,43 @@ float ILQSolver::ExpectedDecrease(
     //expected_decrease += delta_xs[kk].transpose() * expected_decrease_x;
   }
 
+  // With multiple shooting, a step of size s scales each defect d by (1 - s)
+  // to first order, so the defect penalty decreases at rate |d|^2.
+  for (size_t jj = 1; jj < segment_starts_.size(); jj++)
+    expected_decrease += defects_[jj].squaredNorm();
+
   return expected_decrease;
 }
 
-float ILQSolver::MeritFunction(const OperatingPoint& current_op) {
-  // First, quadraticize cost and linearize dynamics around this operating
-  // point.
-  ComputeCostQuadraticization(current_op, &cost_quadraticization_);
+float ILQSolver::MeritFunction(const OperatingPoint& current_op,
+                               bool full_quadraticization) {
+  // First, quadraticize cost around this operating point (or just compute
+  // gradients, which is all the merit function needs).
+  {
+    ScopedPhaseTimer phase("quadraticization",
+                           &telemetry_.quadraticization_time, TraceEvents());
+    if (full_quadraticization)
+      ComputeCostQuadraticization(current_op, &cost_quadraticization_);
+    else
+      ComputeCostGradients(current_op, &cost_quadraticization_);
+  }
 
-  // Now, accumulate cost gradients (presuming that this operating point is
-  // dynamically feasible so dynamic constraints are all zero).
+  // NOTE: the rollout temporary is free to hold each defect here.
+  return MeritFunction(cost_quadraticization_) +
+         DefectPenalty(current_op, &integration_workspace_, &delta_x_);
+}
+
+float ILQSolver::MeritFunction(
+    const std::vector<std::vector<QuadraticCostApproximation>>& q) const {
+  // Accumulate cost gradients. Dynamic constraints are accounted for
+  // separately, since they are all zero except for the defects between
+  // shooting segments (see `DefectPenalty`).
   float merit = 0.0;
-  for (size_t kk = 0; kk < cost_quadraticization_.size(); kk++) {
+  for (size_t kk = 0; kk < q.size(); kk++) {
     for (PlayerIndex ii = 0; ii < problem_->Dynamics()->NumPlayers(); ii++) {
-      const auto& quad = cost_quadraticization_[kk][ii];
-      merit += quad.control.at(ii).grad.squaredNorm();
+      // Control entries which are absent have zero gradient.
+      const auto& quad = q[kk][ii];
+      if (quad.HasControl(ii)) merit += quad.control[ii].grad.squaredNorm();
 
       if (kk > 0) {
         // Don't accumulate state derivs at t0 since x0 can't change.
@@ -453,10 +843,23 @@ void ILQSolver::ComputeLinearization(
   const auto dyn = static_cast<const MultiPlayerDynamicalSystem*>(
       problem_->Dynamics().get());
 
-  // Populate one timestep at a time.
-  for (size_t kk = 0; kk < op.xs.size(); kk++) {
-    const Time t = RelativeTimeTracker::RelativeTime(kk);
-    (*linearization)[kk] = dyn->Linearize(t, op.xs[kk], op.us[kk]);
+  // Maybe only relinearize time steps which have changed.
+  const bool lazy = IsLazy() && linearization == &linearization_;
+  if (lazy) {
+    num_reused_linearizations_ += FindChangedTimeSteps(
+        op, linearization_reference_, has_linearization_reference_);
+  }
+
+  // Populate one timestep at a time, possibly in parallel.
+  ParallelFor(op.xs.size(), [this, &op, dyn, linearization, lazy](size_t kk) {
+    if (lazy && !changed_time_steps_[kk]) return;
+    dyn->Linearize(op.t0 + problem_->RelativeTime(kk), problem_->TimeStep(kk),
+                   op.xs[kk], op.us[kk], &(*linearization)[kk]);
+  });
+
+  if (lazy) {
+    UpdateReference(op, &linearization_reference_);
+    has_linearization_reference_ = true;
   }
 }
 
@@ -471,27 +874,204 @@ void ILQSolver::ComputeLinearization(
 
   // Populate one timestep at a time.
   for (size_t kk = 0; kk < linearization->size(); kk++)
-    (*linearization)[kk] = dyn.LinearizedSystem();
+    (*linearization)[kk] = dyn.LinearizedSystem(problem_->TimeStep(kk));
 }
 
 void ILQSolver::ComputeCostQuadraticization(
     const OperatingPoint& op,
     std::vector<std::vector<QuadraticCostApproximation>>* q) {
-  for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
-    const Time t = RelativeTimeTracker::RelativeTime(kk);
-    const auto& x = op.xs[kk];
-    const auto& us = op.us[kk];
+  // Maybe only requadraticize time steps which have changed. Costs which are
+  // not time-additive depend on the times of extreme costs as well, so they
+  // are always requadraticized.
+  const bool lazy = IsLazy();
+  if (lazy) {
+    num_reused_quadraticizations_ += FindChangedTimeSteps(
+        op, quadraticization_reference_, has_quadraticization_reference_);
+  }
 
-    // Quadraticize costs.
-    for (PlayerIndex ii = 0; ii < problem_->Dynamics()->NumPlayers(); ii++) {
-      const PlayerCost& cost = problem_->PlayerCosts()[ii];
+  // Quadraticize costs for each (time step, player) pair, possibly in
+  // parallel.
+  const PlayerIndex num_players = problem_->Dynamics()->NumPlayers();
+  ParallelFor(problem_->NumTimeSteps() * num_players,
+              [this, &op, q, num_players, lazy](size_t idx) {
+                const size_t kk = idx / num_players;
+                const PlayerIndex ii = idx % num_players;
+                const Time t = op.t0 + problem_->RelativeTime(kk);
+                const auto& x = op.xs[kk];
+                const auto& us = op.us[kk];
+                const PlayerCost& cost = problem_->PlayerCosts()[ii];
+                const bool cache = lazy && cost.IsTimeAdditive();
+                if (cache && !changed_time_steps_[kk]) {
+                  (*q)[kk][ii] = cached_cost_quadraticization_[kk][ii];
+                  return;
+                }
+
+                if (cost.IsTimeAdditive() || times_of_extreme_costs_[ii] == kk)
+                  cost.Quadraticize(t, x, us, &(*q)[kk][ii]);
+                else
+                  cost.QuadraticizeControlCosts(t, x, us, &(*q)[kk][ii]);
+
+                // Weight time-additive costs by the length of this time step.
+                if (cost.IsTimeAdditive() && !problem_->Grid().IsUniform())
+                  (*q)[kk][ii].Scale(problem_->Grid().CostWeight(kk));
+
+                if (cache) cached_cost_quadraticization_[kk][ii] = (*q)[kk][ii];
+              });
+
+  if (lazy) {
+    UpdateReference(op, &quadraticization_reference_);
+    has_quadraticization_reference_ = true;
+  }
+}
+
+void ILQSolver::ComputeCostGradients(
+    const OperatingPoint& op,
+    std::vector<std::vector<QuadraticCostApproximation>>* q) {
+  // Maybe reuse cached quadraticizations (which include gradients) at time
+  // steps which have not changed since they were computed. These do not
+  // become references, since Hessians are not computed here.
+  const bool lazy = IsLazy();
+  if (lazy) {
+    FindChangedTimeSteps(op, quadraticization_reference_,
+                         has_quadraticization_reference_);
+  }
+
+  // Differentiate costs for each (time step, player) pair, possibly in
+  // parallel.
+  const PlayerIndex num_players = problem_->Dynamics()->NumPlayers();
+  ParallelFor(problem_->NumTimeSteps() * num_players,
+              [this, &op, q, num_players, lazy](size_t idx) {
+                const size_t kk = idx / num_players;
+                const PlayerIndex ii = idx % num_players;
+                if (lazy && !changed_time_steps_[kk] &&
+                    problem_->PlayerCosts()[ii].IsTimeAdditive())
+                  (*q)[kk][ii] = cached_cost_quadraticization_[kk][ii];
+                else
+                  ComputeCostGradient(op, kk, ii, &(*q)[kk][ii]);
+              });
+}
+
+void ILQSolver::ComputeCostGradient(const OperatingPoint& op, size_t kk,
+                                    PlayerIndex ii,
+                                    QuadraticCostApproximation* q) const {
+  const Time t = op.t0 + problem_->RelativeTime(kk);
+  const auto& x = op.xs[kk];
+  const auto& us = op.us[kk];
+  const PlayerCost& cost = problem_->PlayerCosts()[ii];
+
+  if (cost.IsTimeAdditive() || times_of_extreme_costs_[ii] == kk)
+    cost.Differentiate(t, x, us, q);
+  else
+    cost.DifferentiateControlCosts(t, x, us, q);
+
+  // Weight time-additive costs by the length of this time step. Hessians were
+  // not computed, so leave them alone.
+  if (cost.IsTimeAdditive() && !problem_->Grid().IsUniform())
+    q->ScaleGradients(problem_->Grid().CostWeight(kk));
+}
+
+size_t ILQSolver::FindChangedTimeSteps(const OperatingPoint& op,
+                                       const OperatingPoint& reference,
+                                       bool has_reference) {
+  changed_time_steps_.resize(op.xs.size());
+  if (!has_reference || reference.xs.size() != op.xs.size()) {
+    std::fill(changed_time_steps_.begin(), changed_time_steps_.end(), true);
+    return 0;
+  }
+
+  const float tolerance = params_.relinearization_tolerance;
+  size_t num_unchanged = 0;
+  for (size_t kk = 0; kk < op.xs.size(); kk++) {
+    bool changed =
+        (op.xs[kk] - reference.xs[kk]).lpNorm<Eigen::Infinity>() > tolerance;
+    for (PlayerIndex ii = 0; !changed && ii < op.us[kk].size(); ii++) {
+      changed = (op.us[kk][ii] - reference.us[kk][ii])
+                    .lpNorm<Eigen::Infinity>() > tolerance;
+    }
+
+    changed_time_steps_[kk] = changed;
+    if (!changed) num_unchanged++;
+  }
+
+  return num_unchanged;
+}
+
+void ILQSolver::UpdateReference(const OperatingPoint& op,
+                                OperatingPoint* reference) const {
+  CHECK_NOTNULL(reference);
+  if (reference->xs.size() != op.xs.size()) {
+    *reference = op;
+    return;
+  }
 
-      if (cost.IsTimeAdditive() ||
-          problem_->PlayerCosts()[ii].TimeOfExtremeCost() == kk)
-        (*q)[kk][ii] = cost.Quadraticize(t, x, us);
-      else
-        (*q)[kk][ii] = cost.QuadraticizeControlCosts(t, x, us);
+  for (size_t kk = 0; kk < op.xs.size(); kk++) {
+    if (!changed_time_steps_[kk]) continue;
+    reference->xs[kk] = op.xs[kk];
+    reference->us[kk] = op.us[kk];
+  }
+}
+
+float ILQSolver::ComputeDefects(const OperatingPoint& op) {
+  float max_defect = 0.0;
+  for (size_t jj = 1; jj < segment_starts_.size(); jj++) {
+    ComputeDefect(jj, op, &integration_workspace_, &defects_[jj]);
+    max_defect =
+        std::max(max_defect, defects_[jj].lpNorm<Eigen::Infinity>());
+  }
+
+  return max_defect;
+}
+
+void ILQSolver::ComputeDefect(
+    size_t segment, const OperatingPoint& op,
+    MultiPlayerIntegrableSystem::IntegrationWorkspace* integration_workspace,
+    VectorXf* defect) const {
+  CHECK_NOTNULL(integration_workspace);
+  CHECK_NOTNULL(defect);
+  CHECK_GT(segment, 0);
+
+  const size_t kk = segment_starts_[segment] - 1;
+  problem_->Dynamics()->Integrate(op.t0 + problem_->RelativeTime(kk),
+                                  problem_->TimeStep(kk), op.xs[kk], op.us[kk],
+                                  integration_workspace, defect);
+  *defect -= op.xs[kk + 1];
+}
+
+float ILQSolver::DefectPenalty(
+    const OperatingPoint& op,
+    MultiPlayerIntegrableSystem::IntegrationWorkspace* integration_workspace,
+    VectorXf* defect) const {
+  float penalty = 0.0;
+  for (size_t jj = 1; jj < segment_starts_.size(); jj++) {
+    ComputeDefect(jj, op, integration_workspace, defect);
+    penalty += defect->squaredNorm();
+  }
+
+  return 0.5 * penalty;
+}
+
+void ILQSolver::ComputeSegmentSteps(const std::vector<Strategy>& strategies) {
+  // Propagate the change in state along the linearized dynamics,
+  //     dx_{k+1} = A_k dx_k + \sum_i Bs[i]_k du_i + c_k,
+  // where du_i = -P_i dx_k - alpha_i, starting from no change at the initial
+  // state. This is cheap compared to rolling out the nonlinear dynamics.
+  segment_dx_.setZero();
+  size_t next_segment = 1;
+  for (size_t kk = 0; kk + 1 < problem_->NumTimeSteps() &&
+                      next_segment < segment_starts_.size();
+       kk++) {
+    const auto& lin = linearization_[kk];
+    next_segment_dx_.noalias() = lin.A * segment_dx_;
+    for (PlayerIndex ii = 0; ii < problem_->Dynamics()->NumPlayers(); ii++) {
+      segment_dus_[ii] = -strategies[ii].alphas[kk];
+      segment_dus_[ii].noalias() -= strategies[ii].Ps[kk] * segment_dx_;
+      next_segment_dx_.noalias() += lin.Bs[ii] * segment_dus_[ii];
     }
+    if (lin.HasDrift()) next_segment_dx_ += lin.c;
+    segment_dx_.swap(next_segment_dx_);
+
+    if (kk + 1 == segment_starts_[next_segment])
+      segment_steps_[next_segment++] = segment_dx_;
   }
 }
 
@@ -36,12 +36,13 @@
 
 ///////////////////////////////////////////////////////////////////////////////
 //
-// Set the position dimensions of an operating point to follow a given route
-// polyline.
+// Set the position dimensions of an operating point (or of a problem's current
+// solution) to follow a given route polyline.
 //
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <ilqgames/geometry/polyline2.h>
+#include <ilqgames/solver/problem.h>
 #include <ilqgames/utils/initialize_along_route.h>
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/types.h>
@@ -53,7 +54,7 @@
 namespace ilqgames {
 
 void InitializeAlongRoute(const Polyline2& route, float initial_route_pos,
-                          float nominal_speed,
+                          float nominal_speed, Time time_step,
                           const std::pair<Dimension, Dimension>& position_dims,
                           OperatingPoint* operating_point) {
   CHECK_NOTNULL(operating_point);
@@ -62,9 +63,8 @@ void InitializeAlongRoute(const Polyline2& route, float initial_route_pos,
 
   // Loop through each time step and determine where we should be.
   for (size_t kk = 0; kk < operating_point->xs.size(); kk++) {
-    const float route_pos = initial_route_pos + nominal_speed *
-                                                    static_cast<Time>(kk) *
-                                                    time::kTimeStep;
+    const float route_pos =
+        initial_route_pos + nominal_speed * static_cast<Time>(kk) * time_step;
 
     const Point2 route_pt = route.PointAt(route_pos);
     operating_point->xs[kk](position_dims.first) = route_pt.x();
@@ -72,4 +72,24 @@ void InitializeAlongRoute(const Polyline2& route, float initial_route_pos,
   }
 }
 
+void InitializeAlongRoute(const Polyline2& route, float initial_route_pos,
+                          float nominal_speed,
+                          const std::pair<Dimension, Dimension>& position_dims,
+                          Problem* problem) {
+  CHECK_NOTNULL(problem);
+
+  OperatingPoint operating_point = problem->CurrentOperatingPoint();
+  CHECK_EQ(operating_point.xs.size(), problem->NumTimeSteps());
+  for (size_t kk = 0; kk < operating_point.xs.size(); kk++) {
+    const float route_pos =
+        initial_route_pos + nominal_speed * problem->RelativeTime(kk);
+
+    const Point2 route_pt = route.PointAt(route_pos);
+    operating_point.xs[kk](position_dims.first) = route_pt.x();
+    operating_point.xs[kk](position_dims.second) = route_pt.y();
+  }
+
+  problem->OverwriteSolution(operating_point, problem->CurrentStrategies());
+}
+
 }  // namespace ilqgames
@@ -62,12 +62,13 @@ float LocallyConvexProximityCost::Evaluate(const VectorXf& input) const {
 void LocallyConvexProximityCost::Quadraticize(const VectorXf& input,
                                               MatrixXf* hess,
                                               VectorXf* grad) const {
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
 
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Compute Hessian and gradient.
@@ -89,10 +90,12 @@ void LocallyConvexProximityCost::Quadraticize(const VectorXf& input,
     (*grad)(xidx1_) += dx1;
     (*grad)(xidx2_) -= dx1;
 
-    (*hess)(xidx1_, xidx1_) += ddx1;
-    (*hess)(xidx2_, xidx2_) += ddx1;
-    (*hess)(xidx1_, xidx2_) -= ddx1;
-    (*hess)(xidx2_, xidx1_) -= ddx1;
+    if (hess) {
+      (*hess)(xidx1_, xidx1_) += ddx1;
+      (*hess)(xidx2_, xidx2_) += ddx1;
+      (*hess)(xidx1_, xidx2_) -= ddx1;
+      (*hess)(xidx2_, xidx1_) -= ddx1;
+    }
   } else {
     const float dy1 = -weight_ * delta_y;
     const float ddy1 = weight_;
@@ -100,10 +103,12 @@ void LocallyConvexProximityCost::Quadraticize(const VectorXf& input,
     (*grad)(yidx1_) += dy1;
     (*grad)(yidx2_) -= dy1;
 
-    (*hess)(yidx1_, yidx1_) += ddy1;
-    (*hess)(yidx2_, yidx2_) += ddy1;
-    (*hess)(yidx1_, yidx2_) -= ddy1;
-    (*hess)(yidx2_, yidx1_) -= ddy1;
+    if (hess) {
+      (*hess)(yidx1_, yidx1_) += ddy1;
+      (*hess)(yidx2_, yidx2_) += ddy1;
+      (*hess)(yidx1_, yidx2_) -= ddy1;
+      (*hess)(yidx2_, yidx1_) -= ddy1;
+    }
   }
 }
 
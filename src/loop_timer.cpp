@@ -48,7 +48,7 @@
 
 #include <glog/logging.h>
 #include <chrono>
-#include <list>
+#include <vector>
 
 namespace ilqgames {
 
@@ -60,13 +60,14 @@ Time LoopTimer::Toc() {
                             std::chrono::high_resolution_clock::now() - start_))
                            .count();
 
-  // Add to queue and pop if queue is too long.
-  loop_times_.push_back(elapsed);
+  // Add to the window, overwriting the oldest time once it is full.
   total_time_ += elapsed;
-
-  if (loop_times_.size() > max_samples_) {
-    total_time_ -= loop_times_.front();
-    loop_times_.pop_front();
+  if (loop_times_.size() < max_samples_)
+    loop_times_.push_back(elapsed);
+  else {
+    total_time_ -= loop_times_[oldest_];
+    loop_times_[oldest_] = elapsed;
+    oldest_ = (oldest_ + 1) % max_samples_;
   }
 
   return elapsed;
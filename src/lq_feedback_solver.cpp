@@ -37,9 +37,11 @@
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Core LQ game solver from Basar and Olsder, "Preliminary Notation for
-// Corollary 6.1" (pp. 279). All notation matches the text, though we
-// shall assume that `c` (additive drift in dynamics) is always `0`, which
-// holds because these dynamics are for delta x, delta us.
+// Corollary 6.1" (pp. 279). All notation matches the text, though `c`
+// (additive drift in dynamics) is `0` unless the linearization has a drift
+// term, since these dynamics are for delta x, delta us. Drift only arises
+// from defects in operating points which are not dynamically feasible (e.g.,
+// with multiple shooting).
 //
 // Solve a time-varying, finite horizon LQ game (finds closed-loop Nash
 // feedback strategies for both players).
@@ -56,6 +58,18 @@
 //
 // Returns strategies Ps, alphas.
 //
+// If the linearization is block structured (see LinearDynamicsApproximation),
+// products with A and Bs only touch the nonzero blocks. If a state Hessian is
+// sparse (see SingleCostApproximation), only its diagonal and pattern block are
+// added into Z. That only saves one dense add, though; F^T Z F and everything
+// downstream of Z remain dense.
+//
+// The coupled linear system at each time step may be solved by any of the
+// backends in LQSolverBackend (see SolverParams). Each reuses preallocated
+// decompositions so that nothing is allocated inside the backward pass. The LU
+// based backends fall back to Householder QR at any time step where S (or one
+// of its diagonal blocks) is numerically singular.
+//
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <ilqgames/solver/lq_feedback_solver.h>
@@ -68,49 +82,64 @@
 
 namespace ilqgames {
 
-std::vector<Strategy> LQFeedbackSolver::Solve(
+namespace {
+
+// Smallest pivot of an LU decomposition, relative to the largest entry of S,
+// which we trust. Anything smaller means that S (or the block being factored)
+// is singular or too ill-conditioned to solve in single precision.
+static constexpr float kMinRelativePivot = 1e-6;
+
+// Check that all pivots of the given LU decomposition are finite and not too
+// small relative to `scale`. Unlike `rcond()`, this does not allocate.
+bool HasReliablePivots(const Eigen::PartialPivLU<MatrixXf>& lu, float scale) {
+  const auto pivots = lu.matrixLU().diagonal().cwiseAbs();
+  return pivots.allFinite() && pivots.minCoeff() > kMinRelativePivot * scale;
+}
+
+}  // anonymous namespace
+
+void LQFeedbackSolver::Solve(
     const std::vector<LinearDynamicsApproximation>& linearization,
     const std::vector<std::vector<QuadraticCostApproximation>>&
         quadraticization,
-    const VectorXf& x0, std::vector<VectorXf>* delta_xs,
+    const VectorXf& x0, std::vector<Strategy>* strategies,
+    std::vector<VectorXf>* delta_xs,
     std::vector<std::vector<VectorXf>>* costates) {
   CHECK_EQ(linearization.size(), num_time_steps_);
   CHECK_EQ(quadraticization.size(), num_time_steps_);
 
-  // Make sure delta_xs and costates are the right size.
-  if (delta_xs) CHECK_NOTNULL(costates);
-  if (costates) CHECK_NOTNULL(delta_xs);
-  if (delta_xs) {
-    delta_xs->resize(num_time_steps_);
-    costates->resize(num_time_steps_);
-    for (size_t kk = 0; kk < num_time_steps_; kk++) {
-      (*delta_xs)[kk].resize(dynamics_->XDim());
-      (*costates)[kk].resize(dynamics_->NumPlayers());
-      for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
-        (*costates)[kk][ii].resize(dynamics_->XDim());
-    }
-  }
-
-  // List of player-indexed strategies (each of which is a time-indexed
-  // affine state error-feedback controller).
-  std::vector<Strategy> strategies;
-  for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
-    strategies.emplace_back(num_time_steps_, dynamics_->XDim(),
-                            dynamics_->UDim(ii));
+  // Make sure strategies, delta_xs, and costates are the right size.
+  ResizeOutputs(strategies, delta_xs, costates);
 
   // Initialize Zs and zetas at the final time.
   for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
-    Zs_[num_time_steps_ - 1][ii] = quadraticization.back()[ii].state.hess;
-    zetas_[num_time_steps_ - 1][ii] = quadraticization.back()[ii].state.grad;
+    Z(num_time_steps_ - 1, ii) = quadraticization.back()[ii].state.hess;
+    zetas_[num_time_steps_ - 1].col(ii) =
+        quadraticization.back()[ii].state.grad;
   }
 
   // Work backward in time and solve the dynamic program.
   // NOTE: time starts from the second-to-last entry since we'll treat the final
   // entry as a terminal cost as in Basar and Olsder, ch. 6.
+  // NOTE: all products below are written into preallocated temporaries with
+  // `noalias()` so that no memory is allocated inside this loop.
   for (int kk = num_time_steps_ - 2; kk >= 0; kk--) {
     // Unpack linearization and quadraticization at this time step.
     const auto& lin = linearization[kk];
     const auto& quad = quadraticization[kk];
+    const bool is_block_structured = lin.HasBlockStructure();
+
+    // With drift c, each player's value gradient at the next time step is
+    // evaluated at A dx + \sum_i Bs[i] du_i + c, so fold Z c into zeta.
+    const Dimension xdim = dynamics_->XDim();
+    const MatrixXf* next_zeta = &zetas_[kk + 1];
+    if (lin.HasDrift()) {
+      Zbeta_.noalias() = lin.c.transpose() * Zs_[kk + 1];
+      drift_zeta_ = zetas_[kk + 1];
+      drift_zeta_ += Eigen::Map<const MatrixXf>(Zbeta_.data(), xdim,
+                                                dynamics_->NumPlayers());
+      next_zeta = &drift_zeta_;
+    }
 
     // Populate coupling matrix S for linear matrix equation to determine X (Ps
     // and alphas).
@@ -125,7 +154,19 @@ std::vector<Strategy> LQFeedbackSolver::Solve(
       // CHECK(llt.info() != Eigen::NumericalIssue);
 
       // Intermediate variable to store B[ii]' * Z[ii].
-      const MatrixXf BiZi = lin.Bs[ii].transpose() * Zs_[kk + 1][ii];
+      MatrixXf& BiZi = BiZis_[ii];
+      if (is_block_structured) {
+        const Dimension start_dim = lin.x_block_starts[ii];
+        const Dimension xdim = lin.x_block_dims[ii];
+        BiZi.noalias() = lin.Bs[ii].middleRows(start_dim, xdim).transpose() *
+                         Z(kk + 1, ii).middleRows(start_dim, xdim);
+      } else
+        BiZi.noalias() = lin.Bs[ii].transpose() * Z(kk + 1, ii);
+
+      // Does player ii's cost depend upon player ii's control?
+      CHECK(quad[ii].HasControl(ii))
+          << "Player " << ii << " is missing a control Hessian.";
+      const SingleCostApproximation& control_ii = quad[ii].control[ii];
 
       Dimension cumulative_udim_col = 0;
       for (PlayerIndex jj = 0; jj < dynamics_->NumPlayers(); jj++) {
@@ -133,81 +174,144 @@ std::vector<Strategy> LQFeedbackSolver::Solve(
             S_.block(cumulative_udim_row, cumulative_udim_col,
                      dynamics_->UDim(ii), dynamics_->UDim(jj));
 
-        if (ii == jj) {
-          // Does player ii's cost depend upon player jj's control?
-          const auto control_iter = quad[ii].control.find(ii);
-          CHECK(control_iter != quad[ii].control.end())
-              << "Player " << ii << " is missing a control Hessian.";
-
-          S_block = BiZi * lin.Bs[ii] + control_iter->second.hess;
-        } else {
-          S_block = BiZi * lin.Bs[jj];
-        }
+        if (is_block_structured) {
+          const Dimension start_dim = lin.x_block_starts[jj];
+          const Dimension xdim = lin.x_block_dims[jj];
+          S_block.noalias() = BiZi.middleCols(start_dim, xdim) *
+                              lin.Bs[jj].middleRows(start_dim, xdim);
+        } else
+          S_block.noalias() = BiZi * lin.Bs[jj];
+        if (ii == jj) S_block += control_ii.hess;
 
         // Increment cumulative_udim_col.
         cumulative_udim_col += dynamics_->UDim(jj);
       }
 
       // Set appropriate blocks of Y.
-      Y_.block(cumulative_udim_row, 0, dynamics_->UDim(ii), dynamics_->XDim()) =
-          BiZi * lin.A;
-      Y_.col(dynamics_->XDim())
-          .segment(cumulative_udim_row, dynamics_->UDim(ii)) =
-          lin.Bs[ii].transpose() * zetas_[kk + 1][ii] +
-          quad[ii].control.at(ii).grad;
+      auto Y_P_block = Y_.block(cumulative_udim_row, 0, dynamics_->UDim(ii),
+                                dynamics_->XDim());
+      auto Y_alpha_block =
+          Y_.col(dynamics_->XDim())
+              .segment(cumulative_udim_row, dynamics_->UDim(ii));
+      if (is_block_structured) {
+        for (PlayerIndex jj = 0; jj < dynamics_->NumPlayers(); jj++) {
+          const Dimension start_dim = lin.x_block_starts[jj];
+          const Dimension xdim = lin.x_block_dims[jj];
+          Y_P_block.middleCols(start_dim, xdim).noalias() =
+              BiZi.middleCols(start_dim, xdim) *
+              lin.A.block(start_dim, start_dim, xdim, xdim);
+        }
+
+        const Dimension start_dim = lin.x_block_starts[ii];
+        const Dimension xdim = lin.x_block_dims[ii];
+        Y_alpha_block.noalias() =
+            lin.Bs[ii].middleRows(start_dim, xdim).transpose() *
+            next_zeta->col(ii).segment(start_dim, xdim);
+      } else {
+        Y_P_block.noalias() = BiZi * lin.A;
+        Y_alpha_block.noalias() = lin.Bs[ii].transpose() * next_zeta->col(ii);
+      }
+      Y_alpha_block += control_ii.grad;
 
       // Increment cumulative_udim_row.
       cumulative_udim_row += dynamics_->UDim(ii);
     }
 
     // Solve linear matrix equality S X = Y.
-    // NOTE: not 100% sure that this avoids dynamic memory allocation.
-    X_ = S_.householderQr().solve(Y_);
+    SolveCoupledSystem();
 
     // Set strategy at current time step.
     for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
-      strategies[ii].Ps[kk] = Ps_[ii];
-      strategies[ii].alphas[kk] = alphas_[ii];
+      (*strategies)[ii].Ps[kk] = Ps_[ii];
+      (*strategies)[ii].alphas[kk] = alphas_[ii];
     }
 
-    // Compute F and beta.
+    // Compute F and beta. If block structured, player ii's control only
+    // affects player ii's rows.
     F_ = lin.A;
-    beta_ = VectorXf::Zero(dynamics_->XDim());
+    beta_.setZero();
     for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
-      F_ -= lin.Bs[ii] * Ps_[ii];
-      beta_ -= lin.Bs[ii] * alphas_[ii];
+      if (is_block_structured) {
+        const Dimension start_dim = lin.x_block_starts[ii];
+        const Dimension xdim = lin.x_block_dims[ii];
+        const auto Bi = lin.Bs[ii].middleRows(start_dim, xdim);
+        F_.middleRows(start_dim, xdim).noalias() -= Bi * Ps_[ii];
+        beta_.segment(start_dim, xdim).noalias() -= Bi * alphas_[ii];
+      } else {
+        F_.noalias() -= lin.Bs[ii] * Ps_[ii];
+        beta_.noalias() -= lin.Bs[ii] * alphas_[ii];
+      }
     }
+    if (lin.HasDrift()) beta_ += lin.c;
+
+    // Update Zs and zetas. Products with F are batched across players, and
+    // since each Z is symmetric only its lower triangle is accumulated and
+    // then mirrored into the upper triangle.
+    // NOTE: Z beta = (beta^T Z)^T since Z is symmetric, so stacking beta^T Z
+    // for all players gives all the Z beta's side by side.
+    Zbeta_.noalias() = beta_.transpose() * Zs_[kk + 1];
+    zeta_ = zetas_[kk + 1];
+    zeta_ += Eigen::Map<const MatrixXf>(Zbeta_.data(), xdim,
+                                        dynamics_->NumPlayers());
+    for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
+      zetas_[kk].col(ii) = quad[ii].state.grad;
+    zetas_[kk].noalias() += F_.transpose() * zeta_;
 
-    // Update Zs and zetas.
+    FZ_.noalias() = F_.transpose() * Zs_[kk + 1];
     for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
-      zetas_[kk][ii] =
-          (F_.transpose() * (zetas_[kk + 1][ii] + Zs_[kk + 1][ii] * beta_) +
-           quad[ii].state.grad)
-              .eval();
-      Zs_[kk][ii] =
-          (F_.transpose() * Zs_[kk + 1][ii] * F_ + quad[ii].state.hess).eval();
+      auto Zi = Z(kk, ii);
+      auto Zi_lower = Zi.triangularView<Eigen::Lower>();
+      const auto FZi = FZ_.middleCols(ii * xdim, xdim);
+      const SingleCostApproximation& state_ii = quad[ii].state;
+      if (state_ii.is_hess_sparse) {
+        Zi_lower = FZi * F_;
+        Zi.diagonal() += state_ii.hess.diagonal();
+        for (const Dimension dim1 : state_ii.hess_dims) {
+          for (const Dimension dim2 : state_ii.hess_dims) {
+            if (dim1 > dim2) Zi(dim1, dim2) += state_ii.hess(dim1, dim2);
+          }
+        }
+      } else {
+        Zi_lower = state_ii.hess;
+        Zi_lower += FZi * F_;
+      }
 
       // Add terms for nonzero Rijs.
-      for (const auto& Rij_entry : quad[ii].control) {
-        const PlayerIndex jj = Rij_entry.first;
-        const MatrixXf& Rij = Rij_entry.second.hess;
-        const VectorXf& rij = Rij_entry.second.grad;
-        zetas_[kk][ii] += Ps_[jj].transpose() * (Rij * alphas_[jj] - rij);
-        Zs_[kk][ii] += Ps_[jj].transpose() * Rij * Ps_[jj];
+      for (PlayerIndex jj = 0; jj < dynamics_->NumPlayers(); jj++) {
+        if (!quad[ii].HasControl(jj)) continue;
+
+        const MatrixXf& Rij = quad[ii].control[jj].hess;
+        const VectorXf& rij = quad[ii].control[jj].grad;
+
+        us_[jj].noalias() = Rij * alphas_[jj];
+        us_[jj] -= rij;
+        zetas_[kk].col(ii).noalias() += Ps_[jj].transpose() * us_[jj];
+
+        RPs_[jj].noalias() = Rij.selfadjointView<Eigen::Lower>() * Ps_[jj];
+        Zi_lower += Ps_[jj].transpose() * RPs_[jj];
       }
+
+      Zi.triangularView<Eigen::StrictlyUpper>() = Zi.transpose();
     }
   }
 
-  // Maybe compute delta_xs and costates forward in time.
-  VectorXf x_star = x0;
-  VectorXf last_x_star;
+  // Maybe compute delta_xs and costates forward in time, either in parallel in
+  // time or sequentially.
+  if (IsParallelInTime()) {
+    if (delta_xs) ParallelForwardPass(linearization, *strategies, x0, delta_xs,
+                                      costates);
+    return;
+  }
+
+  x_star_ = x0;
   for (size_t kk = 0; kk < num_time_steps_; kk++) {
     if (delta_xs) {
-      (*delta_xs)[kk] = x_star;
+      (*delta_xs)[kk] = x_star_;
       for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
-        if (kk < num_time_steps_ - 1)
-          (*costates)[kk][ii] = Zs_[kk + 1][ii] * x_star + zetas_[kk + 1][ii];
-        else
+        if (kk < num_time_steps_ - 1) {
+          (*costates)[kk][ii] = zetas_[kk + 1].col(ii);
+          (*costates)[kk][ii].noalias() += Z(kk + 1, ii) * x_star_;
+        } else
           (*costates)[kk][ii].setZero();
       }
     }
@@ -216,13 +320,170 @@ std::vector<Strategy> LQFeedbackSolver::Solve(
     const auto& lin = linearization[kk];
 
     // Compute optimal x.
-    last_x_star = x_star;
-    x_star = lin.A * last_x_star;
+    last_x_star_ = x_star_;
+    if (lin.HasBlockStructure()) {
+      for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
+        const Dimension start_dim = lin.x_block_starts[ii];
+        const Dimension xdim = lin.x_block_dims[ii];
+        auto x_star_block = x_star_.segment(start_dim, xdim);
+        x_star_block.noalias() =
+            lin.A.block(start_dim, start_dim, xdim, xdim) *
+            last_x_star_.segment(start_dim, xdim);
+        x_star_block.noalias() -= lin.Bs[ii].middleRows(start_dim, xdim) *
+                                  (*strategies)[ii].alphas[kk];
+      }
+    } else {
+      x_star_.noalias() = lin.A * last_x_star_;
+      for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
+        x_star_.noalias() -= lin.Bs[ii] * (*strategies)[ii].alphas[kk];
+    }
+    if (lin.HasDrift()) x_star_ += lin.c;
+  }
+}
+
+void LQFeedbackSolver::ParallelForwardPass(
+    const std::vector<LinearDynamicsApproximation>& linearization,
+    const std::vector<Strategy>& strategies, const VectorXf& x0,
+    std::vector<VectorXf>* delta_xs,
+    std::vector<std::vector<VectorXf>>* costates) {
+  CHECK_NOTNULL(delta_xs);
+  CHECK_NOTNULL(costates);
+
+  // Optimal delta xs follow dx_{k+1} = A_k dx_k - \sum_i Bs[i]_k alpha[i]_k,
+  // plus drift if any.
+  ParallelFor(num_time_steps_ - 1, [&](size_t kk) {
+    const auto& lin = linearization[kk];
+    forward_Fs_[kk] = lin.A;
+    forward_fs_[kk].setZero();
     for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
-      x_star -= lin.Bs[ii] * strategies[ii].alphas[kk];
+      forward_fs_[kk].noalias() -= lin.Bs[ii] * strategies[ii].alphas[kk];
+    if (lin.HasDrift()) forward_fs_[kk] += lin.c;
+  });
+
+  RollOutForwardPass(x0);
+
+  // Costates only depend upon the delta x at the same time step.
+  ParallelFor(num_time_steps_, [&](size_t kk) {
+    (*delta_xs)[kk] = forward_xs_[kk];
+    for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
+      if (kk < num_time_steps_ - 1) {
+        (*costates)[kk][ii] = zetas_[kk + 1].col(ii);
+        (*costates)[kk][ii].noalias() += Z(kk + 1, ii) * forward_xs_[kk];
+      } else
+        (*costates)[kk][ii].setZero();
+    }
+  });
+}
+
+void LQFeedbackSolver::SolveCoupledSystem() {
+  switch (backend_) {
+    case HOUSEHOLDER_QR:
+      SolveCoupledSystemQR();
+      break;
+    case PARTIAL_PIV_LU:
+      SolveCoupledSystemLU();
+      break;
+    case BLOCK_SCHUR:
+      SolveCoupledSystemBlockSchur();
+      break;
+    default:
+      LOG(FATAL) << "Unknown LQ solver backend: " << backend_;
+  }
+}
+
+void LQFeedbackSolver::SolveCoupledSystemQR() {
+  // This is exactly what `S_.householderQr().solve(Y_)` does, but reuses the
+  // decomposition and a preallocated workspace rather than allocating copies of
+  // S and Y.
+  qr_.compute(S_);
+  X_ = Y_;
+  qr_.householderQ()
+      .setLength(S_.cols())
+      .adjoint()
+      .applyThisOnTheLeft(X_, qr_workspace_);
+  qr_.matrixQR().triangularView<Eigen::Upper>().solveInPlace(X_);
+}
+
+void LQFeedbackSolver::SolveCoupledSystemLU() {
+  // Equivalent to `S_.partialPivLu().solve(Y_)`, without allocating.
+  lu_.compute(S_);
+  if (!HasReliablePivots(lu_, S_.cwiseAbs().maxCoeff())) {
+    SolveCoupledSystemQR();
+    return;
   }
 
-  return strategies;
+  X_.noalias() = lu_.permutationP() * Y_;
+  lu_.matrixLU().triangularView<Eigen::UnitLower>().solveInPlace(X_);
+  lu_.matrixLU().triangularView<Eigen::Upper>().solveInPlace(X_);
+}
+
+void LQFeedbackSolver::SolveCoupledSystemBlockSchur() {
+  // Forward elimination. At step ii, the remaining rows and columns of S form
+  // the Schur complement of the blocks for players 0 through ii - 1. Normalize
+  // player ii's block row by its diagonal block (so that it reads
+  // [I, S_ii^{-1} S_ij, S_ii^{-1} Y_i]) and eliminate it from all later rows.
+  // Since this overwrites S and Y, keep copies in case some diagonal block
+  // turns out to be singular and we have to fall back to QR.
+  S_copy_ = S_;
+  Y_copy_ = Y_;
+  const float scale = S_.cwiseAbs().maxCoeff();
+  const Dimension total_udim = S_.rows();
+  Dimension cumulative_udim = 0;
+  for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
+    const Dimension udim = dynamics_->UDim(ii);
+    const Dimension next_udim = cumulative_udim + udim;
+    const Dimension remaining_udim = total_udim - next_udim;
+
+    auto& lu = block_lus_[ii];
+    lu.compute(S_.block(cumulative_udim, cumulative_udim, udim, udim));
+    if (!HasReliablePivots(lu, scale)) {
+      S_ = S_copy_;
+      Y_ = Y_copy_;
+      SolveCoupledSystemQR();
+      return;
+    }
+
+    // Apply S_ii^{-1} to the rest of this block row of S and to Y.
+    auto apply_inverse = [&lu, this](Eigen::Ref<MatrixXf> rhs) {
+      auto workspace = schur_workspace_.topLeftCorner(rhs.rows(), rhs.cols());
+      workspace = rhs;
+      rhs.noalias() = lu.permutationP() * workspace;
+      lu.matrixLU().triangularView<Eigen::UnitLower>().solveInPlace(rhs);
+      lu.matrixLU().triangularView<Eigen::Upper>().solveInPlace(rhs);
+    };
+
+    auto S_row = S_.block(cumulative_udim, next_udim, udim, remaining_udim);
+    auto Y_row = Y_.middleRows(cumulative_udim, udim);
+    apply_inverse(S_row);
+    apply_inverse(Y_row);
+
+    // Eliminate this player from all later rows.
+    if (remaining_udim > 0) {
+      const auto S_col =
+          S_.block(next_udim, cumulative_udim, remaining_udim, udim);
+      S_.bottomRightCorner(remaining_udim, remaining_udim).noalias() -=
+          S_col * S_row;
+      Y_.bottomRows(remaining_udim).noalias() -= S_col * Y_row;
+    }
+
+    cumulative_udim = next_udim;
+  }
+
+  // Back substitution, from the last player to the first.
+  for (int ii = dynamics_->NumPlayers() - 1; ii >= 0; ii--) {
+    const Dimension udim = dynamics_->UDim(ii);
+    cumulative_udim -= udim;
+    const Dimension next_udim = cumulative_udim + udim;
+    const Dimension remaining_udim = total_udim - next_udim;
+
+    auto X_row = X_.middleRows(cumulative_udim, udim);
+    X_row = Y_.middleRows(cumulative_udim, udim);
+    if (remaining_udim > 0) {
+      X_row.noalias() -=
+          S_.block(cumulative_udim, next_udim, udim, remaining_udim) *
+          X_.bottomRows(remaining_udim);
+    }
+  }
 }
 
 }  // namespace ilqgames
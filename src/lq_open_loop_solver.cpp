@@ -37,10 +37,12 @@
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Core open-loop LQ game solver based on Basar and Olsder, Chapter 6. All
-// notation matches the text, though we shall assume that `c` (additive drift in
-// dynamics) is always `0`, which holds because these dynamics are for delta x,
-// delta us. Also, we have modified terms slightly to account for linear terms
-// in the stage cost for control, i.e.
+// notation matches the text, though `c` (additive drift in dynamics) is `0`
+// unless the linearization has a drift term, since these dynamics are for
+// delta x, delta us. Drift only arises from defects in operating points which
+// are not dynamically feasible (e.g., with multiple shooting). Also, we have
+// modified terms slightly to account for linear terms in the stage cost for
+// control, i.e.
 //       control penalty i = 0.5 \sum_j du_j^T R_ij (du_j + 2 r_ij)
 //
 // Solve a time-varying, finite horizon LQ game (finds open-loop Nash
@@ -70,36 +72,25 @@
 
 namespace ilqgames {
 
-std::vector<Strategy> LQOpenLoopSolver::Solve(
+void LQOpenLoopSolver::Solve(
     const std::vector<LinearDynamicsApproximation>& linearization,
     const std::vector<std::vector<QuadraticCostApproximation>>&
         quadraticization,
-    const VectorXf& x0, std::vector<VectorXf>* delta_xs,
+    const VectorXf& x0, std::vector<Strategy>* strategies,
+    std::vector<VectorXf>* delta_xs,
     std::vector<std::vector<VectorXf>>* costates) {
   CHECK_EQ(linearization.size(), num_time_steps_);
   CHECK_EQ(quadraticization.size(), num_time_steps_);
 
-  // Make sure delta_xs and costates are the right size.
-  if (delta_xs) CHECK_NOTNULL(costates);
-  if (costates) CHECK_NOTNULL(delta_xs);
-  if (delta_xs) {
-    delta_xs->resize(num_time_steps_);
-    costates->resize(num_time_steps_);
-    for (size_t kk = 0; kk < num_time_steps_; kk++) {
-      (*delta_xs)[kk].resize(dynamics_->XDim());
-      (*costates)[kk].resize(dynamics_->NumPlayers());
-      for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
-        (*costates)[kk][ii].resize(dynamics_->XDim());
-    }
-  }
+  // Make sure strategies, delta_xs, and costates are the right size.
+  ResizeOutputs(strategies, delta_xs, costates);
 
-  // List of player-indexed strategies (each of which is a time-indexed
-  // affine state error-feedback controller). Since this is an open-loop
-  // strategy, we will not change the default zero value of the P matrix.
-  std::vector<Strategy> strategies;
-  for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
-    strategies.emplace_back(num_time_steps_, dynamics_->XDim(),
-                            dynamics_->UDim(ii));
+  // Since this is an open-loop strategy, all the P matrices are zero, as is the
+  // final alpha (which is never set below).
+  for (auto& strategy : *strategies) {
+    for (auto& P : strategy.Ps) P.setZero();
+    strategy.alphas.back().setZero();
+  }
 
   // Initialize m^i and M^i and index first by time and then by player.
   for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
@@ -118,20 +109,24 @@ std::vector<Strategy> LQOpenLoopSolver::Solve(
     // Campute capital lambdas.
     capital_lambdas_[kk].setIdentity();
     for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
-      const auto control_iter = quad[ii].control.find(ii);
-      CHECK(control_iter != quad[ii].control.end());
+      CHECK(quad[ii].HasControl(ii));
+      const SingleCostApproximation& control_ii = quad[ii].control[ii];
 
-      chol_Rs_[kk][ii].compute(control_iter->second.hess);
+      chol_Rs_[kk][ii].compute(control_ii.hess);
       warped_Bs_[kk][ii] = chol_Rs_[kk][ii].solve(lin.Bs[ii].transpose());
-      warped_rs_[kk][ii] = chol_Rs_[kk][ii].solve(control_iter->second.grad);
+      warped_rs_[kk][ii] = chol_Rs_[kk][ii].solve(control_ii.grad);
       capital_lambdas_[kk] += lin.Bs[ii] * warped_Bs_[kk][ii] * Ms_[kk + 1][ii];
     }
 
     // Compute inv(capital lambda).
     qr_capital_lambdas_[kk].compute(capital_lambdas_[kk]);
 
-    // Compute Ms and ms.
-    intermediate_terms_[kk].setZero();
+    // Compute Ms and ms. Drift enters the dynamics exactly like the
+    // intermediate terms.
+    if (lin.HasDrift())
+      intermediate_terms_[kk] = lin.c;
+    else
+      intermediate_terms_[kk].setZero();
     for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
       intermediate_terms_[kk] -=
           lin.Bs[ii] *
@@ -150,7 +145,13 @@ std::vector<Strategy> LQOpenLoopSolver::Solve(
     }
   }
 
-  // (2) Now compute optimal state and control trajectory forward in time.
+  // (2) Now compute optimal state and control trajectory forward in time,
+  // either in parallel in time or sequentially.
+  if (IsParallelInTime()) {
+    ParallelForwardPass(linearization, x0, strategies, delta_xs, costates);
+    return;
+  }
+
   VectorXf x_star = x0;
   VectorXf last_x_star;
   for (size_t kk = 0; kk < num_time_steps_ - 1; kk++) {
@@ -170,7 +171,7 @@ std::vector<Strategy> LQOpenLoopSolver::Solve(
     for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
       const VectorXf intermediate_term =
           Ms_[kk + 1][ii] * x_star + ms_[kk + 1][ii];
-      strategies[ii].alphas[kk] =
+      (*strategies)[ii].alphas[kk] =
           warped_Bs_[kk][ii] * intermediate_term + warped_rs_[kk][ii];
 
       if (costates) (*costates)[kk][ii] = lin.A.transpose() * intermediate_term;
@@ -179,7 +180,7 @@ std::vector<Strategy> LQOpenLoopSolver::Solve(
     // Check dynamic feasibility.
     // VectorXf check_x = lin.A * last_x_star;
     // for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
-    //   check_x -= lin.Bs[ii] * strategies[ii].alphas[kk];
+    //   check_x -= lin.Bs[ii] * (*strategies)[ii].alphas[kk];
 
     // CHECK_LE((x_star - check_x).cwiseAbs().maxCoeff(), 1e-1);
   }
@@ -190,8 +191,42 @@ std::vector<Strategy> LQOpenLoopSolver::Solve(
     for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
       costates->back()[ii].setZero();
   }
+}
 
-  return strategies;
+void LQOpenLoopSolver::ParallelForwardPass(
+    const std::vector<LinearDynamicsApproximation>& linearization,
+    const VectorXf& x0, std::vector<Strategy>* strategies,
+    std::vector<VectorXf>* delta_xs,
+    std::vector<std::vector<VectorXf>>* costates) {
+  // Optimal xs follow x_{k+1} = Lambda_k^{-1} (A_k x_k + intermediate_k).
+  ParallelFor(num_time_steps_ - 1, [&](size_t kk) {
+    forward_Fs_[kk] = qr_capital_lambdas_[kk].solve(linearization[kk].A);
+    forward_fs_[kk] = qr_capital_lambdas_[kk].solve(intermediate_terms_[kk]);
+  });
+
+  RollOutForwardPass(x0);
+
+  // Optimal us and costates only depend upon the next x.
+  ParallelFor(num_time_steps_ - 1, [&](size_t kk) {
+    if (delta_xs) (*delta_xs)[kk] = forward_xs_[kk];
+
+    const auto& lin = linearization[kk];
+    for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
+      const VectorXf intermediate_term =
+          Ms_[kk + 1][ii] * forward_xs_[kk + 1] + ms_[kk + 1][ii];
+      (*strategies)[ii].alphas[kk] =
+          warped_Bs_[kk][ii] * intermediate_term + warped_rs_[kk][ii];
+
+      if (costates) (*costates)[kk][ii] = lin.A.transpose() * intermediate_term;
+    }
+  });
+
+  // Set delta_x and costate for last time step.
+  if (delta_xs) {
+    delta_xs->back() = forward_xs_.back();
+    for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
+      costates->back()[ii].setZero();
+  }
 }
 
 }  // namespace ilqgames
@@ -75,11 +75,14 @@ std::vector<ActiveProblem> MinimallyInvasiveRecedingHorizonSimulator(
   CHECK_NOTNULL(original_logs);
   CHECK_NOTNULL(safety_logs);
 
-  // Make sure the two problems have the same initial condition and time.
+  // Make sure the two problems have the same initial condition and time, and
+  // the same time discretization.
   CHECK(original->GetProblem().InitialState().isApprox(
       safety->GetProblem().InitialState(), constants::kSmallNumber));
   CHECK_NEAR(original->GetProblem().InitialTime(),
              safety->GetProblem().InitialTime(), constants::kSmallNumber);
+  CHECK_NEAR(original->GetProblem().TimeStep(),
+             safety->GetProblem().TimeStep(), constants::kSmallNumber);
 
   // Unpack dynamics, and ensure that the two problems actually share the same
   // dynamics object type.
@@ -130,11 +133,10 @@ std::vector<ActiveProblem> MinimallyInvasiveRecedingHorizonSimulator(
     t += kExtraTime;  // + planner_runtime;
 
     if (t >= final_time ||
-        !splicer.ContainsTime(t + planner_runtime +
-                              time::kTimeStep))
+        !splicer.ContainsTime(t + planner_runtime + splicer.TimeStep()))
       break;
 
-    x = dynamics.Integrate(t - kExtraTime, t, x,
+    x = dynamics.Integrate(t - kExtraTime, t, splicer.Grid(), x,
                            splicer.CurrentOperatingPoint(),
                            splicer.CurrentStrategies());
 
@@ -146,9 +148,11 @@ std::vector<ActiveProblem> MinimallyInvasiveRecedingHorizonSimulator(
 
     // Make sure both problems have the current solution from the splicer.
     original->GetProblem().OverwriteSolution(splicer.CurrentOperatingPoint(),
-                                             splicer.CurrentStrategies());
+                                             splicer.CurrentStrategies(),
+                                             splicer.Grid());
     safety->GetProblem().OverwriteSolution(splicer.CurrentOperatingPoint(),
-                                           splicer.CurrentStrategies());
+                                           splicer.CurrentStrategies(),
+                                           splicer.Grid());
 
     // Make sure both problems have the active problem's initial state.
     original->GetProblem().ResetInitialState(
@@ -166,7 +170,8 @@ std::vector<ActiveProblem> MinimallyInvasiveRecedingHorizonSimulator(
     const Time original_elapsed_time =
         std::chrono::duration<Time>(clock::now() - solver_call_time).count();
 
-    CHECK_LE(original_elapsed_time, planner_runtime);
+    LOG_IF(WARNING, original_elapsed_time > planner_runtime)
+        << "t = " << t << ": Original planner overran its runtime.";
     VLOG(1) << "t = " << t << ": Solved warm-started original problem in "
             << original_elapsed_time << " seconds.";
 
@@ -175,7 +180,8 @@ std::vector<ActiveProblem> MinimallyInvasiveRecedingHorizonSimulator(
     const Time safety_elapsed_time =
         std::chrono::duration<Time>(clock::now() - solver_call_time).count();
 
-    CHECK_LE(safety_elapsed_time, planner_runtime);
+    LOG_IF(WARNING, safety_elapsed_time > planner_runtime)
+        << "t = " << t << ": Safety planner overran its runtime.";
     VLOG(1) << "t = " << t << ": Solved warm-started safety problem in "
             << safety_elapsed_time << " seconds.";
 
@@ -185,7 +191,7 @@ std::vector<ActiveProblem> MinimallyInvasiveRecedingHorizonSimulator(
     if (t >= final_time || !splicer.ContainsTime(t)) break;
 
     // Integrate dynamics forward to account for solve time.
-    x = dynamics.Integrate(t - elapsed_time, t, x,
+    x = dynamics.Integrate(t - elapsed_time, t, splicer.Grid(), x,
                            splicer.CurrentOperatingPoint(),
                            splicer.CurrentStrategies());
 
@@ -205,12 +211,15 @@ std::vector<ActiveProblem> MinimallyInvasiveRecedingHorizonSimulator(
         (safety_logs->back()->WasConverged() &&
          !original_logs->back()->WasConverged())) {
       active_problem.push_back(ActiveProblem::SAFETY);
-      splicer.Splice(*safety_logs->back());
+      splicer.Splice(*safety_logs->back(), t);
       VLOG(2) << "Using safety controller.";
     } else {
       active_problem.push_back(ActiveProblem::ORIGINAL);
-      if (original_logs->back()->WasConverged())
-        splicer.Splice(*original_logs->back());
+
+      // As in `RecedingHorizonSimulator`, splice in the new solution if it
+      // improved upon the warm start.
+      if (original_logs->back()->Quality() != NOT_IMPROVED)
+        splicer.Splice(*original_logs->back(), t);
     }
   }
 
@@ -52,28 +52,64 @@ namespace ilqgames {
 VectorXf MultiPlayerDynamicalSystem::Integrate(
     Time t0, Time time_interval, const VectorXf& x0,
     const std::vector<VectorXf>& us) const {
-  VectorXf x(x0);
+  if (integrate_using_euler_) return IntegrateEuler(t0, time_interval, x0, us);
 
+  IntegrationWorkspace workspace;
+  VectorXf x;
+  Integrate(t0, time_interval, x0, us, &workspace, &x);
+  return x;
+}
+
+void MultiPlayerDynamicalSystem::Integrate(Time t0, Time time_interval,
+                                           const VectorXf& x0,
+                                           const std::vector<VectorXf>& us,
+                                           IntegrationWorkspace* workspace,
+                                           VectorXf* x) const {
+  CHECK_NOTNULL(workspace);
+  CHECK_NOTNULL(x);
+
+  // Single forward Euler step. Evaluate before writing to x in case x and x0
+  // are aliased.
   if (integrate_using_euler_) {
-    x += time_interval * Evaluate(t0, x0, us);
-  } else {
-    // Number of integration steps and corresponding time step.
-    constexpr size_t kNumIntegrationSteps = 2;
-    const double dt = time_interval / static_cast<Time>(kNumIntegrationSteps);
-
-    // RK4 integration. See https://en.wikipedia.org/wiki/Runge-Kutta_methods
-    // for further details.
-    for (Time t = t0; t < t0 + time_interval - 0.5 * dt; t += dt) {
-      const VectorXf k1 = dt * Evaluate(t, x, us);
-      const VectorXf k2 = dt * Evaluate(t + 0.5 * dt, x + 0.5 * k1, us);
-      const VectorXf k3 = dt * Evaluate(t + 0.5 * dt, x + 0.5 * k2, us);
-      const VectorXf k4 = dt * Evaluate(t + dt, x + k3, us);
-
-      x += (k1 + 2.0 * (k2 + k3) + k4) / 6.0;
-    }
+    Evaluate(t0, x0, us, &workspace->k1);
+    *x = x0 + time_interval * workspace->k1;
+    return;
   }
 
-  return x;
+  // Number of integration steps and corresponding time step.
+  constexpr size_t kNumIntegrationSteps = 2;
+  const double dt = time_interval / static_cast<Time>(kNumIntegrationSteps);
+
+  // RK4 integration. See https://en.wikipedia.org/wiki/Runge-Kutta_methods
+  // for further details.
+  VectorXf& x_current = workspace->x;
+  VectorXf& x_stage = workspace->x_stage;
+  VectorXf& k1 = workspace->k1;
+  VectorXf& k2 = workspace->k2;
+  VectorXf& k3 = workspace->k3;
+  VectorXf& k4 = workspace->k4;
+
+  x_current = x0;
+  for (Time t = t0; t < t0 + time_interval - 0.5 * dt; t += dt) {
+    Evaluate(t, x_current, us, &k1);
+    k1 *= dt;
+
+    x_stage = x_current + 0.5 * k1;
+    Evaluate(t + 0.5 * dt, x_stage, us, &k2);
+    k2 *= dt;
+
+    x_stage = x_current + 0.5 * k2;
+    Evaluate(t + 0.5 * dt, x_stage, us, &k3);
+    k3 *= dt;
+
+    x_stage = x_current + k3;
+    Evaluate(t + dt, x_stage, us, &k4);
+    k4 *= dt;
+
+    x_current += (k1 + 2.0 * (k2 + k3) + k4) / 6.0;
+  }
+
+  *x = x_current;
 }
 
 }  // namespace ilqgames
@@ -44,16 +44,16 @@
 #include <ilqgames/dynamics/multi_player_integrable_system.h>
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <vector>
 
 namespace ilqgames {
 
-bool MultiPlayerIntegrableSystem::integrate_using_euler_ = false;
-
 VectorXf MultiPlayerIntegrableSystem::Integrate(
-    Time t0, Time t, const VectorXf& x0, const OperatingPoint& operating_point,
+    Time t0, Time t, const TimeGrid& time_grid, const VectorXf& x0,
+    const OperatingPoint& operating_point,
     const std::vector<Strategy>& strategies) const {
   CHECK_GE(t, t0);
   CHECK_GE(t0, operating_point.t0);
@@ -63,65 +63,66 @@ VectorXf MultiPlayerIntegrableSystem::Integrate(
 
   // Compute current timestep and final timestep.
   const Time relative_t0 = t0 - operating_point.t0;
-  const size_t current_timestep =
-      static_cast<size_t>(relative_t0 / time::kTimeStep);
+  const size_t current_timestep = time_grid.Index(relative_t0);
 
   const Time relative_t = t - operating_point.t0;
-  const size_t final_timestep =
-      static_cast<size_t>(relative_t / time::kTimeStep);
+  const size_t final_timestep = time_grid.Index(relative_t);
 
   // Handle case where 't0' is after 'operating_point.t0' by integrating from
   // 't0' to the next discrete timestep.
   VectorXf x(x0);
   if (t0 > operating_point.t0)
-    x = IntegrateToNextTimeStep(t0, x0, operating_point, strategies);
+    x = IntegrateToNextTimeStep(t0, time_grid, x0, operating_point,
+                                strategies);
 
   // Integrate forward step by step up to timestep including t.
-  x = Integrate(current_timestep + 1, final_timestep, x, operating_point,
-                strategies);
+  x = Integrate(current_timestep + 1, final_timestep, time_grid, x,
+                operating_point, strategies);
 
   // Integrate forward from this timestep to t.
-  return IntegrateFromPriorTimeStep(t, x, operating_point, strategies);
+  return IntegrateFromPriorTimeStep(t, time_grid, x, operating_point,
+                                    strategies);
 }
 
 VectorXf MultiPlayerIntegrableSystem::Integrate(
-    size_t initial_timestep, size_t final_timestep, const VectorXf& x0,
-    const OperatingPoint& operating_point,
+    size_t initial_timestep, size_t final_timestep, const TimeGrid& time_grid,
+    const VectorXf& x0, const OperatingPoint& operating_point,
     const std::vector<Strategy>& strategies) const {
   VectorXf x(x0);
   std::vector<VectorXf> us(NumPlayers());
   for (size_t kk = initial_timestep; kk < final_timestep; kk++) {
-    const Time t = operating_point.t0 + kk * time::kTimeStep;
+    const Time t = operating_point.t0 + time_grid.RelativeTime(kk);
 
     // Populate controls for all players.
     for (PlayerIndex ii = 0; ii < NumPlayers(); ii++)
       us[ii] = strategies[ii](kk, x - operating_point.xs[kk],
                               operating_point.us[kk][ii]);
 
-    x = Integrate(t, time::kTimeStep, x, us);
+    x = Integrate(t, time_grid.TimeStep(kk), x, us);
   }
 
   return x;
 }
 
 VectorXf MultiPlayerIntegrableSystem::IntegrateToNextTimeStep(
-    Time t0, const VectorXf& x0, const OperatingPoint& operating_point,
+    Time t0, const TimeGrid& time_grid, const VectorXf& x0,
+    const OperatingPoint& operating_point,
     const std::vector<Strategy>& strategies) const {
   CHECK_GE(t0, operating_point.t0);
 
   // Compute remaining time this timestep.
   const Time relative_t0 = t0 - operating_point.t0;
-  const size_t current_timestep = static_cast<size_t>(
-      (relative_t0 +
-       constants::kSmallNumber)  // Add to avoid inadvertently subtracting 1.
-      / time::kTimeStep);
+  const size_t current_timestep = time_grid.Index(
+      relative_t0 +
+      constants::kSmallNumber);  // Add to avoid inadvertently subtracting 1.
+  const Time time_step = time_grid.TimeStep(current_timestep);
   const Time remaining_time_this_step =
-      time::kTimeStep * (current_timestep + 1) - relative_t0;
-  CHECK_LT(remaining_time_this_step, time::kTimeStep + constants::kSmallNumber);
+      time_grid.RelativeTime(current_timestep + 1) - relative_t0;
+  CHECK_LT(remaining_time_this_step, time_step + constants::kSmallNumber);
   CHECK_LT(current_timestep, operating_point.xs.size());
 
   // Interpolate x0_ref.
-  const float frac = remaining_time_this_step / time::kTimeStep;
+  const float frac = remaining_time_this_step / time_step;
   const VectorXf x0_ref =
       (current_timestep + 1 < operating_point.xs.size())
           ? frac * operating_point.xs[current_timestep] +
@@ -138,16 +139,16 @@ VectorXf MultiPlayerIntegrableSystem::IntegrateToNextTimeStep(
 }
 
 VectorXf MultiPlayerIntegrableSystem::IntegrateFromPriorTimeStep(
-    Time t, const VectorXf& x0, const OperatingPoint& operating_point,
+    Time t, const TimeGrid& time_grid, const VectorXf& x0,
+    const OperatingPoint& operating_point,
     const std::vector<Strategy>& strategies) const {
   // Compute time until next timestep.
   const Time relative_t = t - operating_point.t0;
-  const size_t current_timestep =
-      static_cast<size_t>(relative_t / time::kTimeStep);
+  const size_t current_timestep = time_grid.Index(relative_t);
   const Time remaining_time_until_t =
-      relative_t - time::kTimeStep * current_timestep;
+      relative_t - time_grid.RelativeTime(current_timestep);
   CHECK_LT(current_timestep, operating_point.xs.size()) << t;
-  CHECK_LT(remaining_time_until_t, time::kTimeStep);
+  CHECK_LT(remaining_time_until_t, time_grid.TimeStep(current_timestep));
 
   // Populate controls for each player.
   std::vector<VectorXf> us(NumPlayers());
@@ -157,8 +158,9 @@ VectorXf MultiPlayerIntegrableSystem::IntegrateFromPriorTimeStep(
                             operating_point.us[current_timestep][ii]);
   }
 
-  return Integrate(operating_point.t0 + time::kTimeStep * current_timestep,
-                   remaining_time_until_t, x0, us);
+  return Integrate(
+      operating_point.t0 + time_grid.RelativeTime(current_timestep),
+      remaining_time_until_t, x0, us);
 }
 
 VectorXf MultiPlayerIntegrableSystem::Integrate(
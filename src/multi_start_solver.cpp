@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Multi-start solver. Runs one ILQSolver per initialization in parallel and
+// selects an equilibrium according to a user-specified criterion.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/solver/ilq_solver.h>
+#include <ilqgames/solver/multi_start_solver.h>
+#include <ilqgames/solver/problem.h>
+#include <ilqgames/solver/solver_params.h>
+#include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+namespace ilqgames {
+
+MultiStartSolver::MultiStartSolver(
+    const std::vector<std::shared_ptr<Problem>>& problems,
+    const SolverParams& params, MultiStartCriterion criterion,
+    const Score& score, float cancellation_margin)
+    : GameSolver(problems.front(), params),
+      criterion_(criterion),
+      score_(score),
+      cancellation_margin_(cancellation_margin),
+      logs_(problems.size()),
+      selected_start_(0),
+      thread_pool_(problems.size()),
+      cancel_all_(false),
+      first_converged_start_(problems.size()),
+      best_converged_score_(constants::kInfinity) {
+  CHECK(score_);
+  CHECK_GE(cancellation_margin_, 0.0);
+
+  // Set up one solver per start, each of which checks after every iteration
+  // whether it should be cancelled.
+  for (const auto& problem : problems) {
+    solvers_.emplace_back(new ILQSolver(problem, params));
+    solvers_.back()->SetStopCallback(
+        [this](const SolverLog& log) { return ShouldCancel(log); });
+  }
+}
+
+std::shared_ptr<SolverLog> MultiStartSolver::Solve(bool* success,
+                                                   Time max_runtime) {
+  cancel_all_ = false;
+  first_converged_start_ = NumStarts();
+  best_converged_score_ = constants::kInfinity;
+
+  // Solve from every start in parallel.
+  thread_pool_.ParallelFor(NumStarts(), [&](size_t start) {
+    logs_[start] = solvers_[start]->Solve(nullptr, max_runtime);
+    Finish(start, *logs_[start]);
+  });
+
+  // Select the first start to converge if that is the criterion. Otherwise,
+  // or if no start converged, choose the lowest score, preferring converged
+  // solutions.
+  if (criterion_ == FASTEST_CONVERGENCE &&
+      first_converged_start_ < NumStarts()) {
+    selected_start_ = first_converged_start_;
+  } else {
+    bool selected_converged = false;
+    float selected_score = constants::kInfinity;
+    selected_start_ = 0;
+    for (size_t start = 0; start < NumStarts(); start++) {
+      const bool converged = logs_[start]->Quality() == CONVERGED;
+      const float score = score_(*logs_[start]);
+      if ((converged && !selected_converged) ||
+          (converged == selected_converged && score < selected_score)) {
+        selected_start_ = start;
+        selected_converged = converged;
+        selected_score = score;
+      }
+    }
+  }
+
+  VLOG(1) << "Selected start " << selected_start_ << " of " << NumStarts()
+          << ".";
+
+  const auto& log = logs_[selected_start_];
+  if (success) *success = log->Quality() == CONVERGED;
+  return log;
+}
+
+void MultiStartSolver::PerturbInitialization(float stddev, unsigned int seed,
+                                             Problem* problem) {
+  CHECK_NOTNULL(problem);
+  CHECK_GE(stddev, 0.0);
+
+  std::default_random_engine rng(seed);
+  std::normal_distribution<float> noise(0.0, stddev);
+
+  std::vector<Strategy> strategies(problem->CurrentStrategies());
+  for (auto& strategy : strategies) {
+    for (auto& alpha : strategy.alphas) {
+      for (Dimension dim = 0; dim < alpha.size(); dim++)
+        alpha(dim) += noise(rng);
+    }
+  }
+
+  problem->OverwriteSolution(problem->CurrentOperatingPoint(), strategies);
+}
+
+bool MultiStartSolver::ShouldCancel(const SolverLog& log) const {
+  if (cancel_all_) return true;
+  if (criterion_ != LOWEST_SCORE) return false;
+
+  float best_converged_score;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    best_converged_score = best_converged_score_;
+  }
+
+  // Only cancel once some start has converged.
+  if (!std::isfinite(best_converged_score)) return false;
+  return score_(log) > best_converged_score +
+                           cancellation_margin_ *
+                               std::abs(best_converged_score);
+}
+
+void MultiStartSolver::Finish(size_t start, const SolverLog& log) {
+  if (log.Quality() != CONVERGED) return;
+
+  const float score = score_(log);
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (first_converged_start_ == NumStarts()) first_converged_start_ = start;
+  best_converged_score_ = std::min(best_converged_score_, score);
+
+  if (criterion_ == FASTEST_CONVERGENCE) cancel_all_ = true;
+}
+
+}  // namespace ilqgames
@@ -59,12 +59,13 @@ float NominalPathLengthCost::Evaluate(Time t, const VectorXf& input) const {
 void NominalPathLengthCost::Quadraticize(Time t, const VectorXf& input,
                                          MatrixXf* hess, VectorXf* grad) const {
   CHECK_LT(dimension_, input.size());
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
 
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Populate Hessian and gradient.
@@ -74,7 +75,7 @@ void NominalPathLengthCost::Quadraticize(Time t, const VectorXf& input,
   const float ddx = weight_;
 
   (*grad)(dimension_) += dx;
-  (*hess)(dimension_, dimension_) += ddx;
+  if (hess) (*hess)(dimension_, dimension_) += ddx;
 }
 
 }  // namespace ilqgames
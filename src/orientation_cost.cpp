@@ -61,12 +61,13 @@ float OrientationCost::Evaluate(const VectorXf& input) const {
 void OrientationCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
                                    VectorXf* grad) const {
   CHECK_LT(dim_, input.size());
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
 
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Populate Hessian and gradient.
@@ -76,7 +77,7 @@ void OrientationCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
   const float ddx = weight_;
 
   (*grad)(dim_) += dx;
-  (*hess)(dim_, dim_) += ddx;
+  if (hess) (*hess)(dim_, dim_) += ddx;
 }
 
 }  // namespace ilqgames
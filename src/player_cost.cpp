@@ -45,10 +45,13 @@
 #include <ilqgames/cost/player_cost.h>
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/quadratic_cost_approximation.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 namespace ilqgames {
 
@@ -59,55 +62,52 @@ namespace {
 template <typename T, typename F>
 void AccumulateControlCostsBase(const PlayerPtrMultiMap<T>& costs, Time t,
                                 const std::vector<VectorXf>& us,
-                                float regularization,
+                                float regularization, bool include_hessians,
                                 QuadraticCostApproximation* q, F f) {
   size_t cost_idx = 0;
   for (const auto& pair : costs) {
     const PlayerIndex player = pair.first;
     const auto& cost = pair.second;
 
-    // If we haven't seen this player yet, initialize R and r to zero.
-    auto iter = q->control.find(player);
-    if (iter == q->control.end()) {
-      auto inserted_pair = q->control.emplace(
-          player, SingleCostApproximation(us[player].size(), regularization));
+    // If we haven't seen this player yet, initialize R and r to zero (plus
+    // regularization).
+    SingleCostApproximation& entry =
+        q->HasControl(player)
+            ? q->control[player]
+            : q->AddControl(player, us[player].size(), regularization);
 
-      // Second element should be true because we definitely won't have any
-      // key collisions.
-      CHECK(inserted_pair.second);
-
-      // Update iter to point to where the new R was inserted.
-      iter = inserted_pair.first;
-    }
-
-    f(*cost, t, us[player], &(iter->second.hess), &(iter->second.grad));
+    f(*cost, t, us[player], (include_hessians) ? &entry.hess : nullptr,
+      &entry.grad);
     cost_idx++;
   }
 }
 
 void AccumulateControlCosts(const PlayerPtrMultiMap<Cost>& costs, Time t,
                             const std::vector<VectorXf>& us,
-                            float regularization,
+                            float regularization, bool include_hessians,
                             QuadraticCostApproximation* q) {
   auto f = [](const Cost& cost, Time t, const VectorXf& u, MatrixXf* hess,
               VectorXf* grad) { cost.Quadraticize(t, u, hess, grad); };
-  AccumulateControlCostsBase(costs, t, us, regularization, q, f);
+  AccumulateControlCostsBase(costs, t, us, regularization, include_hessians, q,
+                             f);
 }
 
 void AccumulateControlConstraints(
     const PlayerPtrMultiMap<Constraint>& constraints, Time t,
     const std::vector<VectorXf>& us, float regularization,
-    QuadraticCostApproximation* q) {
+    bool include_hessians, QuadraticCostApproximation* q) {
   auto f = [](const Constraint& constraint, Time t, const VectorXf& u,
               MatrixXf* hess,
               VectorXf* grad) { constraint.Quadraticize(t, u, hess, grad); };
-  AccumulateControlCostsBase(constraints, t, us, regularization, q, f);
+  AccumulateControlCostsBase(constraints, t, us, regularization,
+                             include_hessians, q, f);
 }
 
 }  // namespace
 
 void PlayerCost::AddStateCost(const std::shared_ptr<Cost>& cost) {
   state_costs_.emplace_back(cost);
+  UpdateStateHessianSparsity(*cost);
 }
 
 void PlayerCost::AddControlCost(PlayerIndex idx,
@@ -118,6 +118,23 @@ void PlayerCost::AddControlCost(PlayerIndex idx,
 void PlayerCost::AddStateConstraint(
     const std::shared_ptr<Constraint>& constraint) {
   state_constraints_.emplace_back(constraint);
+  UpdateStateHessianSparsity(*constraint);
+}
+
+void PlayerCost::UpdateStateHessianSparsity(const Cost& cost) {
+  if (!is_state_hess_sparse_) return;
+
+  // Once any cost is dense, the whole state Hessian is dense.
+  if (!cost.HessianSparsityPattern(&state_hess_dims_)) {
+    is_state_hess_sparse_ = false;
+    state_hess_dims_.clear();
+    return;
+  }
+
+  std::sort(state_hess_dims_.begin(), state_hess_dims_.end());
+  state_hess_dims_.erase(
+      std::unique(state_hess_dims_.begin(), state_hess_dims_.end()),
+      state_hess_dims_.end());
 }
 
 void PlayerCost::AddControlConstraint(
@@ -125,6 +142,25 @@ void PlayerCost::AddControlConstraint(
   control_constraints_.emplace(idx, constraint);
 }
 
+void PlayerCost::SetTimeDiscretization(const TimeGrid& time_grid,
+                                       size_t num_time_steps) {
+  for (auto& cost : state_costs_)
+    cost->SetTimeDiscretization(time_grid, num_time_steps);
+  for (auto& pair : control_costs_)
+    pair.second->SetTimeDiscretization(time_grid, num_time_steps);
+  for (auto& constraint : state_constraints_)
+    constraint->SetTimeDiscretization(time_grid, num_time_steps);
+  for (auto& pair : control_constraints_)
+    pair.second->SetTimeDiscretization(time_grid, num_time_steps);
+}
+
+void PlayerCost::ResetInitialTime(Time t0) {
+  for (auto& cost : state_costs_) cost->ResetInitialTime(t0);
+  for (auto& pair : control_costs_) pair.second->ResetInitialTime(t0);
+  for (auto& constraint : state_constraints_) constraint->ResetInitialTime(t0);
+  for (auto& pair : control_constraints_) pair.second->ResetInitialTime(t0);
+}
+
 float PlayerCost::Evaluate(Time t, const VectorXf& x,
                            const std::vector<VectorXf>& us) const {
   float total_cost = 0.0;
@@ -194,34 +230,117 @@ float PlayerCost::EvaluateOffset(Time t, Time next_t, const VectorXf& next_x,
 QuadraticCostApproximation PlayerCost::Quadraticize(
     Time t, const VectorXf& x, const std::vector<VectorXf>& us) const {
   QuadraticCostApproximation q(x.size(), state_regularization_);
+  Quadraticize(t, x, us, &q);
+  return q;
+}
 
-  // Accumulate state costs.
-  for (const auto& cost : state_costs_)
-    cost->Quadraticize(t, x, &q.state.hess, &q.state.grad);
+QuadraticCostApproximation PlayerCost::QuadraticizeControlCosts(
+    Time t, const VectorXf& x, const std::vector<VectorXf>& us) const {
+  QuadraticCostApproximation q(x.size(), state_regularization_);
+  QuadraticizeControlCosts(t, x, us, &q);
+  return q;
+}
+
+void PlayerCost::Quadraticize(Time t, const VectorXf& x,
+                              const std::vector<VectorXf>& us,
+                              QuadraticCostApproximation* q) const {
+  constexpr bool kControlCostsOnly = false;
+  constexpr bool kIncludeHessians = true;
+  Accumulate(t, x, us, kControlCostsOnly, kIncludeHessians, q);
+}
+
+void PlayerCost::QuadraticizeControlCosts(Time t, const VectorXf& x,
+                                          const std::vector<VectorXf>& us,
+                                          QuadraticCostApproximation* q) const {
+  constexpr bool kControlCostsOnly = true;
+  constexpr bool kIncludeHessians = true;
+  Accumulate(t, x, us, kControlCostsOnly, kIncludeHessians, q);
+}
+
+void PlayerCost::Differentiate(Time t, const VectorXf& x,
+                               const std::vector<VectorXf>& us,
+                               QuadraticCostApproximation* q) const {
+  constexpr bool kControlCostsOnly = false;
+  constexpr bool kIncludeHessians = false;
+  Accumulate(t, x, us, kControlCostsOnly, kIncludeHessians, q);
+}
+
+void PlayerCost::DifferentiateControlCosts(
+    Time t, const VectorXf& x, const std::vector<VectorXf>& us,
+    QuadraticCostApproximation* q) const {
+  constexpr bool kControlCostsOnly = true;
+  constexpr bool kIncludeHessians = false;
+  Accumulate(t, x, us, kControlCostsOnly, kIncludeHessians, q);
+}
+
+void PlayerCost::Accumulate(Time t, const VectorXf& x,
+                            const std::vector<VectorXf>& us,
+                            bool control_costs_only, bool include_hessians,
+                            QuadraticCostApproximation* q) const {
+  CHECK_NOTNULL(q);
+
+  // Reset to regularization only. Leave the state Hessian alone if we aren't
+  // computing Hessians.
+  MatrixXf* state_hess = nullptr;
+  if (include_hessians) {
+    ResetStateHessian(x.size(), control_costs_only, &q->state);
+    state_hess = &q->state.hess;
+  }
+  q->state.grad.setZero(x.size());
+  q->ClearControls();
 
   // Accumulate control costs.
-  AccumulateControlCosts(control_costs_, t, us, control_regularization_, &q);
+  AccumulateControlCosts(control_costs_, t, us, control_regularization_,
+                         include_hessians, q);
+  if (control_costs_only) return;
+
+  // Accumulate state costs.
+  for (const auto& cost : state_costs_)
+    cost->Quadraticize(t, x, state_hess, &q->state.grad);
 
   // Accumulate state constraints (including augmented Lagrangian terms scaled
   // by appropriate multipliers).
   for (const auto& constraint : state_constraints_)
-    constraint->Quadraticize(t, x, &q.state.hess, &q.state.grad);
+    constraint->Quadraticize(t, x, state_hess, &q->state.grad);
 
   // Accumulate control constraints.
   AccumulateControlConstraints(control_constraints_, t, us,
-                               control_regularization_, &q);
-
-  return q;
+                               control_regularization_, include_hessians, q);
 }
 
-QuadraticCostApproximation PlayerCost::QuadraticizeControlCosts(
-    Time t, const VectorXf& x, const std::vector<VectorXf>& us) const {
-  QuadraticCostApproximation q(x.size(), state_regularization_);
+void PlayerCost::ResetStateHessian(Dimension xdim, bool control_costs_only,
+                                   SingleCostApproximation* state) const {
+  CHECK_NOTNULL(state);
+
+  // Control costs alone leave pure regularization, so their pattern is empty.
+  const bool is_sparse = control_costs_only || is_state_hess_sparse_;
+  const size_t num_dims = (control_costs_only) ? 0 : state_hess_dims_.size();
+
+  // If the last Hessian written here had the same pattern, then all
+  // off-diagonal entries outside of it are already zero. The diagonal is
+  // always reset, since the last Hessian may have been scaled since.
+  MatrixXf& hess = state->hess;
+  if (is_sparse && state->is_hess_sparse && hess.rows() == xdim &&
+      hess.cols() == xdim && state->hess_dims.size() == num_dims &&
+      (control_costs_only || state->hess_dims == state_hess_dims_)) {
+    hess.diagonal().setConstant(state_regularization_);
+    for (const Dimension ii : state->hess_dims) {
+      for (const Dimension jj : state->hess_dims) {
+        if (ii != jj) hess(ii, jj) = 0.0;
+      }
+    }
 
-  // Accumulate control costs.
-  AccumulateControlCosts(control_costs_, t, us, control_regularization_, &q);
+    return;
+  }
 
-  return q;
+  // Otherwise, reset everything.
+  hess.setIdentity(xdim, xdim);
+  hess *= state_regularization_;
+  state->is_hess_sparse = is_sparse;
+  if (control_costs_only)
+    state->hess_dims.clear();
+  else
+    state->hess_dims = state_hess_dims_;
 }
 
 }  // namespace ilqgames
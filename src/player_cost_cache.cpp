@@ -77,9 +77,9 @@ PlayerCostCache::PlayerCostCache(const std::shared_ptr<const SolverLog>& log,
       auto& entry = e.first->second;
       entry.resize(log->NumIterates());
       for (size_t jj = 0; jj < log->NumIterates(); jj++) {
-        entry[jj].resize(time::kNumTimeSteps);
+        entry[jj].resize(log->NumTimeSteps());
 
-        for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
+        for (size_t kk = 0; kk < log->NumTimeSteps(); kk++) {
           const VectorXf x = log->State(jj, kk);
           entry[jj][kk] = cost->Evaluate(log->IndexToTime(kk), x);
         }
@@ -99,9 +99,9 @@ PlayerCostCache::PlayerCostCache(const std::shared_ptr<const SolverLog>& log,
       auto& entry = e.first->second;
       entry.resize(log->NumIterates());
       for (size_t jj = 0; jj < log->NumIterates(); jj++) {
-        entry[jj].resize(time::kNumTimeSteps);
+        entry[jj].resize(log->NumTimeSteps());
 
-        for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
+        for (size_t kk = 0; kk < log->NumTimeSteps(); kk++) {
           entry[jj][kk] = cost->Evaluate(log->IndexToTime(kk),
                                          log->Control(jj, kk, other_player));
         }
@@ -119,9 +119,9 @@ PlayerCostCache::PlayerCostCache(const std::shared_ptr<const SolverLog>& log,
       auto& entry = e.first->second;
       entry.resize(log->NumIterates());
       for (size_t jj = 0; jj < log->NumIterates(); jj++) {
-        entry[jj].resize(time::kNumTimeSteps);
+        entry[jj].resize(log->NumTimeSteps());
 
-        for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
+        for (size_t kk = 0; kk < log->NumTimeSteps(); kk++) {
           const VectorXf x = log->State(jj, kk);
           entry[jj][kk] = constraint->Evaluate(log->IndexToTime(kk), x);
         }
@@ -141,9 +141,9 @@ PlayerCostCache::PlayerCostCache(const std::shared_ptr<const SolverLog>& log,
       auto& entry = e.first->second;
       entry.resize(log->NumIterates());
       for (size_t jj = 0; jj < log->NumIterates(); jj++) {
-        entry[jj].resize(time::kNumTimeSteps);
+        entry[jj].resize(log->NumTimeSteps());
 
-        for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
+        for (size_t kk = 0; kk < log->NumTimeSteps(); kk++) {
           entry[jj][kk] = constraint->Evaluate(
               log->IndexToTime(kk), log->Control(jj, kk, other_player));
         }
@@ -162,9 +162,9 @@ float PlayerCostCache::Interpolate(size_t iterate, Time t, PlayerIndex player,
 
   // Interpolate this list.
   const size_t lo = log_->TimeToIndex(t);
-  const size_t hi = std::min(lo + 1, time::kNumTimeSteps - 1);
+  const size_t hi = std::min(lo + 1, log_->NumTimeSteps() - 1);
 
-  const float frac = (t - log_->IndexToTime(lo)) / time::kTimeStep;
+  const float frac = (t - log_->IndexToTime(lo)) / log_->TimeStep(lo);
   return (1.0 - frac) * costs[lo] + frac * costs[hi];
 }
 
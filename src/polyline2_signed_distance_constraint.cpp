@@ -75,9 +75,10 @@ void Polyline2SignedDistanceConstraint::Quadraticize(Time t,
   CHECK_LT(xidx_, input.size());
   CHECK_LT(yidx_, input.size());
   CHECK_NOTNULL(grad);
-  CHECK_NOTNULL(hess);
-  CHECK_EQ(hess->rows(), input.size());
-  CHECK_EQ(hess->cols(), input.size());
+  if (hess) {
+    CHECK_EQ(hess->rows(), input.size());
+    CHECK_EQ(hess->cols(), input.size());
+  }
   CHECK_EQ(grad->size(), input.size());
 
   // Find closest point/segment and whether closest point is an interior point
@@ -137,10 +138,12 @@ void Polyline2SignedDistanceConstraint::Quadraticize(Time t,
   (*grad)(xidx_) += dx;
   (*grad)(yidx_) += dy;
 
-  (*hess)(xidx_, xidx_) += ddx;
-  (*hess)(xidx_, yidx_) += dxdy;
-  (*hess)(yidx_, xidx_) += dxdy;
-  (*hess)(yidx_, yidx_) += ddy;
+  if (hess) {
+    (*hess)(xidx_, xidx_) += ddx;
+    (*hess)(xidx_, yidx_) += dxdy;
+    (*hess)(yidx_, xidx_) += dxdy;
+    (*hess)(yidx_, yidx_) += ddy;
+  }
 }
 
 }  // namespace ilqgames
@@ -46,6 +46,7 @@
 #include <ilqgames/utils/relative_time_tracker.h>
 #include <ilqgames/utils/solver_log.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/time_grid.h>
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
@@ -53,20 +54,28 @@
 #include <memory>
 #include <vector>
 
-// // Time horizon and step.
-// DEFINE_double(time_horizon, 10.0, "Total time horizon (s).");
-// DEFINE_double(time_step, 0.1, "Length of discrete time step (s).");
-
 namespace ilqgames {
 
-Problem::Problem() : initialized_(false) {}
+Problem::Problem(Time time_horizon, Time time_step)
+    : Problem(time_horizon, TimeGrid(time_step)) {}
+
+Problem::Problem(Time time_horizon, const TimeGrid& time_grid)
+    : time_horizon_(time_horizon),
+      time_grid_(time_grid),
+      time_step_(time_grid.TimeStep(0)),
+      num_time_steps_(time_grid.NumTimeSteps(time_horizon)),
+      solution_grid_(time_grid),
+      initialized_(false) {
+  CHECK_GT(time_step_, 0.0);
+  CHECK_GE(time_horizon_, time_step_);
+}
 
 size_t Problem::SyncToExistingProblem(const VectorXf& x0, Time t0,
                                       Time planner_runtime,
                                       OperatingPoint& op) {
   CHECK(initialized_);
   CHECK_GE(planner_runtime, 0.0);
-  CHECK_LE(planner_runtime + t0, operating_point_->t0 + time::kTimeHorizon);
+  CHECK_LE(planner_runtime + t0, operating_point_->t0 + time_horizon_);
   CHECK_GE(t0, operating_point_->t0);
 
   // Integrate x0 forward from t0 by approximately planner_runtime to get
@@ -75,30 +84,34 @@ size_t Problem::SyncToExistingProblem(const VectorXf& x0, Time t0,
   // timestep at least 'planner_runtime' has elapsed (done by rounding).
   constexpr float kRoundingError = 0.9;
   const Time relative_t0 = t0 - op.t0;
-  size_t current_timestep = static_cast<size_t>(relative_t0 / time::kTimeStep);
+  size_t current_timestep = solution_grid_.Index(relative_t0);
   Time remaining_time_this_step =
-      (current_timestep + 1) * time::kTimeStep - relative_t0;
-  if (remaining_time_this_step < kRoundingError * time::kTimeStep) {
+      solution_grid_.RelativeTime(current_timestep + 1) - relative_t0;
+  if (remaining_time_this_step <
+      kRoundingError * solution_grid_.TimeStep(current_timestep)) {
     current_timestep += 1;
-    remaining_time_this_step = time::kTimeStep - remaining_time_this_step;
+    remaining_time_this_step =
+        solution_grid_.TimeStep(current_timestep) - remaining_time_this_step;
   }
 
-  CHECK_LT(remaining_time_this_step, time::kTimeStep);
+  CHECK_LT(remaining_time_this_step,
+           solution_grid_.TimeStep(current_timestep));
 
   // Initially, set x to the integrated version of x0 at the next timestep.
-  VectorXf x = dynamics_->IntegrateToNextTimeStep(t0, x0, *operating_point_,
-                                                  *strategies_);
+  VectorXf x = dynamics_->IntegrateToNextTimeStep(
+      t0, solution_grid_, x0, *operating_point_, *strategies_);
   op.t0 = t0 + remaining_time_this_step;
+  size_t last_integration_timestep = current_timestep + 1;
   if (remaining_time_this_step <= planner_runtime) {
-    const size_t num_steps_to_integrate = static_cast<size_t>(
-        constants::kSmallNumber +  // Add to avoid truncation error.
-        (planner_runtime - remaining_time_this_step) / time::kTimeStep);
-    const size_t last_integration_timestep =
-        current_timestep + num_steps_to_integrate;
-
-    x = dynamics_->Integrate(current_timestep + 1, last_integration_timestep, x,
-                             *operating_point_, *strategies_);
-    op.t0 += time::kTimeStep * num_steps_to_integrate;
+    const size_t num_steps_to_integrate = solution_grid_.NumTimeStepsWithin(
+        current_timestep + 1, planner_runtime - remaining_time_this_step);
+    last_integration_timestep = current_timestep + num_steps_to_integrate;
+
+    x = dynamics_->Integrate(current_timestep + 1, last_integration_timestep,
+                             solution_grid_, x, *operating_point_,
+                             *strategies_);
+    op.t0 +=
+        solution_grid_.Duration(current_timestep + 1, num_steps_to_integrate);
   }
 
   // Find index of nearest state in the existing plan to this state.
@@ -117,10 +130,14 @@ size_t Problem::SyncToExistingProblem(const VectorXf& x0, Time t0,
   x0_ = dynamics_->Stitch(*nearest_iter, x);
 
   // Update all costs to have the correct initial time.
-  RelativeTimeTracker::ResetInitialTime(op.t0);
+  for (auto& pc : player_costs_) pc.ResetInitialTime(op.t0);
 
-  // Check an invariant.
-  CHECK_LE(std::abs(t0 + planner_runtime - op.t0), time::kTimeStep);
+  // Check an invariant, i.e., that the new initial time is within a time step
+  // of the planner runtime (either the one containing the old initial time, or
+  // the first one which did not fit in the runtime).
+  CHECK_LE(std::abs(t0 + planner_runtime - op.t0),
+           std::max(solution_grid_.TimeStep(current_timestep),
+                    solution_grid_.TimeStep(last_integration_timestep + 1)));
   return first_timestep_in_new_problem;
 }
 
@@ -128,50 +145,74 @@ void Problem::SetUpNextRecedingHorizon(const VectorXf& x0, Time t0,
                                        Time planner_runtime) {
   CHECK(initialized_);
 
+  // Record the start of the existing plan and the time with respect to which
+  // constraint multipliers are indexed, before syncing resets both.
+  const Time old_plan_t0 = operating_point_->t0;
+  const Time old_multipliers_t0 = multipliers_.InitialTime();
+
   // Sync to existing problem.
   const size_t first_timestep_in_new_problem =
       SyncToExistingProblem(x0, t0, planner_runtime, *operating_point_);
 
-  // Set final timestep to consider in current operating point.
-  const size_t after_final_timestep =
-      first_timestep_in_new_problem + time::kNumTimeSteps;
-  const size_t timestep_iterator_end =
-      std::min(after_final_timestep, operating_point_->xs.size());
+  // Shift constraint multipliers so that they stay aligned with the operating
+  // point. Whether they are actually reused (as a warm start for the dual
+  // solution) is up to the solver (see `SolverParams::reset_lambdas`).
+  multipliers_.Shift(old_plan_t0 +
+                         solution_grid_.RelativeTime(
+                             first_timestep_in_new_problem) -
+                         old_multipliers_t0,
+                     time_grid_);
 
   // Populate strategies and opeating point for the remainder of the
   // existing plan, reusing the old operating point when possible.
-  for (size_t kk = first_timestep_in_new_problem; kk < timestep_iterator_end;
-       kk++) {
-    const size_t kk_new_problem = kk - first_timestep_in_new_problem;
-
-    // Set current state and controls in operating point.
-    operating_point_->xs[kk_new_problem].swap(operating_point_->xs[kk]);
-    operating_point_->us[kk_new_problem].swap(operating_point_->us[kk]);
-    CHECK_EQ(operating_point_->us[kk_new_problem].size(),
-             dynamics_->NumPlayers());
-
-    // Set current stategy.
-    for (auto& strategy : *strategies_) {
-      strategy.Ps[kk_new_problem].swap(strategy.Ps[kk]);
-      strategy.alphas[kk_new_problem].swap(strategy.alphas[kk]);
+  // If both the existing plan and this problem are discretized at the same
+  // uniform time step, timesteps can be reused directly. Otherwise, the plan
+  // has to be resampled.
+  size_t num_reused_timesteps = 0;
+  if (time_grid_.IsUniform() && solution_grid_.IsUniform() &&
+      time_grid_.TimeStep(0) == solution_grid_.TimeStep(0)) {
+    // Set final timestep to consider in current operating point.
+    const size_t after_final_timestep =
+        first_timestep_in_new_problem + num_time_steps_;
+    const size_t timestep_iterator_end =
+        std::min(after_final_timestep, operating_point_->xs.size());
+
+    for (size_t kk = first_timestep_in_new_problem; kk < timestep_iterator_end;
+         kk++) {
+      const size_t kk_new_problem = kk - first_timestep_in_new_problem;
+
+      // Set current state and controls in operating point.
+      operating_point_->xs[kk_new_problem].swap(operating_point_->xs[kk]);
+      operating_point_->us[kk_new_problem].swap(operating_point_->us[kk]);
+      CHECK_EQ(operating_point_->us[kk_new_problem].size(),
+               dynamics_->NumPlayers());
+
+      // Set current stategy.
+      for (auto& strategy : *strategies_) {
+        strategy.Ps[kk_new_problem].swap(strategy.Ps[kk]);
+        strategy.alphas[kk_new_problem].swap(strategy.alphas[kk]);
+      }
     }
-  }
+
+    num_reused_timesteps =
+        timestep_iterator_end - first_timestep_in_new_problem;
+  } else
+    num_reused_timesteps = ResampleExistingPlan(first_timestep_in_new_problem);
 
   // Make sure operating point is the right size.
-  CHECK_GE(operating_point_->xs.size(), time::kNumTimeSteps);
-  if (operating_point_->xs.size() > time::kNumTimeSteps) {
-    operating_point_->xs.resize(time::kNumTimeSteps);
-    operating_point_->us.resize(time::kNumTimeSteps);
+  CHECK_GE(operating_point_->xs.size(), num_time_steps_);
+  if (operating_point_->xs.size() > num_time_steps_) {
+    operating_point_->xs.resize(num_time_steps_);
+    operating_point_->us.resize(num_time_steps_);
     for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
-      (*strategies_)[ii].Ps.resize(time::kNumTimeSteps);
-      (*strategies_)[ii].alphas.resize(time::kNumTimeSteps);
+      (*strategies_)[ii].Ps.resize(num_time_steps_);
+      (*strategies_)[ii].alphas.resize(num_time_steps_);
     }
   }
 
   // Set new operating point controls and strategies to zero and propagate
   // state forward accordingly.
-  for (size_t kk = timestep_iterator_end - first_timestep_in_new_problem;
-       kk < time::kNumTimeSteps; kk++) {
+  for (size_t kk = num_reused_timesteps; kk < num_time_steps_; kk++) {
     operating_point_->us[kk].resize(dynamics_->NumPlayers());
     for (size_t ii = 0; ii < dynamics_->NumPlayers(); ii++) {
       (*strategies_)[ii].Ps[kk].setZero(dynamics_->UDim(ii), dynamics_->XDim());
@@ -180,9 +221,48 @@ void Problem::SetUpNextRecedingHorizon(const VectorXf& x0, Time t0,
     }
 
     operating_point_->xs[kk] = dynamics_->Integrate(
-        RelativeTimeTracker::RelativeTime(kk - 1), time::kTimeStep,
+        time_grid_.RelativeTime(kk - 1), time_grid_.TimeStep(kk - 1),
         operating_point_->xs[kk - 1], operating_point_->us[kk - 1]);
   }
+
+  // The solution is now discretized on this problem's time grid.
+  solution_grid_ = time_grid_;
+}
+
+size_t Problem::ResampleExistingPlan(size_t first_timestep_in_new_problem) {
+  const OperatingPoint old_operating_point(*operating_point_);
+  const std::vector<Strategy> old_strategies(*strategies_);
+  const size_t old_num_time_steps = old_operating_point.xs.size();
+
+  // Walk along this problem's grid, which starts at the first timestep in the
+  // new problem, and linearly interpolate states and controls between the
+  // surrounding timesteps in the existing plan (on its own grid). Strategies
+  // are held constant over each existing timestep.
+  const Time first_time =
+      solution_grid_.RelativeTime(first_timestep_in_new_problem);
+  size_t kk = 0;
+  for (; kk < num_time_steps_; kk++) {
+    const Time relative_t = first_time + time_grid_.RelativeTime(kk);
+    const size_t lo = solution_grid_.Index(
+        relative_t + constants::kSmallNumber * time_grid_.TimeStep(kk));
+    if (lo >= old_num_time_steps) break;
+    const size_t hi = std::min(lo + 1, old_num_time_steps - 1);
+    const float frac = std::max<float>(
+        0.0, (relative_t - solution_grid_.RelativeTime(lo)) /
+                 solution_grid_.TimeStep(lo));
+
+    operating_point_->xs[kk] = (1.0 - frac) * old_operating_point.xs[lo] +
+                               frac * old_operating_point.xs[hi];
+    for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++) {
+      operating_point_->us[kk][ii] =
+          (1.0 - frac) * old_operating_point.us[lo][ii] +
+          frac * old_operating_point.us[hi][ii];
+      (*strategies_)[ii].Ps[kk] = old_strategies[ii].Ps[lo];
+      (*strategies_)[ii].alphas[kk] = old_strategies[ii].alphas[lo];
+    }
+  }
+
+  return kk;
 }
 
 void Problem::OverwriteSolution(const OperatingPoint& operating_point,
@@ -191,6 +271,14 @@ void Problem::OverwriteSolution(const OperatingPoint& operating_point,
 
   *operating_point_ = operating_point;
   *strategies_ = strategies;
+  solution_grid_ = time_grid_;
+}
+
+void Problem::OverwriteSolution(const OperatingPoint& operating_point,
+                                const std::vector<Strategy>& strategies,
+                                const TimeGrid& solution_grid) {
+  OverwriteSolution(operating_point, strategies);
+  solution_grid_ = solution_grid;
 }
 
 bool Problem::IsConstrained() const {
@@ -63,10 +63,11 @@ float ProximityConstraint::Evaluate(const VectorXf& input) const {
 
 void ProximityConstraint::Quadraticize(Time t, const VectorXf& input,
                                        MatrixXf* hess, VectorXf* grad) const {
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
-  CHECK_EQ(hess->rows(), input.size());
-  CHECK_EQ(hess->cols(), input.size());
+  if (hess) {
+    CHECK_EQ(hess->rows(), input.size());
+    CHECK_EQ(hess->cols(), input.size());
+  }
   CHECK_EQ(grad->size(), input.size());
 
   // Compute proximity.
@@ -95,24 +96,26 @@ void ProximityConstraint::Quadraticize(Time t, const VectorXf& input,
   (*grad)(yidx1_) += grad_y1;
   (*grad)(yidx2_) -= grad_y1;
 
-  (*hess)(xidx1_, xidx1_) += hess_x1x1;
-  (*hess)(xidx1_, xidx2_) -= hess_x1x1;
-  (*hess)(xidx2_, xidx1_) -= hess_x1x1;
-  (*hess)(xidx2_, xidx2_) += hess_x1x1;
-
-  (*hess)(yidx1_, yidx1_) += hess_y1y1;
-  (*hess)(yidx1_, yidx2_) -= hess_y1y1;
-  (*hess)(yidx2_, yidx1_) -= hess_y1y1;
-  (*hess)(yidx2_, yidx2_) += hess_y1y1;
-
-  (*hess)(xidx1_, yidx1_) += hess_x1y1;
-  (*hess)(xidx1_, yidx2_) -= hess_x1y1;
-  (*hess)(xidx2_, yidx1_) -= hess_x1y1;
-  (*hess)(xidx2_, yidx2_) += hess_x1y1;
-  (*hess)(yidx1_, xidx1_) += hess_x1y1;
-  (*hess)(yidx1_, xidx2_) -= hess_x1y1;
-  (*hess)(yidx2_, xidx1_) -= hess_x1y1;
-  (*hess)(yidx2_, xidx2_) += hess_x1y1;
+  if (hess) {
+    (*hess)(xidx1_, xidx1_) += hess_x1x1;
+    (*hess)(xidx1_, xidx2_) -= hess_x1x1;
+    (*hess)(xidx2_, xidx1_) -= hess_x1x1;
+    (*hess)(xidx2_, xidx2_) += hess_x1x1;
+
+    (*hess)(yidx1_, yidx1_) += hess_y1y1;
+    (*hess)(yidx1_, yidx2_) -= hess_y1y1;
+    (*hess)(yidx2_, yidx1_) -= hess_y1y1;
+    (*hess)(yidx2_, yidx2_) += hess_y1y1;
+
+    (*hess)(xidx1_, yidx1_) += hess_x1y1;
+    (*hess)(xidx1_, yidx2_) -= hess_x1y1;
+    (*hess)(xidx2_, yidx1_) -= hess_x1y1;
+    (*hess)(xidx2_, yidx2_) += hess_x1y1;
+    (*hess)(yidx1_, xidx1_) += hess_x1y1;
+    (*hess)(yidx1_, xidx2_) -= hess_x1y1;
+    (*hess)(yidx2_, xidx1_) -= hess_x1y1;
+    (*hess)(yidx2_, xidx2_) += hess_x1y1;
+  }
 }
 
 }  // namespace ilqgames
@@ -62,12 +62,13 @@ float ProximityCost::Evaluate(const VectorXf& input) const {
 
 void ProximityCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
                                  VectorXf* grad) const {
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
 
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Compute Hessian and gradient.
@@ -98,27 +99,29 @@ void ProximityCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
   (*grad)(yidx1_) += ddy1;
   (*grad)(yidx2_) -= ddy1;
 
-  (*hess)(xidx1_, xidx1_) += hess_x1x1;
-  (*hess)(xidx1_, xidx2_) -= hess_x1x1;
-  (*hess)(xidx2_, xidx1_) -= hess_x1x1;
-  (*hess)(xidx2_, xidx2_) += hess_x1x1;
+  if (hess) {
+    (*hess)(xidx1_, xidx1_) += hess_x1x1;
+    (*hess)(xidx1_, xidx2_) -= hess_x1x1;
+    (*hess)(xidx2_, xidx1_) -= hess_x1x1;
+    (*hess)(xidx2_, xidx2_) += hess_x1x1;
 
-  (*hess)(yidx1_, yidx1_) += hess_y1y1;
-  (*hess)(yidx1_, yidx2_) -= hess_y1y1;
-  (*hess)(yidx2_, yidx1_) -= hess_y1y1;
-  (*hess)(yidx2_, yidx2_) += hess_y1y1;
+    (*hess)(yidx1_, yidx1_) += hess_y1y1;
+    (*hess)(yidx1_, yidx2_) -= hess_y1y1;
+    (*hess)(yidx2_, yidx1_) -= hess_y1y1;
+    (*hess)(yidx2_, yidx2_) += hess_y1y1;
 
-  (*hess)(xidx1_, yidx1_) += hess_x1y1;
-  (*hess)(yidx1_, xidx1_) += hess_x1y1;
+    (*hess)(xidx1_, yidx1_) += hess_x1y1;
+    (*hess)(yidx1_, xidx1_) += hess_x1y1;
 
-  (*hess)(xidx1_, yidx2_) -= hess_x1y1;
-  (*hess)(yidx2_, xidx1_) -= hess_x1y1;
+    (*hess)(xidx1_, yidx2_) -= hess_x1y1;
+    (*hess)(yidx2_, xidx1_) -= hess_x1y1;
 
-  (*hess)(xidx2_, yidx1_) -= hess_x1y1;
-  (*hess)(yidx1_, xidx2_) -= hess_x1y1;
+    (*hess)(xidx2_, yidx1_) -= hess_x1y1;
+    (*hess)(yidx1_, xidx2_) -= hess_x1y1;
 
-  (*hess)(xidx2_, yidx2_) += hess_x1y1;
-  (*hess)(yidx2_, xidx2_) += hess_x1y1;
+    (*hess)(xidx2_, yidx2_) += hess_x1y1;
+    (*hess)(yidx2_, xidx2_) += hess_x1y1;
+  }
 }
 
 }  // namespace ilqgames
@@ -65,12 +65,13 @@ float QuadraticCost::Evaluate(const VectorXf& input) const {
 void QuadraticCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
                                  VectorXf* grad) const {
   CHECK_LT(dimension_, input.size());
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
 
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Handle single dimension case first.
@@ -80,7 +81,7 @@ void QuadraticCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
     const float ddx = weight_;
 
     (*grad)(dimension_) += dx;
-    (*hess)(dimension_, dimension_) += ddx;
+    if (hess) (*hess)(dimension_, dimension_) += ddx;
   }
 
   // Handle dimension < 0 case.
@@ -88,8 +89,10 @@ void QuadraticCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
     const VectorXf delta = input - VectorXf::Constant(input.size(), nominal_);
 
     *grad += weight_ * delta;
-    hess->diagonal() =
-      hess->diagonal() + VectorXf::Constant(input.size(), weight_);
+    if (hess) {
+      hess->diagonal() =
+        hess->diagonal() + VectorXf::Constant(input.size(), weight_);
+    }
   }
 }
 
@@ -61,11 +61,12 @@ float QuadraticDifferenceCost::Evaluate(const VectorXf& input) const {
 void QuadraticDifferenceCost::Quadraticize(const VectorXf& input,
                                            MatrixXf* hess,
                                            VectorXf* grad) const {
-  CHECK_NOTNULL(hess);
 
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
 
   if (grad) CHECK_EQ(input.size(), grad->size());
 
@@ -76,10 +77,12 @@ void QuadraticDifferenceCost::Quadraticize(const VectorXf& input,
     const float ddy = weight_;
     const float dxdy = -weight_;
 
-    (*hess)(dims1_[ii], dims1_[ii]) += ddx;
-    (*hess)(dims2_[ii], dims2_[ii]) += ddy;
-    (*hess)(dims1_[ii], dims2_[ii]) += dxdy;
-    (*hess)(dims2_[ii], dims1_[ii]) += dxdy;
+    if (hess) {
+      (*hess)(dims1_[ii], dims1_[ii]) += ddx;
+      (*hess)(dims2_[ii], dims2_[ii]) += ddy;
+      (*hess)(dims1_[ii], dims2_[ii]) += dxdy;
+      (*hess)(dims2_[ii], dims1_[ii]) += dxdy;
+    }
 
     if (grad) {
       (*grad)(dims1_[ii]) += dx;
@@ -61,12 +61,13 @@ void QuadraticNormCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
                                      VectorXf* grad) const {
   CHECK_LT(dim1_, input.size());
   CHECK_LT(dim2_, input.size());
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
 
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Populate Hessian and gradient.
@@ -87,10 +88,12 @@ void QuadraticNormCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
   (*grad)(dim1_) += dx;
   (*grad)(dim2_) += dy;
 
-  (*hess)(dim1_, dim1_) += ddx;
-  (*hess)(dim2_, dim2_) += ddy;
-  (*hess)(dim1_, dim2_) += dxdy;
-  (*hess)(dim2_, dim1_) += dxdy;
+  if (hess) {
+    (*hess)(dim1_, dim1_) += ddx;
+    (*hess)(dim2_, dim2_) += ddy;
+    (*hess)(dim1_, dim2_) += dxdy;
+    (*hess)(dim2_, dim1_) += dxdy;
+  }
 }
 
 }  // namespace ilqgames
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Keeps track of the runtime of a repeated task and predicts the runtime of
+// the next repetition as a quantile of the runtimes observed in a moving
+// window.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/utils/quantile_timer.h>
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace ilqgames {
+
+QuantileTimer::QuantileTimer(size_t max_samples)
+    : max_samples_(max_samples), oldest_(0) {
+  CHECK_GT(max_samples_, 0);
+  runtimes_.reserve(max_samples_);
+  sorted_runtimes_.reserve(max_samples_);
+
+  // For defined behavior, starting with a Tic().
+  Tic();
+}
+
+void QuantileTimer::Tic() {
+  start_ = std::chrono::high_resolution_clock::now();
+}
+
+Time QuantileTimer::Toc() {
+  // Elapsed time in seconds.
+  const Time elapsed = (std::chrono::duration<Time>(
+                            std::chrono::high_resolution_clock::now() - start_))
+                           .count();
+
+  // Add to the window, overwriting the oldest runtime once it is full.
+  if (runtimes_.size() < max_samples_)
+    runtimes_.push_back(elapsed);
+  else {
+    runtimes_[oldest_] = elapsed;
+    oldest_ = (oldest_ + 1) % max_samples_;
+  }
+
+  return elapsed;
+}
+
+Time QuantileTimer::RuntimeQuantile(float quantile, Time initial_guess) const {
+  CHECK_GE(quantile, 0.0);
+  CHECK_LE(quantile, 1.0);
+
+  // Handle not enough data.
+  if (runtimes_.empty()) return initial_guess;
+
+  // Find the smallest runtime which is no less than the given fraction of all
+  // runtimes (rounding up, to be conservative).
+  const size_t num_samples = runtimes_.size();
+  const size_t rank = static_cast<size_t>(std::ceil(quantile * num_samples));
+  const size_t idx = std::min(std::max<size_t>(rank, 1), num_samples) - 1;
+
+  sorted_runtimes_.assign(runtimes_.begin(), runtimes_.end());
+  std::nth_element(sorted_runtimes_.begin(), sorted_runtimes_.begin() + idx,
+                   sorted_runtimes_.end());
+  return sorted_runtimes_[idx];
+}
+
+}  // namespace ilqgames
@@ -97,16 +97,17 @@ std::vector<std::shared_ptr<const SolverLog>> RecedingHorizonSimulator(
     t += kExtraTime;  // + planner_runtime;
 
     if (t >= final_time ||
-        !splicer.ContainsTime(t + planner_runtime + time::kTimeStep))
+        !splicer.ContainsTime(t + planner_runtime + splicer.TimeStep()))
       break;
 
     x = solver->GetProblem().Dynamics()->Integrate(
-        t - kExtraTime, t, x, splicer.CurrentOperatingPoint(),
-        splicer.CurrentStrategies());
+        t - kExtraTime, t, splicer.Grid(), x,
+        splicer.CurrentOperatingPoint(), splicer.CurrentStrategies());
 
     // Overwrite problem with spliced solution.
     solver->GetProblem().OverwriteSolution(splicer.CurrentOperatingPoint(),
-                                           splicer.CurrentStrategies());
+                                           splicer.CurrentStrategies(),
+                                           splicer.Grid());
 
     // Set up next receding horizon problem and solve.
     solver->GetProblem().SetUpNextRecedingHorizon(x, t, planner_runtime);
@@ -116,7 +117,10 @@ std::vector<std::shared_ptr<const SolverLog>> RecedingHorizonSimulator(
     elapsed_time =
         std::chrono::duration<Time>(clock::now() - solver_call_time).count();
 
-    CHECK_LE(elapsed_time, planner_runtime);
+    LOG_IF(WARNING, elapsed_time > planner_runtime)
+        << "t = " << t << ": Planner overran its runtime of "
+        << planner_runtime << " seconds by "
+        << elapsed_time - planner_runtime << " seconds.";
     VLOG(1) << "t = " << t << ": Solved warm-started problem in "
             << elapsed_time << " seconds.";
 
@@ -126,11 +130,13 @@ std::vector<std::shared_ptr<const SolverLog>> RecedingHorizonSimulator(
 
     // Integrate dynamics forward to account for solve time.
     x = solver->GetProblem().Dynamics()->Integrate(
-        t - elapsed_time, t, x, splicer.CurrentOperatingPoint(),
-        splicer.CurrentStrategies());
+        t - elapsed_time, t, splicer.Grid(), x,
+        splicer.CurrentOperatingPoint(), splicer.CurrentStrategies());
 
-    // Add new solution to splicer if it converged.
-    if (logs.back()->WasConverged()) splicer.Splice(*logs.back());
+    // Add new solution to splicer if it improved upon the warm start, keeping
+    // the current solution from the current time onward.
+    if (logs.back()->Quality() != NOT_IMPROVED)
+      splicer.Splice(*logs.back(), t);
   }
 
   return logs;
@@ -55,11 +55,11 @@ float RelativeDistanceCost::Evaluate(const VectorXf& input) const {
 
 void RelativeDistanceCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
                                         VectorXf* grad) const {
-  CHECK_NOTNULL(hess);
-
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
 
   if (grad) CHECK_EQ(input.size(), grad->size());
 
@@ -72,25 +72,27 @@ void RelativeDistanceCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
   const float ddy = weight_ * diff_x * diff_x / dist_3;
   const float dxdy = -weight_ * diff_x * diff_y / dist_3;
 
-  (*hess)(dims1_.first, dims1_.first) += ddx;
-  (*hess)(dims1_.first, dims1_.second) += dxdy;
-  (*hess)(dims1_.second, dims1_.first) += dxdy;
-  (*hess)(dims1_.second, dims1_.second) += ddy;
-
-  (*hess)(dims2_.first, dims2_.first) += ddx;
-  (*hess)(dims2_.first, dims2_.second) += dxdy;
-  (*hess)(dims2_.second, dims2_.first) += dxdy;
-  (*hess)(dims2_.second, dims2_.second) += ddy;
-
-  (*hess)(dims1_.first, dims2_.first) -= ddx;
-  (*hess)(dims1_.first, dims2_.second) -= dxdy;
-  (*hess)(dims1_.second, dims2_.first) -= dxdy;
-  (*hess)(dims1_.second, dims2_.second) -= ddy;
-
-  (*hess)(dims2_.first, dims1_.first) -= ddx;
-  (*hess)(dims2_.first, dims1_.second) -= dxdy;
-  (*hess)(dims2_.second, dims1_.first) -= dxdy;
-  (*hess)(dims2_.second, dims1_.second) -= ddy;
+  if (hess) {
+    (*hess)(dims1_.first, dims1_.first) += ddx;
+    (*hess)(dims1_.first, dims1_.second) += dxdy;
+    (*hess)(dims1_.second, dims1_.first) += dxdy;
+    (*hess)(dims1_.second, dims1_.second) += ddy;
+
+    (*hess)(dims2_.first, dims2_.first) += ddx;
+    (*hess)(dims2_.first, dims2_.second) += dxdy;
+    (*hess)(dims2_.second, dims2_.first) += dxdy;
+    (*hess)(dims2_.second, dims2_.second) += ddy;
+
+    (*hess)(dims1_.first, dims2_.first) -= ddx;
+    (*hess)(dims1_.first, dims2_.second) -= dxdy;
+    (*hess)(dims1_.second, dims2_.first) -= dxdy;
+    (*hess)(dims1_.second, dims2_.second) -= ddy;
+
+    (*hess)(dims2_.first, dims1_.first) -= ddx;
+    (*hess)(dims2_.first, dims1_.second) -= dxdy;
+    (*hess)(dims2_.second, dims1_.first) -= dxdy;
+    (*hess)(dims2_.second, dims1_.second) -= ddy;
+  }
 
   if (grad) {
     const float dx = weight_ * diff_x / dist;
@@ -214,14 +214,14 @@ void RoundaboutMergingExample::ConstructInitialState() {
 
 void RoundaboutMergingExample::ConstructInitialOperatingPoint() {
   // Initialize operating points to follow these lanes at the nominal speed.
-  // InitializeAlongRoute(lane1, 0.0, kP1InitialSpeed, {kP1XIdx, kP1YIdx},
-  //                      operating_point_.get());
-  // InitializeAlongRoute(lane2, 0.0, kP2InitialSpeed, {kP2XIdx, kP2YIdx},
-  //                      operating_point_.get());
-  // InitializeAlongRoute(lane3, 0.0, kP3InitialSpeed, {kP3XIdx, kP3YIdx},
-  //                      operating_point_.get());
-  // InitializeAlongRoute(lane4, 0.0, kP4InitialSpeed, {kP4XIdx, kP4YIdx},
-  //                      operating_point_.get());
+  // InitializeAlongRoute(lane1, 0.0, kP1InitialSpeed, time_step_,
+  //                      {kP1XIdx, kP1YIdx}, operating_point_.get());
+  // InitializeAlongRoute(lane2, 0.0, kP2InitialSpeed, time_step_,
+  //                      {kP2XIdx, kP2YIdx}, operating_point_.get());
+  // InitializeAlongRoute(lane3, 0.0, kP3InitialSpeed, time_step_,
+  //                      {kP3XIdx, kP3YIdx}, operating_point_.get());
+  // InitializeAlongRoute(lane4, 0.0, kP4InitialSpeed, time_step_,
+  //                      {kP4XIdx, kP4YIdx}, operating_point_.get());
   Problem::ConstructInitialOperatingPoint();
 }
 
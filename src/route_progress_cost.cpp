@@ -68,10 +68,11 @@ void RouteProgressCost::Quadraticize(Time t, const VectorXf& input,
   CHECK_LT(xidx_, input.size());
   CHECK_LT(yidx_, input.size());
 
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Unpack current position and find closest point / segment.
@@ -95,10 +96,12 @@ void RouteProgressCost::Quadraticize(Time t, const VectorXf& input,
   (*grad)(xidx_) += dx;
   (*grad)(yidx_) += dy;
 
-  (*hess)(xidx_, xidx_) += ddx;
-  (*hess)(yidx_, yidx_) += ddy;
-  (*hess)(xidx_, yidx_) += dxdy;
-  (*hess)(yidx_, xidx_) += dxdy;
+  if (hess) {
+    (*hess)(xidx_, xidx_) += ddx;
+    (*hess)(yidx_, yidx_) += ddy;
+    (*hess)(xidx_, yidx_) += dxdy;
+    (*hess)(yidx_, xidx_) += dxdy;
+  }
 }
 
 }  // namespace ilqgames
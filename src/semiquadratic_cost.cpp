@@ -70,10 +70,11 @@ void SemiquadraticCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
     return;
 
   // Check dimensions.
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Compute gradient and Hessian.
@@ -81,7 +82,7 @@ void SemiquadraticCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
   const float ddx = weight_;
 
   (*grad)(dimension_) += dx;
-  (*hess)(dimension_, dimension_) += ddx;
+  if (hess) (*hess)(dimension_, dimension_) += ddx;
 }
 
 }  // namespace ilqgames
@@ -68,12 +68,13 @@ void SignedDistanceCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
   CHECK_LT(ydim1_, input.size());
   CHECK_LT(xdim2_, input.size());
   CHECK_LT(ydim2_, input.size());
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
 
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Compute gradient and Hessian.
@@ -94,22 +95,24 @@ void SignedDistanceCost::Quadraticize(const VectorXf& input, MatrixXf* hess,
   (*grad)(xdim2_) -= dx1;
   (*grad)(ydim2_) -= dy1;
 
-  (*hess)(xdim1_, xdim1_) += ddx1;
-  (*hess)(ydim1_, ydim1_) += ddy1;
-  (*hess)(xdim1_, ydim1_) += dx1dy1;
-  (*hess)(ydim1_, xdim1_) += dx1dy1;
-  (*hess)(xdim2_, xdim2_) += ddx1;
-  (*hess)(ydim2_, ydim2_) += ddy1;
-  (*hess)(xdim2_, ydim2_) += dx1dy1;
-  (*hess)(ydim2_, xdim2_) += dx1dy1;
-  (*hess)(xdim1_, xdim2_) -= ddx1;
-  (*hess)(xdim1_, ydim2_) -= dx1dy1;
-  (*hess)(ydim1_, xdim2_) -= dx1dy1;
-  (*hess)(ydim1_, ydim2_) -= ddy1;
-  (*hess)(xdim2_, xdim1_) -= ddx1;
-  (*hess)(xdim2_, ydim1_) -= dx1dy1;
-  (*hess)(ydim2_, xdim1_) -= dx1dy1;
-  (*hess)(ydim2_, ydim1_) -= ddy1;
+  if (hess) {
+    (*hess)(xdim1_, xdim1_) += ddx1;
+    (*hess)(ydim1_, ydim1_) += ddy1;
+    (*hess)(xdim1_, ydim1_) += dx1dy1;
+    (*hess)(ydim1_, xdim1_) += dx1dy1;
+    (*hess)(xdim2_, xdim2_) += ddx1;
+    (*hess)(ydim2_, ydim2_) += ddy1;
+    (*hess)(xdim2_, ydim2_) += dx1dy1;
+    (*hess)(ydim2_, xdim2_) += dx1dy1;
+    (*hess)(xdim1_, xdim2_) -= ddx1;
+    (*hess)(xdim1_, ydim2_) -= dx1dy1;
+    (*hess)(ydim1_, xdim2_) -= dx1dy1;
+    (*hess)(ydim1_, ydim2_) -= ddy1;
+    (*hess)(xdim2_, xdim1_) -= ddx1;
+    (*hess)(xdim2_, ydim1_) -= dx1dy1;
+    (*hess)(ydim2_, xdim1_) -= dx1dy1;
+    (*hess)(ydim2_, ydim1_) -= ddy1;
+  }
 }
 
 }  // namespace ilqgames
@@ -48,23 +48,27 @@
 #include <ilqgames/utils/types.h>
 
 #include <glog/logging.h>
+#include <algorithm>
 #include <memory>
 #include <vector>
 
 namespace ilqgames {
 
 SolutionSplicer::SolutionSplicer(const SolverLog& log)
-    : strategies_(log.FinalStrategies()),
+    : time_grid_(log.Grid()),
+      strategies_(log.FinalStrategies()),
       operating_point_(log.FinalOperatingPoint()) {}
 
-void SolutionSplicer::Splice(const SolverLog& log) {
+size_t SolutionSplicer::CurrentTimestep(const SolverLog& log) const {
   CHECK_GE(log.FinalOperatingPoint().t0, operating_point_.t0);
-  CHECK_GE(operating_point_.xs.size(), time::kNumTimeSteps);
-  CHECK_EQ(log.FinalOperatingPoint().xs.size(), time::kNumTimeSteps);
 
-  const size_t current_timestep = static_cast<size_t>(
-      1e-4 +  // Add a little so that conversion doesn't end up subtracting 1.
-      (log.FinalOperatingPoint().t0 - operating_point_.t0) / time::kTimeStep);
+  // Add a little so that conversion doesn't end up subtracting 1.
+  return time_grid_.Index(1e-4 * time_grid_.TimeStep(0) +
+                          log.FinalOperatingPoint().t0 - operating_point_.t0);
+}
+
+void SolutionSplicer::Splice(const SolverLog& log) {
+  const size_t current_timestep = CurrentTimestep(log);
 
   // HACK! If we're close enough to the beginning of the old trajectory, just
   // save the first few steps along it in case a lower-level path follower uses
@@ -76,6 +80,29 @@ void SolutionSplicer::Splice(const SolverLog& log) {
           ? 0
           : current_timestep - kNumPreviousTimeStepsToSave;
 
+  Splice(log, initial_timestep, current_timestep);
+}
+
+void SolutionSplicer::Splice(const SolverLog& log, Time current_time) {
+  const size_t current_timestep = CurrentTimestep(log);
+
+  // Keep everything from the timestep containing the current time.
+  const size_t initial_timestep =
+      (current_time <= operating_point_.t0)
+          ? 0
+          : std::min(current_timestep,
+                     time_grid_.Index(current_time - operating_point_.t0));
+
+  Splice(log, initial_timestep, current_timestep);
+}
+
+void SolutionSplicer::Splice(const SolverLog& log, size_t initial_timestep,
+                             size_t current_timestep) {
+  CHECK_LE(initial_timestep, current_timestep);
+
+  const size_t num_time_steps = log.NumTimeSteps();
+  CHECK_GE(operating_point_.xs.size(), num_time_steps);
+
   // HACK! Make sure the new solution starts several timesteps after the
   // nearest match to guard against off-by-one issues.
   constexpr size_t kNumExtraTimeStepsBeforeSplicingIn = 0;
@@ -98,13 +125,13 @@ void SolutionSplicer::Splice(const SolverLog& log) {
   // NOTE: makes use of default behavior of std::vector<T>.resize() in that it
   // does not delete earlier entries.
   const size_t num_spliced_timesteps =
-      current_timestep - initial_timestep + time::kNumTimeSteps;
-  CHECK_LE(num_spliced_timesteps,
-           time::kNumTimeSteps + kNumPreviousTimeStepsToSave);
+      current_timestep - initial_timestep + num_time_steps;
 
   operating_point_.xs.resize(num_spliced_timesteps);
   operating_point_.us.resize(num_spliced_timesteps);
-  operating_point_.t0 += initial_timestep * time::kTimeStep;
+  operating_point_.t0 += time_grid_.Duration(0, initial_timestep);
+  time_grid_ =
+      time_grid_.Splice(initial_timestep, current_timestep, log.Grid());
 
   for (auto& strategy : strategies_) {
     strategy.Ps.resize(num_spliced_timesteps);
@@ -112,9 +139,9 @@ void SolutionSplicer::Splice(const SolverLog& log) {
   }
 
   // Copy over new solution to overwrite existing log after first timestep.
-  CHECK_EQ(current_timestep + time::kNumTimeSteps - initial_timestep,
+  CHECK_EQ(current_timestep + num_time_steps - initial_timestep,
            operating_point_.xs.size());
-  for (size_t kk = kNumExtraTimeStepsBeforeSplicingIn; kk < time::kNumTimeSteps;
+  for (size_t kk = kNumExtraTimeStepsBeforeSplicingIn; kk < num_time_steps;
        kk++) {
     const size_t kk_new_solution = current_timestep + kk - initial_timestep;
     operating_point_.xs[kk_new_solution] = log.FinalOperatingPoint().xs[kk];
@@ -43,6 +43,7 @@
 #include <ilqgames/utils/make_directory.h>
 #include <ilqgames/utils/operating_point.h>
 #include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/solver_telemetry.h>
 #include <ilqgames/utils/strategy.h>
 #include <ilqgames/utils/types.h>
 #include <ilqgames/utils/uncopyable.h>
@@ -53,8 +54,10 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <chrono>
+#include <algorithm>
 #include <ctime>
 #include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <regex>
 
@@ -68,7 +71,7 @@ VectorXf SolverLog::InterpolateState(size_t iterate, Time t) const {
   const size_t hi = std::min(lo + 1, op.xs.size() - 1);
 
   // Fraction of the way between lo and hi.
-  const float frac = (t - IndexToTime(lo)) / time::kTimeStep;
+  const float frac = (t - IndexToTime(lo)) / TimeStep(lo);
   return (1.0 - frac) * op.xs[lo] + frac * op.xs[hi];
 }
 
@@ -80,7 +83,7 @@ float SolverLog::InterpolateState(size_t iterate, Time t, Dimension dim) const {
   const size_t hi = std::min(lo + 1, op.xs.size() - 1);
 
   // Fraction of the way between lo and hi.
-  const float frac = (t - IndexToTime(lo)) / time::kTimeStep;
+  const float frac = (t - IndexToTime(lo)) / TimeStep(lo);
   return (1.0 - frac) * op.xs[lo](dim) + frac * op.xs[hi](dim);
 }
 
@@ -93,7 +96,7 @@ VectorXf SolverLog::InterpolateControl(size_t iterate, Time t,
   const size_t hi = std::min(lo + 1, op.xs.size() - 1);
 
   // Fraction of the way between lo and hi.
-  const float frac = (t - IndexToTime(lo)) / time::kTimeStep;
+  const float frac = (t - IndexToTime(lo)) / TimeStep(lo);
   return (1.0 - frac) * op.us[lo][player] + frac * op.us[hi][player];
 }
 
@@ -106,7 +109,7 @@ float SolverLog::InterpolateControl(size_t iterate, Time t, PlayerIndex player,
   const size_t hi = std::min(lo + 1, op.xs.size() - 1);
 
   // Fraction of the way between lo and hi.
-  const float frac = (t - IndexToTime(lo)) / time::kTimeStep;
+  const float frac = (t - IndexToTime(lo)) / TimeStep(lo);
   return (1.0 - frac) * op.us[lo][player](dim) + frac * op.us[hi][player](dim);
 }
 
@@ -118,6 +121,10 @@ bool SolverLog::Save(bool only_last_trajectory,
   if (!MakeDirectory(dir_name)) return false;
   LOG(INFO) << "Saving to directory: " << dir_name;
 
+  // Dump trace events, if any.
+  if (!trace_events_.empty() && !SaveChromeTrace(dir_name + "/trace.json"))
+    return false;
+
   size_t start = 0;
   if (only_last_trajectory) start = operating_points_.size() - 1;
 
@@ -151,6 +158,23 @@ bool SolverLog::Save(bool only_last_trajectory,
     file << cumulative_runtimes_[ii] << std::endl;
     file.close();
 
+    // Dump telemetry, one "name value" pair per line.
+    const IterateTelemetry& telemetry = telemetry_[ii];
+    file.open(sub_dir_name + "/telemetry.txt");
+    file << "linearization_time " << telemetry.linearization_time << std::endl;
+    file << "quadraticization_time " << telemetry.quadraticization_time
+         << std::endl;
+    file << "lq_solve_time " << telemetry.lq_solve_time << std::endl;
+    file << "rollout_time " << telemetry.rollout_time << std::endl;
+    file << "linesearch_time " << telemetry.linesearch_time << std::endl;
+    file << "num_backtracking_steps " << telemetry.num_backtracking_steps
+         << std::endl;
+    file << "merit_function_value " << telemetry.merit_function_value
+         << std::endl;
+    file << "expected_decrease " << telemetry.expected_decrease << std::endl;
+    file << "step_size " << telemetry.step_size << std::endl;
+    file.close();
+
     // Dump us.
     std::vector<std::ofstream> files(NumPlayers());
     for (size_t jj = 0; jj < files.size(); jj++) {
@@ -170,6 +194,42 @@ bool SolverLog::Save(bool only_last_trajectory,
   return true;
 }
 
+bool SolverLog::SaveChromeTrace(const std::string& filename) const {
+  std::ofstream file(filename);
+  if (!file.is_open()) {
+    LOG(WARNING) << "Could not open trace file: " << filename;
+    return false;
+  }
+
+  // Measure times from the first event to start, in microseconds. All events
+  // are complete ("X") events on a single thread.
+  const auto origin =
+      trace_events_.empty()
+          ? Clock::now()
+          : std::min_element(trace_events_.begin(), trace_events_.end(),
+                             [](const TraceEvent& e1, const TraceEvent& e2) {
+                               return e1.start < e2.start;
+                             })
+                ->start;
+  constexpr double kMicrosecondsPerSecond = 1e6;
+
+  file << std::fixed << std::setprecision(3);
+  file << "{\"traceEvents\":[";
+  for (size_t ii = 0; ii < trace_events_.size(); ii++) {
+    const TraceEvent& event = trace_events_[ii];
+    const double start =
+        std::chrono::duration<double>(event.start - origin).count();
+    file << ((ii > 0) ? ",\n" : "\n") << "{\"name\":\"" << event.name
+         << "\",\"cat\":\"ilqgames\",\"ph\":\"X\",\"ts\":"
+         << kMicrosecondsPerSecond * start
+         << ",\"dur\":" << kMicrosecondsPerSecond * event.duration
+         << ",\"pid\":0,\"tid\":0}";
+  }
+  file << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+
+  return file.good();
+}
+
 inline std::vector<MatrixXf> SolverLog::Ps(size_t iterate,
                                            size_t time_index) const {
   std::vector<MatrixXf> Ps(strategies_[iterate].size());
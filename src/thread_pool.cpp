@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Fixed-size pool of worker threads for data-parallel loops. Work is split into
+// contiguous blocks of indices, one per thread, so that every index is always
+// handled exactly once.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/utils/thread_pool.h>
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ilqgames {
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  work_available_.notify_all();
+
+  for (auto& worker : workers_) worker.join();
+}
+
+ThreadPool::ThreadPool(size_t num_threads)
+    : task_(nullptr),
+      num_tasks_(0),
+      generation_(0),
+      num_pending_(0),
+      shutdown_(false) {
+  CHECK_GT(num_threads, 0);
+
+  // The calling thread handles block 0, so spawn one fewer worker.
+  for (size_t ii = 1; ii < num_threads; ii++)
+    workers_.emplace_back(&ThreadPool::WorkerLoop, this, ii);
+}
+
+void ThreadPool::ParallelFor(size_t num_tasks,
+                             const std::function<void(size_t)>& f) {
+  // Skip synchronization if there is nothing to split.
+  if (workers_.empty() || num_tasks <= 1) {
+    for (size_t ii = 0; ii < num_tasks; ii++) f(ii);
+    return;
+  }
+
+  // Publish the new task and wake up workers.
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &f;
+    num_tasks_ = num_tasks;
+    num_pending_ = workers_.size();
+    generation_++;
+  }
+  work_available_.notify_all();
+
+  // Do our share of the work, then wait for everyone else.
+  RunBlock(0);
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  work_done_.wait(lock, [this]() { return num_pending_ == 0; });
+  task_ = nullptr;
+}
+
+void ThreadPool::RunBlock(size_t block_idx) const {
+  // Split [0, num_tasks_) into NumThreads() contiguous blocks whose sizes
+  // differ by at most one.
+  const size_t num_blocks = NumThreads();
+  const size_t start = (block_idx * num_tasks_) / num_blocks;
+  const size_t end = ((block_idx + 1) * num_tasks_) / num_blocks;
+  for (size_t ii = start; ii < end; ii++) (*task_)(ii);
+}
+
+void ThreadPool::WorkerLoop(size_t block_idx) {
+  size_t last_generation = 0;
+  while (true) {
+    // Wait for new work or shutdown.
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      work_available_.wait(lock, [this, &last_generation]() {
+        return shutdown_ || generation_ != last_generation;
+      });
+      if (shutdown_) return;
+      last_generation = generation_;
+    }
+
+    RunBlock(block_idx);
+
+    // Signal completion.
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      num_pending_--;
+    }
+    work_done_.notify_one();
+  }
+}
+
+}  // namespace ilqgames
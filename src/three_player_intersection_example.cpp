@@ -54,7 +54,7 @@
 #include <ilqgames/cost/semiquadratic_cost.h>
 #include <ilqgames/cost/semiquadratic_polyline2_cost.h>
 #include <ilqgames/cost/weighted_convex_proximity_cost.h>
-#include <ilqgames/dynamics/concatenated_dynamical_system.h>
+#include <ilqgames/dynamics/fixed_size_concatenated_dynamical_system.h>
 #include <ilqgames/dynamics/single_player_car_5d.h>
 #include <ilqgames/dynamics/single_player_car_6d.h>
 #include <ilqgames/dynamics/single_player_unicycle_4d.h>
@@ -164,9 +164,9 @@ static const Dimension kP3AIdx = 1;
 }  // anonymous namespace
 
 void ThreePlayerIntersectionExample::ConstructDynamics() {
-  dynamics_.reset(new ConcatenatedDynamicalSystem(
-      {std::make_shared<P1>(kInterAxleLength),
-       std::make_shared<P2>(kInterAxleLength), std::make_shared<P3>()}));
+  // All subsystem types are known at compile time, so use fixed-size blocks.
+  dynamics_.reset(new FixedSizeConcatenatedDynamicalSystem<P1, P2, P3>(
+      P1(kInterAxleLength), P2(kInterAxleLength), P3()));
 }
 
 void ThreePlayerIntersectionExample::ConstructInitialState() {
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+///////////////////////////////////////////////////////////////////////////////
+//
+// Time discretization of a problem's horizon. A grid may either be uniform,
+// with a single time step, or non-uniform, with an arbitrary sequence of time
+// steps.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/utils/time_grid.h>
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace ilqgames {
+
+TimeGrid::TimeGrid(Time time_step) : time_step_(time_step) {
+  CHECK_GT(time_step_, 0.0);
+}
+
+TimeGrid::TimeGrid(const std::vector<Time>& time_steps)
+    : time_step_(0.0), time_steps_(time_steps) {
+  CHECK(!time_steps_.empty());
+
+  times_.resize(time_steps_.size() + 1);
+  times_[0] = 0.0;
+  for (size_t kk = 0; kk < time_steps_.size(); kk++) {
+    CHECK_GT(time_steps_[kk], 0.0);
+    times_[kk + 1] = times_[kk] + time_steps_[kk];
+  }
+}
+
+TimeGrid TimeGrid::Graded(Time initial_time_step, Time final_time_step,
+                          Time time_horizon) {
+  CHECK_GT(initial_time_step, 0.0);
+  CHECK_GT(final_time_step, 0.0);
+  CHECK_GE(time_horizon, std::max(initial_time_step, final_time_step));
+
+  // Choose the number of steps so that the average time step is as close as
+  // possible to the average of the initial and final time steps.
+  const size_t num_time_steps = std::max<size_t>(
+      2, std::lround(2.0 * time_horizon /
+                     (initial_time_step + final_time_step)));
+
+  std::vector<Time> time_steps(num_time_steps);
+  Time total_time = 0.0;
+  for (size_t kk = 0; kk < num_time_steps; kk++) {
+    const Time frac =
+        static_cast<Time>(kk) / static_cast<Time>(num_time_steps - 1);
+    time_steps[kk] = (1.0 - frac) * initial_time_step + frac * final_time_step;
+    total_time += time_steps[kk];
+  }
+
+  // Rescale to span the horizon exactly.
+  for (auto& time_step : time_steps) time_step *= time_horizon / total_time;
+  return TimeGrid(time_steps);
+}
+
+TimeGrid TimeGrid::Splice(size_t first, size_t last,
+                          const TimeGrid& next) const {
+  CHECK_LE(first, last);
+  if (IsUniform() && next.IsUniform() && time_step_ == next.time_step_)
+    return *this;
+
+  std::vector<Time> time_steps;
+  for (size_t kk = first; kk < last; kk++) time_steps.push_back(TimeStep(kk));
+  if (next.IsUniform())
+    time_steps.push_back(next.time_step_);
+  else {
+    time_steps.insert(time_steps.end(), next.time_steps_.begin(),
+                      next.time_steps_.end());
+  }
+
+  return TimeGrid(time_steps);
+}
+
+size_t TimeGrid::Index(Time relative_t) const {
+  if (IsUniform()) return static_cast<size_t>(relative_t / time_step_);
+  if (relative_t <= 0.0) return 0;
+
+  // Past the explicit time steps, continue uniformly.
+  const size_t num_explicit_steps = time_steps_.size();
+  if (relative_t >= times_.back()) {
+    return num_explicit_steps +
+           static_cast<size_t>((relative_t - times_.back()) /
+                               time_steps_.back());
+  }
+
+  // Otherwise, find the last start time no later than `relative_t`.
+  return std::distance(
+             times_.begin(),
+             std::upper_bound(times_.begin(), times_.end(), relative_t)) -
+         1;
+}
+
+size_t TimeGrid::NumTimeStepsWithin(size_t kk, Time duration) const {
+  if (IsUniform())
+    return static_cast<size_t>(constants::kSmallNumber + duration / time_step_);
+
+  size_t num_time_steps = 0;
+  Time elapsed = 0.0;
+  while (elapsed + TimeStep(kk + num_time_steps) <=
+         duration + constants::kSmallNumber * TimeStep(kk + num_time_steps)) {
+    elapsed += TimeStep(kk + num_time_steps);
+    num_time_steps++;
+  }
+
+  return num_time_steps;
+}
+
+}  // namespace ilqgames
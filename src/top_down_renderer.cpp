@@ -120,16 +120,16 @@ void TopDownRenderer::Render() {
     const auto& log = logs[problem_idx];
 
     // (1) Draw this trajectory iterate.
-    std::vector<ImVec2> points(time::kNumTimeSteps);
+    std::vector<ImVec2> points(log->NumTimeSteps());
     for (size_t ii = 0; ii < num_agents[problem_idx]; ii++) {
-      for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
+      for (size_t kk = 0; kk < points.size(); kk++) {
         const VectorXf x = log->State(sliders_->SolverIterate(problem_idx), kk);
         points[kk] =
             PositionToWindowCoordinates(problem->Xs(x)[ii], problem->Ys(x)[ii]);
       }
 
       constexpr bool kPolylineIsClosed = false;
-      draw_list->AddPolyline(points.data(), time::kNumTimeSteps,
+      draw_list->AddPolyline(points.data(), points.size(),
                              trajectory_color, kPolylineIsClosed,
                              trajectory_thickness);
     }
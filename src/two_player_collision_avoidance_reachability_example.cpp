@@ -136,8 +136,8 @@ void TwoPlayerCollisionAvoidanceReachabilityExample::ConstructPlayerCosts() {
 
   // NOTE: Assumes line segments traced by each player at initialization do not
   // intersect.
-  const float nominal_distance = (p1_position(0.5 * time::kTimeHorizon) -
-                                  p2_position(0.5 * time::kTimeHorizon))
+  const float nominal_distance = (p1_position(0.5 * time_horizon_) -
+                                  p2_position(0.5 * time_horizon_))
                                      .norm();
   const std::shared_ptr<SignedDistanceCost> collision_avoidance_cost(
       new SignedDistanceCost({kP1XIdx, kP1YIdx}, {kP2XIdx, kP2YIdx},
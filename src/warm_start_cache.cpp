@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Cache of previously-computed equilibria, keyed by the initial state from
+// which they were computed.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/dynamics/multi_player_integrable_system.h>
+#include <ilqgames/solver/problem.h>
+#include <ilqgames/solver/warm_start_cache.h>
+#include <ilqgames/utils/operating_point.h>
+#include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/types.h>
+
+#include <glog/logging.h>
+#include <memory>
+#include <vector>
+
+namespace ilqgames {
+
+WarmStartCache::WarmStartCache(
+    const std::shared_ptr<const MultiPlayerIntegrableSystem>& dynamics,
+    size_t max_entries, const VectorXf& state_weights)
+    : dynamics_(dynamics),
+      state_weights_(state_weights),
+      max_entries_(max_entries),
+      next_entry_(0) {
+  CHECK_NOTNULL(dynamics_.get());
+  CHECK_GT(max_entries_, 0);
+  CHECK(state_weights_.size() == 0 ||
+        state_weights_.size() == dynamics_->XDim());
+  CHECK(state_weights_.size() == 0 || state_weights_.minCoeff() >= 0.0);
+
+  entries_.reserve(max_entries_);
+}
+
+bool WarmStartCache::Add(const SolverLog& log, bool require_converged) {
+  if (require_converged && log.Quality() != CONVERGED) return false;
+
+  const OperatingPoint& operating_point = log.FinalOperatingPoint();
+  CHECK(!operating_point.xs.empty());
+  Add(operating_point.xs.front(), operating_point, log.FinalStrategies());
+  return true;
+}
+
+void WarmStartCache::Add(const VectorXf& x0,
+                         const OperatingPoint& operating_point,
+                         const std::vector<Strategy>& strategies) {
+  CHECK_EQ(x0.size(), dynamics_->XDim());
+  CHECK_EQ(strategies.size(), dynamics_->NumPlayers());
+
+  // Append until full, then overwrite the oldest entry.
+  Entry* entry;
+  if (entries_.size() < max_entries_) {
+    entries_.push_back({x0, operating_point, strategies});
+    entry = &entries_.back();
+  } else {
+    entry = &entries_[next_entry_];
+    entry->x0 = x0;
+    entry->operating_point = operating_point;
+    entry->strategies = strategies;
+    next_entry_ = (next_entry_ + 1) % max_entries_;
+  }
+
+  // Zero out the feedforward terms so that, from the cached initial state,
+  // these strategies reproduce the cached operating point exactly. Otherwise
+  // the solver would start by taking the last step again.
+  for (auto& strategy : entry->strategies) {
+    for (auto& alpha : strategy.alphas) alpha.setZero();
+  }
+}
+
+const WarmStartCache::Entry* WarmStartCache::Nearest(const VectorXf& x0,
+                                                     float max_distance) const {
+  const Entry* nearest = nullptr;
+  float nearest_distance = max_distance;
+  for (const auto& entry : entries_) {
+    const float distance = Distance(x0, entry.x0);
+    if (distance <= nearest_distance) {
+      nearest = &entry;
+      nearest_distance = distance;
+    }
+  }
+
+  return nearest;
+}
+
+bool WarmStartCache::WarmStart(Problem* problem, float max_distance) const {
+  CHECK_NOTNULL(problem);
+
+  const Entry* nearest = Nearest(problem->InitialState(), max_distance);
+  if (!nearest) return false;
+
+  CHECK_EQ(nearest->operating_point.xs.size(), problem->NumTimeSteps());
+
+  // Keep the problem's initial time so that time-varying costs are evaluated
+  // at the right times.
+  const Time t0 = problem->InitialTime();
+  problem->OverwriteSolution(nearest->operating_point, nearest->strategies);
+  problem->ResetInitialTime(t0);
+  return true;
+}
+
+float WarmStartCache::Distance(const VectorXf& x0, const VectorXf& x1) const {
+  if (state_weights_.size() == 0) return dynamics_->DistanceBetween(x0, x1);
+  return state_weights_.dot((x0 - x1).cwiseAbs2());
+}
+
+}  // namespace ilqgames
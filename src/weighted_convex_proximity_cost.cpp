@@ -64,12 +64,13 @@ float WeightedConvexProximityCost::Evaluate(const VectorXf& input) const {
 void WeightedConvexProximityCost::Quadraticize(const VectorXf& input,
                                                MatrixXf* hess,
                                                VectorXf* grad) const {
-  CHECK_NOTNULL(hess);
   CHECK_NOTNULL(grad);
 
   // Check dimensions.
-  CHECK_EQ(input.size(), hess->rows());
-  CHECK_EQ(input.size(), hess->cols());
+  if (hess) {
+    CHECK_EQ(input.size(), hess->rows());
+    CHECK_EQ(input.size(), hess->cols());
+  }
   CHECK_EQ(input.size(), grad->size());
 
   // Compute Hessian and gradient.
@@ -98,22 +99,24 @@ void WeightedConvexProximityCost::Quadraticize(const VectorXf& input,
     const float dx1dv2 = -2.0 * weight_ * input(vidx2_) * sgn(dx);
 
     // Hessian.
-    (*hess)(xidx1_, xidx1_) += ddx1;
-    (*hess)(xidx1_, xidx2_) -= ddx1;
-    (*hess)(xidx2_, xidx1_) -= ddx1;
-    (*hess)(xidx2_, xidx2_) += ddx1;
-    (*hess)(xidx1_, vidx1_) += dx1dv1;
-    (*hess)(xidx1_, vidx2_) += dx1dv2;
-    (*hess)(xidx2_, vidx1_) -= dx1dv1;
-    (*hess)(xidx2_, vidx2_) -= dx1dv2;
-    (*hess)(vidx1_, xidx1_) += dx1dv1;
-    (*hess)(vidx1_, xidx2_) -= dx1dv1;
-    (*hess)(vidx1_, vidx1_) += ddv1;
-    (*hess)(vidx1_, vidx2_) += dv1dv2;
-    (*hess)(vidx2_, xidx1_) += dx1dv2;
-    (*hess)(vidx2_, xidx2_) -= dx1dv2;
-    (*hess)(vidx2_, vidx1_) += dv1dv2;
-    (*hess)(vidx2_, vidx2_) += ddv2;
+    if (hess) {
+      (*hess)(xidx1_, xidx1_) += ddx1;
+      (*hess)(xidx1_, xidx2_) -= ddx1;
+      (*hess)(xidx2_, xidx1_) -= ddx1;
+      (*hess)(xidx2_, xidx2_) += ddx1;
+      (*hess)(xidx1_, vidx1_) += dx1dv1;
+      (*hess)(xidx1_, vidx2_) += dx1dv2;
+      (*hess)(xidx2_, vidx1_) -= dx1dv1;
+      (*hess)(xidx2_, vidx2_) -= dx1dv2;
+      (*hess)(vidx1_, xidx1_) += dx1dv1;
+      (*hess)(vidx1_, xidx2_) -= dx1dv1;
+      (*hess)(vidx1_, vidx1_) += ddv1;
+      (*hess)(vidx1_, vidx2_) += dv1dv2;
+      (*hess)(vidx2_, xidx1_) += dx1dv2;
+      (*hess)(vidx2_, xidx2_) -= dx1dv2;
+      (*hess)(vidx2_, vidx1_) += dv1dv2;
+      (*hess)(vidx2_, vidx2_) += ddv2;
+    }
 
     // Gradient.
     (*grad)(xidx1_) += dx1;
@@ -131,22 +134,24 @@ void WeightedConvexProximityCost::Quadraticize(const VectorXf& input,
     const float dy1dv2 = -2.0 * weight_ * input(vidx2_) * sgn(dy);
 
     // Hessian.
-    (*hess)(yidx1_, yidx1_) += ddy1;
-    (*hess)(yidx1_, yidx2_) -= ddy1;
-    (*hess)(yidx2_, yidx1_) -= ddy1;
-    (*hess)(yidx2_, yidx2_) += ddy1;
-    (*hess)(yidx1_, vidx1_) += dy1dv1;
-    (*hess)(yidx1_, vidx2_) += dy1dv2;
-    (*hess)(yidx2_, vidx1_) -= dy1dv1;
-    (*hess)(yidx2_, vidx2_) -= dy1dv2;
-    (*hess)(vidx1_, yidx1_) += dy1dv1;
-    (*hess)(vidx1_, yidx2_) -= dy1dv1;
-    (*hess)(vidx1_, vidx1_) += ddv1;
-    (*hess)(vidx1_, vidx2_) += dv1dv2;
-    (*hess)(vidx2_, yidx1_) += dy1dv2;
-    (*hess)(vidx2_, yidx2_) -= dy1dv2;
-    (*hess)(vidx2_, vidx1_) += dv1dv2;
-    (*hess)(vidx2_, vidx2_) += ddv2;
+    if (hess) {
+      (*hess)(yidx1_, yidx1_) += ddy1;
+      (*hess)(yidx1_, yidx2_) -= ddy1;
+      (*hess)(yidx2_, yidx1_) -= ddy1;
+      (*hess)(yidx2_, yidx2_) += ddy1;
+      (*hess)(yidx1_, vidx1_) += dy1dv1;
+      (*hess)(yidx1_, vidx2_) += dy1dv2;
+      (*hess)(yidx2_, vidx1_) -= dy1dv1;
+      (*hess)(yidx2_, vidx2_) -= dy1dv2;
+      (*hess)(vidx1_, yidx1_) += dy1dv1;
+      (*hess)(vidx1_, yidx2_) -= dy1dv1;
+      (*hess)(vidx1_, vidx1_) += ddv1;
+      (*hess)(vidx1_, vidx2_) += dv1dv2;
+      (*hess)(vidx2_, yidx1_) += dy1dv2;
+      (*hess)(vidx2_, yidx2_) -= dy1dv2;
+      (*hess)(vidx2_, vidx1_) += dv1dv2;
+      (*hess)(vidx2_, vidx2_) += ddv2;
+    }
 
     // Gradient.
     (*grad)(yidx1_) += dy1;
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+///////////////////////////////////////////////////////////////////////////////
+//
+// Counts heap allocations by replacing the global `malloc` family (which both
+// `operator new` and Eigen use under the hood) with versions that count calls
+// while enabled. `malloc`, `calloc`, `realloc`, `memalign`, `aligned_alloc`,
+// and `posix_memalign` are counted, while other glibc extensions (`valloc`,
+// `pvalloc`, `reallocarray`) are not. Since this relies on glibc internals,
+// allocations are only counted on glibc platforms (see
+// `kCanCountAllocations`).
+//
+// NOTE: this header replaces the process allocator, so it is only for tests and
+// benchmarks and is not installed with the library. It must be included in
+// exactly one translation unit of any binary which uses it.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef ILQGAMES_TEST_ALLOCATION_COUNTER_H
+#define ILQGAMES_TEST_ALLOCATION_COUNTER_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+
+namespace ilqgames {
+
+#ifdef __GLIBC__
+static constexpr bool kCanCountAllocations = true;
+#else
+static constexpr bool kCanCountAllocations = false;
+#endif
+
+namespace allocation_counter {
+// Whether to count allocations, and how many have been counted.
+inline std::atomic<bool> counting(false);
+inline std::atomic<size_t> num_allocations(0);
+
+inline void MaybeCount() {
+  if (counting.load(std::memory_order_relaxed))
+    num_allocations.fetch_add(1, std::memory_order_relaxed);
+}
+}  // namespace allocation_counter
+
+// Start counting allocations (on all threads) from zero.
+inline void StartCountingAllocations() {
+  allocation_counter::num_allocations = 0;
+  allocation_counter::counting = true;
+}
+
+// Stop counting allocations and return how many were counted since the last
+// call to `StartCountingAllocations`.
+inline size_t StopCountingAllocations() {
+  allocation_counter::counting = false;
+  return allocation_counter::num_allocations;
+}
+
+}  // namespace ilqgames
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+void* malloc(size_t size) noexcept {
+  ilqgames::allocation_counter::MaybeCount();
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) noexcept {
+  ilqgames::allocation_counter::MaybeCount();
+  return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+  ilqgames::allocation_counter::MaybeCount();
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+  ilqgames::allocation_counter::MaybeCount();
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+  ilqgames::allocation_counter::MaybeCount();
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) noexcept {
+  ilqgames::allocation_counter::MaybeCount();
+
+  // Alignment must be a power of two multiple of sizeof(void*).
+  if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+    return EINVAL;
+
+  void* result = __libc_memalign(alignment, size);
+  if (!result) return ENOMEM;
+  *ptr = result;
+  return 0;
+}
+}  // extern "C"
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Tests for ConstraintMultipliers.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/constraint/affine_scalar_constraint.h>
+#include <ilqgames/constraint/constraint.h>
+#include <ilqgames/cost/player_cost.h>
+#include <ilqgames/utils/constraint_multipliers.h>
+#include <ilqgames/utils/operating_point.h>
+#include <ilqgames/utils/time_grid.h>
+#include <ilqgames/utils/types.h>
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace ilqgames;
+
+namespace {
+// Problem dimensions.
+static constexpr size_t kNumTimeSteps = 5;
+static constexpr Dimension kXDim = 3;
+static constexpr Dimension kUDim = 2;
+
+// Multiplier to set before binding.
+static constexpr float kInitialLambda = 2.0;
+
+// Create a single player cost with one state and one control constraint, an
+// equality and an inequality respectively.
+PlayerCost CreatePlayerCost() {
+  PlayerCost pc;
+  pc.AddStateConstraint(std::make_shared<AffineScalarConstraint>(
+      VectorXf::LinSpaced(kXDim, -1.0, 1.0), 0.5, true));
+  pc.AddControlConstraint(
+      0, std::make_shared<AffineScalarConstraint>(VectorXf::Ones(kUDim), 0.0,
+                                                  false));
+  pc.SetTimeDiscretization(TimeGrid(time::kDefaultTimeStep), kNumTimeSteps);
+  return pc;
+}
+
+// Create an operating point whose entries vary over time.
+OperatingPoint CreateOperatingPoint() {
+  OperatingPoint op(kNumTimeSteps, 1, 0.0);
+  for (size_t kk = 0; kk < kNumTimeSteps; kk++) {
+    op.xs[kk] = VectorXf::Constant(kXDim, static_cast<float>(kk) - 2.0);
+    op.us[kk][0] = VectorXf::Constant(kUDim, 1.0 - static_cast<float>(kk));
+  }
+
+  return op;
+}
+}  // anonymous namespace
+
+TEST(ConstraintMultipliersTest, BindSharesMultipliers) {
+  const std::vector<PlayerCost> pcs = {CreatePlayerCost()};
+  const auto& constraint = pcs[0].StateConstraints().front();
+  const Time t = 2.0 * time::kDefaultTimeStep;
+  constraint->Lambda(t) = kInitialLambda;
+
+  ConstraintMultipliers multipliers;
+  multipliers.Bind(pcs, kNumTimeSteps);
+  ASSERT_EQ(multipliers.NumConstraints(), 2);
+  EXPECT_EQ(multipliers.Lambdas()(0, 2), kInitialLambda);
+
+  // Writes to either copy should be visible to the other.
+  multipliers.Lambdas()(0, 3) = kInitialLambda;
+  EXPECT_EQ(constraint->Lambda(t + time::kDefaultTimeStep), kInitialLambda);
+  multipliers.ScaleLambdas(0.5);
+  EXPECT_EQ(constraint->Lambda(t), 0.5 * kInitialLambda);
+
+  // Rebinding should keep current values.
+  multipliers.Bind(pcs, kNumTimeSteps);
+  EXPECT_EQ(multipliers.Lambdas()(0, 2), 0.5 * kInitialLambda);
+  EXPECT_EQ(constraint->Lambda(t), 0.5 * kInitialLambda);
+}
+
+TEST(ConstraintMultipliersTest, DualUpdateMatchesScalarUpdates) {
+  const std::vector<PlayerCost> pcs = {CreatePlayerCost()};
+  const PlayerCost expected_pc = CreatePlayerCost();
+  const OperatingPoint op = CreateOperatingPoint();
+
+  ConstraintMultipliers multipliers;
+  multipliers.Bind(pcs, kNumTimeSteps);
+
+  // Update twice so that some inequality multipliers would become negative
+  // without clamping.
+  for (size_t ii = 0; ii < 2; ii++) {
+    float expected_max_error = -constants::kInfinity;
+    for (size_t kk = 0; kk < kNumTimeSteps; kk++) {
+      const Time t = op.t0 + kk * time::kDefaultTimeStep;
+      for (const auto& constraint : expected_pc.StateConstraints()) {
+        const float error = constraint->Evaluate(t, op.xs[kk]);
+        expected_max_error = std::max(expected_max_error, error);
+        constraint->IncrementLambda(t, error);
+      }
+      for (const auto& pair : expected_pc.ControlConstraints()) {
+        const float error = pair.second->Evaluate(t, op.us[kk][pair.first]);
+        expected_max_error = std::max(expected_max_error, error);
+        pair.second->IncrementLambda(t, error);
+      }
+    }
+
+    EXPECT_FLOAT_EQ(multipliers.EvaluateViolations(op), expected_max_error);
+    multipliers.IncrementLambdas();
+  }
+
+  const auto& state_constraint = pcs[0].StateConstraints().front();
+  const auto& control_constraint = pcs[0].ControlConstraints().begin()->second;
+  const auto& expected_state_constraint =
+      expected_pc.StateConstraints().front();
+  const auto& expected_control_constraint =
+      expected_pc.ControlConstraints().begin()->second;
+  for (size_t kk = 0; kk < kNumTimeSteps; kk++) {
+    const Time t = op.t0 + kk * time::kDefaultTimeStep;
+    EXPECT_FLOAT_EQ(state_constraint->Lambda(t),
+                    expected_state_constraint->Lambda(t));
+    EXPECT_FLOAT_EQ(control_constraint->Lambda(t),
+                    expected_control_constraint->Lambda(t));
+    EXPECT_GE(control_constraint->Lambda(t), 0.0);
+  }
+}
+
+TEST(ConstraintMultipliersTest, ShiftKeepsMultipliersAligned) {
+  const std::vector<PlayerCost> pcs = {CreatePlayerCost()};
+  const auto& constraint = pcs[0].StateConstraints().front();
+  const TimeGrid& grid = constraint->Grid();
+
+  ConstraintMultipliers multipliers;
+  multipliers.Bind(pcs, kNumTimeSteps);
+  for (size_t kk = 0; kk < kNumTimeSteps; kk++) {
+    multipliers.Lambdas().col(kk).setConstant(static_cast<float>(kk));
+    multipliers.Mus().col(kk).setConstant(static_cast<float>(kk) + 10.0);
+  }
+
+  // Shift forward by two time steps, which should drop the first two and
+  // reset the last two to defaults.
+  constexpr size_t kShift = 2;
+  multipliers.Shift(grid.RelativeTime(kShift), grid);
+  for (size_t kk = 0; kk < kNumTimeSteps; kk++) {
+    const Time t = grid.RelativeTime(kk);
+    if (kk + kShift < kNumTimeSteps) {
+      EXPECT_EQ(constraint->Lambda(t), static_cast<float>(kk + kShift));
+      EXPECT_EQ(constraint->Mu(t), static_cast<float>(kk + kShift) + 10.0);
+    } else {
+      EXPECT_EQ(constraint->Lambda(t), constants::kDefaultLambda);
+      EXPECT_EQ(constraint->Mu(t), constants::kDefaultMu);
+    }
+  }
+}
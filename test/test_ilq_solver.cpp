@@ -0,0 +1,568 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Tests for ILQSolver.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/examples/three_player_intersection_example.h>
+#include <ilqgames/examples/two_player_collision_example.h>
+#include <ilqgames/solver/ilq_solver.h>
+#include <ilqgames/solver/solver_params.h>
+#include <ilqgames/utils/operating_point.h>
+#include <ilqgames/utils/quadratic_cost_approximation.h>
+#include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/time_grid.h>
+#include <ilqgames/utils/types.h>
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ilqgames;
+
+namespace {
+// Short horizon and time step, different from the defaults.
+static constexpr Time kShortTimeHorizon = 2.0;
+static constexpr Time kShortTimeStep = 0.05;
+
+// Maximum number of solver iterations.
+static constexpr size_t kMaxSolverIters = 5;
+
+// Number of threads to use in parallel mode.
+static constexpr size_t kNumThreads = 3;
+
+// Number of speculative linesearch steps, and solver settings under which the
+// linesearch has to backtrack.
+static constexpr size_t kNumSpeculativeSteps = 2;
+static constexpr size_t kMaxSpeculativeSolverIters = 10;
+static constexpr float kLargeInitialAlphaScaling = 2.0;
+
+// Tolerance for lazy relinearization, enough solver iterations for late ones
+// to make small changes, and relative tolerance on the resulting costs
+// compared to exact relinearization.
+static constexpr float kRelinearizationTolerance = 1e-2;
+static constexpr size_t kLazySolverIters = 50;
+static constexpr float kLazyCostTolerance = 1e-3;
+
+// Number of multiple shooting segments, and relative tolerance on the
+// resulting costs compared to single shooting.
+static constexpr size_t kNumShootingSegments = 4;
+static constexpr float kMultipleShootingCostTolerance = 1e-2;
+
+// Tight deadline for the anytime solver (s).
+static constexpr Time kTightDeadline = 0.0;
+
+// Initial and final time steps of a graded time grid.
+static constexpr Time kGradedInitialTimeStep = 0.05;
+static constexpr Time kGradedFinalTimeStep = 0.3;
+
+// Solve a fresh two player collision problem with the given discretization and
+// return the final total costs.
+std::vector<float> SolveTwoPlayerCollision(Time time_horizon, Time time_step) {
+  auto problem =
+      std::make_shared<TwoPlayerCollisionExample>(time_horizon, time_step);
+  problem->Initialize();
+
+  SolverParams params;
+  params.max_solver_iters = kMaxSolverIters;
+  ILQSolver solver(problem, params);
+  return solver.Solve()->TotalCosts();
+}
+
+// Solver which exposes cost quadraticization, differentiation, and the merit
+// function.
+class QuadraticizingILQSolver : public ILQSolver {
+ public:
+  QuadraticizingILQSolver(const std::shared_ptr<Problem>& problem,
+                          const SolverParams& params = SolverParams())
+      : ILQSolver(problem, params) {}
+
+  using ILQSolver::ComputeCostGradients;
+  using ILQSolver::ComputeCostQuadraticization;
+  using ILQSolver::MeritFunction;
+};  // class QuadraticizingILQSolver
+}  // anonymous namespace
+
+TEST(ILQSolverTest, RespectsProblemTimeDiscretization) {
+  auto default_problem = std::make_shared<TwoPlayerCollisionExample>();
+  auto short_problem = std::make_shared<TwoPlayerCollisionExample>(
+      kShortTimeHorizon, kShortTimeStep);
+  default_problem->Initialize();
+  short_problem->Initialize();
+
+  EXPECT_EQ(default_problem->NumTimeSteps(), time::kDefaultNumTimeSteps);
+  EXPECT_EQ(short_problem->NumTimeSteps(),
+            time::NumTimeSteps(kShortTimeHorizon, kShortTimeStep));
+  EXPECT_EQ(short_problem->CurrentOperatingPoint().xs.size(),
+            short_problem->NumTimeSteps());
+
+  // Solve both problems side by side.
+  SolverParams params;
+  params.max_solver_iters = kMaxSolverIters;
+  ILQSolver default_solver(default_problem, params);
+  ILQSolver short_solver(short_problem, params);
+  const auto default_log = default_solver.Solve();
+  const auto short_log = short_solver.Solve();
+
+  EXPECT_EQ(default_log->NumTimeSteps(), default_problem->NumTimeSteps());
+  EXPECT_EQ(short_log->NumTimeSteps(), short_problem->NumTimeSteps());
+  EXPECT_NEAR(short_log->TimeStep(), kShortTimeStep, constants::kSmallNumber);
+  EXPECT_NEAR(short_log->FinalTime() - short_log->InitialTime(),
+              kShortTimeHorizon - kShortTimeStep, constants::kSmallNumber);
+}
+
+TEST(ILQSolverTest, ConcurrentSolversMatchSequential) {
+  // Solve each problem on its own.
+  const std::vector<float> expected_default_costs = SolveTwoPlayerCollision(
+      time::kDefaultTimeHorizon, time::kDefaultTimeStep);
+  const std::vector<float> expected_short_costs =
+      SolveTwoPlayerCollision(kShortTimeHorizon, kShortTimeStep);
+
+  // Solve both problems at once on separate threads. Since solvers share no
+  // state, results should be identical.
+  std::vector<float> default_costs, short_costs;
+  std::thread default_thread([&default_costs]() {
+    default_costs = SolveTwoPlayerCollision(time::kDefaultTimeHorizon,
+                                            time::kDefaultTimeStep);
+  });
+  std::thread short_thread([&short_costs]() {
+    short_costs = SolveTwoPlayerCollision(kShortTimeHorizon, kShortTimeStep);
+  });
+  default_thread.join();
+  short_thread.join();
+
+  EXPECT_EQ(default_costs, expected_default_costs);
+  EXPECT_EQ(short_costs, expected_short_costs);
+}
+
+TEST(ILQSolverTest, ParallelMatchesSerial) {
+  auto serial_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  auto parallel_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  serial_problem->Initialize();
+  parallel_problem->Initialize();
+
+  SolverParams params;
+  params.max_solver_iters = kMaxSolverIters;
+  ILQSolver serial_solver(serial_problem, params);
+  params.num_threads = kNumThreads;
+  ILQSolver parallel_solver(parallel_problem, params);
+  const auto serial_log = serial_solver.Solve();
+  const auto parallel_log = parallel_solver.Solve();
+
+  // Results should be bitwise identical.
+  ASSERT_EQ(serial_log->NumIterates(), parallel_log->NumIterates());
+  EXPECT_EQ(serial_log->TotalCosts(), parallel_log->TotalCosts());
+
+  const auto& serial_op = serial_log->FinalOperatingPoint();
+  const auto& parallel_op = parallel_log->FinalOperatingPoint();
+  for (size_t kk = 0; kk < serial_op.xs.size(); kk++) {
+    EXPECT_EQ(serial_op.xs[kk], parallel_op.xs[kk]);
+    for (PlayerIndex ii = 0; ii < serial_op.us[kk].size(); ii++)
+      EXPECT_EQ(serial_op.us[kk][ii], parallel_op.us[kk][ii]);
+  }
+}
+
+TEST(ILQSolverTest, LazyRelinearizationMatchesExact) {
+  auto exact_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  auto lazy_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  exact_problem->Initialize();
+  lazy_problem->Initialize();
+
+  SolverParams params;
+  params.max_solver_iters = kLazySolverIters;
+  ILQSolver exact_solver(exact_problem, params);
+  params.relinearization_tolerance = kRelinearizationTolerance;
+  ILQSolver lazy_solver(lazy_problem, params);
+  const auto exact_log = exact_solver.Solve();
+  const auto lazy_log = lazy_solver.Solve();
+
+  // Exact solves should never reuse anything, while lazy ones should reuse
+  // some time steps and still find (nearly) the same solution.
+  EXPECT_EQ(exact_solver.NumReusedLinearizations(), 0);
+  EXPECT_EQ(exact_solver.NumReusedQuadraticizations(), 0);
+  EXPECT_GT(lazy_solver.NumReusedLinearizations(), 0);
+  EXPECT_GT(lazy_solver.NumReusedQuadraticizations(), 0);
+
+  const auto exact_costs = exact_log->TotalCosts();
+  const auto lazy_costs = lazy_log->TotalCosts();
+  ASSERT_EQ(exact_costs.size(), lazy_costs.size());
+  for (size_t ii = 0; ii < exact_costs.size(); ii++) {
+    EXPECT_NEAR(lazy_costs[ii], exact_costs[ii],
+                kLazyCostTolerance * std::abs(exact_costs[ii]));
+  }
+}
+
+TEST(ILQSolverTest, MultipleShootingMatchesSingleShooting) {
+  auto single_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  auto multiple_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  single_problem->Initialize();
+  multiple_problem->Initialize();
+
+  SolverParams params;
+  params.max_solver_iters = kLazySolverIters;
+  ILQSolver single_solver(single_problem, params);
+  params.num_shooting_segments = kNumShootingSegments;
+  params.num_threads = kNumThreads;
+  ILQSolver multiple_solver(multiple_problem, params);
+  const auto single_log = single_solver.Solve();
+  const auto multiple_log = multiple_solver.Solve();
+
+  // Segments should (nearly) join up.
+  const auto& op = multiple_log->FinalOperatingPoint();
+  const auto& dynamics = *multiple_problem->Dynamics();
+  for (size_t kk = 0; kk + 1 < op.xs.size(); kk++) {
+    const VectorXf x = dynamics.Integrate(
+        op.t0 + multiple_problem->RelativeTime(kk),
+        multiple_problem->TimeStep(kk), op.xs[kk], op.us[kk]);
+    EXPECT_LE((x - op.xs[kk + 1]).cwiseAbs().maxCoeff(),
+              params.defect_tolerance);
+  }
+
+  // Both should find (nearly) the same solution.
+  const auto single_costs = single_log->TotalCosts();
+  const auto multiple_costs = multiple_log->TotalCosts();
+  ASSERT_EQ(single_costs.size(), multiple_costs.size());
+  for (size_t ii = 0; ii < single_costs.size(); ii++) {
+    EXPECT_NEAR(multiple_costs[ii], single_costs[ii],
+                kMultipleShootingCostTolerance * std::abs(single_costs[ii]));
+  }
+}
+
+TEST(ILQSolverTest, MultipleShootingReturnsFeasibleIterate) {
+  auto problem = std::make_shared<ThreePlayerIntersectionExample>();
+  problem->Initialize();
+
+  // Stop well before segments join up.
+  SolverParams params;
+  params.max_solver_iters = kMaxSolverIters;
+  params.num_shooting_segments = kNumShootingSegments;
+  ILQSolver solver(problem, params);
+  const auto log = solver.Solve();
+  EXPECT_EQ(log->Quality(), IMPROVED);
+
+  // The final iterate should be dynamically feasible anyway.
+  const auto& op = log->FinalOperatingPoint();
+  const auto& dynamics = *problem->Dynamics();
+  for (size_t kk = 0; kk + 1 < op.xs.size(); kk++) {
+    const VectorXf x =
+        dynamics.Integrate(op.t0 + problem->RelativeTime(kk),
+                           problem->TimeStep(kk), op.xs[kk], op.us[kk]);
+    EXPECT_LE((x - op.xs[kk + 1]).cwiseAbs().maxCoeff(),
+              constants::kSmallNumber);
+  }
+}
+
+TEST(ILQSolverTest, MultipleShootingMeritPenalizesDefects) {
+  auto problem = std::make_shared<ThreePlayerIntersectionExample>();
+  problem->Initialize();
+
+  // Without any iterations, the solver returns a single shooting rollout,
+  // which is dynamically feasible.
+  SolverParams params;
+  params.max_solver_iters = 0;
+  ILQSolver initial_solver(problem, params);
+  OperatingPoint op = initial_solver.Solve()->FinalOperatingPoint();
+
+  // Open a gap at the start of the second segment.
+  params.num_shooting_segments = kNumShootingSegments;
+  QuadraticizingILQSolver solver(problem, params);
+  const size_t segment_start = problem->NumTimeSteps() / kNumShootingSegments;
+  const VectorXf gap = VectorXf::Constant(op.xs[segment_start].size(), 0.1);
+  op.xs[segment_start] += gap;
+
+  // The merit function should penalize the defect on top of cost gradients.
+  const float merit = solver.MeritFunction(op);
+  const float gradient_merit = solver.MeritFunction(*solver.Quadraticization());
+  EXPECT_NEAR(merit - gradient_merit, 0.5 * gap.squaredNorm(),
+              constants::kSmallNumber * merit);
+}
+
+TEST(ILQSolverTest, SpeculativeLinesearchMatchesSerial) {
+  auto serial_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  auto speculative_problem =
+      std::make_shared<ThreePlayerIntersectionExample>();
+  serial_problem->Initialize();
+  speculative_problem->Initialize();
+
+  // Take overly large initial steps so that the linesearch has to backtrack,
+  // sometimes over several rounds of speculative steps.
+  SolverParams params;
+  params.max_solver_iters = kMaxSpeculativeSolverIters;
+  params.initial_alpha_scaling = kLargeInitialAlphaScaling;
+  params.expected_decrease_fraction = 0.0;
+  ILQSolver serial_solver(serial_problem, params);
+  params.num_threads = kNumThreads;
+  params.num_speculative_steps = kNumSpeculativeSteps;
+  ILQSolver speculative_solver(speculative_problem, params);
+  const auto serial_log = serial_solver.Solve();
+  const auto speculative_log = speculative_solver.Solve();
+
+  // Both linesearches accept the same step, so results should be bitwise
+  // identical.
+  ASSERT_EQ(serial_log->NumIterates(), speculative_log->NumIterates());
+  EXPECT_EQ(serial_log->TotalCosts(), speculative_log->TotalCosts());
+
+  const auto& serial_op = serial_log->FinalOperatingPoint();
+  const auto& speculative_op = speculative_log->FinalOperatingPoint();
+  for (size_t kk = 0; kk < serial_op.xs.size(); kk++) {
+    EXPECT_EQ(serial_op.xs[kk], speculative_op.xs[kk]);
+    for (PlayerIndex ii = 0; ii < serial_op.us[kk].size(); ii++)
+      EXPECT_EQ(serial_op.us[kk][ii], speculative_op.us[kk][ii]);
+  }
+}
+
+TEST(ILQSolverTest, RecordsTelemetryAndTrace) {
+  auto problem = std::make_shared<ThreePlayerIntersectionExample>();
+  problem->Initialize();
+
+  // Take overly large initial steps so that the linesearch has to backtrack.
+  SolverParams params;
+  params.max_solver_iters = kMaxSpeculativeSolverIters;
+  params.initial_alpha_scaling = kLargeInitialAlphaScaling;
+  params.expected_decrease_fraction = 0.0;
+  params.record_trace = true;
+  ILQSolver solver(problem, params);
+  const auto log = solver.Solve();
+  ASSERT_GT(log->NumIterates(), 1);
+
+  size_t num_backtracking_steps = 0;
+  for (size_t ii = 1; ii < log->NumIterates(); ii++) {
+    const auto& telemetry = log->Telemetry(ii);
+    EXPECT_GT(telemetry.linearization_time, 0.0);
+    EXPECT_GT(telemetry.lq_solve_time, 0.0);
+
+    // Rollouts and quadraticizations all happen inside the linesearch.
+    EXPECT_GT(telemetry.rollout_time, 0.0);
+    EXPECT_GT(telemetry.quadraticization_time, 0.0);
+    EXPECT_LE(telemetry.rollout_time + telemetry.quadraticization_time,
+              telemetry.linesearch_time);
+
+    // Accepted step size should reflect backtracking.
+    EXPECT_FLOAT_EQ(telemetry.step_size,
+                    params.initial_alpha_scaling *
+                        std::pow(params.geometric_alpha_scaling,
+                                 telemetry.num_backtracking_steps));
+    EXPECT_TRUE(std::isfinite(telemetry.merit_function_value));
+    num_backtracking_steps += telemetry.num_backtracking_steps;
+  }
+  EXPECT_GT(num_backtracking_steps, 0);
+
+  // There should be one trace event per iterate after the first, with all
+  // others nested inside them (or preceding the first).
+  size_t num_iterate_events = 0;
+  for (const auto& event : log->TraceEvents()) {
+    EXPECT_GE(event.duration, 0.0);
+    if (std::string(event.name) == "iterate") num_iterate_events++;
+  }
+  EXPECT_EQ(num_iterate_events, log->NumIterates() - 1);
+
+  // Traces are only recorded on request.
+  params.record_trace = false;
+  ILQSolver untraced_solver(problem, params);
+  EXPECT_TRUE(untraced_solver.Solve()->TraceEvents().empty());
+}
+
+TEST(ILQSolverTest, UniformTimeGridMatchesTimeStep) {
+  auto time_step_problem = std::make_shared<ThreePlayerIntersectionExample>(
+      kShortTimeHorizon, kShortTimeStep);
+  auto time_grid_problem = std::make_shared<ThreePlayerIntersectionExample>(
+      kShortTimeHorizon, TimeGrid(kShortTimeStep));
+  time_step_problem->Initialize();
+  time_grid_problem->Initialize();
+
+  SolverParams params;
+  params.max_solver_iters = kMaxSolverIters;
+  ILQSolver time_step_solver(time_step_problem, params);
+  ILQSolver time_grid_solver(time_grid_problem, params);
+  const auto time_step_log = time_step_solver.Solve();
+  const auto time_grid_log = time_grid_solver.Solve();
+
+  // A uniform grid is just another way of specifying the time step.
+  ASSERT_EQ(time_step_log->NumIterates(), time_grid_log->NumIterates());
+  EXPECT_EQ(time_step_log->TotalCosts(), time_grid_log->TotalCosts());
+}
+
+TEST(ILQSolverTest, SolvesOnGradedTimeGrid) {
+  const TimeGrid grid = TimeGrid::Graded(
+      kGradedInitialTimeStep, kGradedFinalTimeStep, time::kDefaultTimeHorizon);
+  auto problem = std::make_shared<ThreePlayerIntersectionExample>(
+      time::kDefaultTimeHorizon, grid);
+  problem->Initialize();
+  EXPECT_LT(problem->NumTimeSteps(), time::kDefaultNumTimeSteps);
+  EXPECT_EQ(problem->CurrentOperatingPoint().xs.size(),
+            problem->NumTimeSteps());
+
+  SolverParams params;
+  params.max_solver_iters = kMaxSolverIters;
+  ILQSolver solver(problem, params);
+  const auto log = solver.Solve();
+
+  // Time stamps follow the grid, and the solution stays finite.
+  const size_t last = log->NumTimeSteps() - 1;
+  EXPECT_NEAR(log->FinalTime() - log->InitialTime(), grid.RelativeTime(last),
+              constants::kSmallNumber);
+  EXPECT_NEAR(log->IndexToTime(1) - log->InitialTime(), grid.TimeStep(0),
+              constants::kSmallNumber);
+  for (const float cost : log->TotalCosts()) EXPECT_TRUE(std::isfinite(cost));
+  for (const auto& x : log->FinalOperatingPoint().xs)
+    EXPECT_TRUE(x.allFinite());
+}
+
+TEST(ILQSolverTest, RequadraticizesOnGradedTimeGrid) {
+  const TimeGrid grid = TimeGrid::Graded(
+      kGradedInitialTimeStep, kGradedFinalTimeStep, time::kDefaultTimeHorizon);
+  auto problem = std::make_shared<ThreePlayerIntersectionExample>(
+      time::kDefaultTimeHorizon, grid);
+  problem->Initialize();
+
+  // Quadraticize about a solution, since costs are degenerate about the
+  // initial operating point.
+  SolverParams params;
+  params.max_solver_iters = kMaxSolverIters;
+  ILQSolver initial_solver(problem, params);
+  const OperatingPoint op = initial_solver.Solve()->FinalOperatingPoint();
+
+  // Quadraticize fresh, then again in place after differentiating and
+  // quadraticizing a couple of times. Weights must not compound.
+  QuadraticizingILQSolver solver(problem);
+  const std::vector<QuadraticCostApproximation> empty(
+      problem->Dynamics()->NumPlayers(),
+      QuadraticCostApproximation(problem->Dynamics()->XDim()));
+  std::vector<std::vector<QuadraticCostApproximation>> expected(
+      problem->NumTimeSteps(), empty);
+  std::vector<std::vector<QuadraticCostApproximation>> q = expected;
+  solver.ComputeCostQuadraticization(op, &expected);
+  solver.ComputeCostQuadraticization(op, &q);
+  solver.ComputeCostGradients(op, &q);
+  solver.ComputeCostQuadraticization(op, &q);
+
+  for (size_t kk = 0; kk < problem->NumTimeSteps(); kk++) {
+    for (PlayerIndex ii = 0; ii < empty.size(); ii++) {
+      EXPECT_TRUE(q[kk][ii].state.hess.isApprox(expected[kk][ii].state.hess));
+      EXPECT_TRUE(q[kk][ii].state.grad.isApprox(expected[kk][ii].state.grad));
+    }
+  }
+}
+
+TEST(ILQSolverTest, HardDeadlineWithoutTimeLimitMatchesDefault) {
+  auto default_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  auto deadline_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  default_problem->Initialize();
+  deadline_problem->Initialize();
+
+  SolverParams params;
+  params.max_solver_iters = kMaxSolverIters;
+  ILQSolver default_solver(default_problem, params);
+  params.hard_deadline = true;
+  ILQSolver deadline_solver(deadline_problem, params);
+  const auto default_log = default_solver.Solve();
+  const auto deadline_log = deadline_solver.Solve();
+
+  ASSERT_EQ(default_log->NumIterates(), deadline_log->NumIterates());
+  EXPECT_EQ(default_log->TotalCosts(), deadline_log->TotalCosts());
+  EXPECT_EQ(default_log->Quality(), deadline_log->Quality());
+  EXPECT_FALSE(deadline_log->ReachedDeadline());
+}
+
+TEST(ILQSolverTest, HardDeadlineReturnsInitialIterateIfOutOfTime) {
+  auto problem = std::make_shared<ThreePlayerIntersectionExample>();
+  problem->Initialize();
+
+  SolverParams params;
+  params.hard_deadline = true;
+  ILQSolver solver(problem, params);
+
+  // Warm up the phase timers, then solve with no time at all.
+  solver.Solve();
+  bool success = false;
+  const auto log = solver.Solve(&success, kTightDeadline);
+
+  EXPECT_TRUE(success);
+  EXPECT_TRUE(log->ReachedDeadline());
+  EXPECT_EQ(log->Quality(), NOT_IMPROVED);
+  ASSERT_EQ(log->NumIterates(), 1);
+  for (const auto& x : log->FinalOperatingPoint().xs)
+    EXPECT_TRUE(x.allFinite());
+}
+
+TEST(ILQSolverTest, HardDeadlineFallsBackOnLinesearchFailure) {
+  auto default_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  auto deadline_problem = std::make_shared<ThreePlayerIntersectionExample>();
+  default_problem->Initialize();
+  deadline_problem->Initialize();
+
+  // Without any backtracking steps, the linesearch always fails.
+  SolverParams params;
+  params.max_backtracking_steps = 0;
+  ILQSolver default_solver(default_problem, params);
+  params.hard_deadline = true;
+  ILQSolver deadline_solver(deadline_problem, params);
+
+  bool default_success = true;
+  bool deadline_success = false;
+  const auto default_log = default_solver.Solve(&default_success);
+  const auto deadline_log = deadline_solver.Solve(&deadline_success);
+
+  EXPECT_FALSE(default_success);
+  EXPECT_TRUE(deadline_success);
+  EXPECT_FALSE(deadline_log->ReachedDeadline());
+  EXPECT_EQ(deadline_log->Quality(), NOT_IMPROVED);
+  EXPECT_EQ(default_log->TotalCosts(), deadline_log->TotalCosts());
+}
+
+TEST(ILQSolverTest, StopCallbackStopsEarly) {
+  auto problem = std::make_shared<ThreePlayerIntersectionExample>();
+  problem->Initialize();
+
+  // Stop once a fixed number of iterates has been logged.
+  constexpr size_t kNumIteratesBeforeStopping = 3;
+  ILQSolver solver(problem);
+  solver.SetStopCallback([](const SolverLog& log) {
+    return log.NumIterates() >= kNumIteratesBeforeStopping;
+  });
+
+  bool success = false;
+  const auto log = solver.Solve(&success);
+  EXPECT_TRUE(success);
+  EXPECT_EQ(log->NumIterates(), kNumIteratesBeforeStopping);
+  EXPECT_EQ(log->Quality(), IMPROVED);
+}
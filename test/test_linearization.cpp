@@ -42,6 +42,7 @@
 
 #include <ilqgames/dynamics/air_3d.h>
 #include <ilqgames/dynamics/concatenated_dynamical_system.h>
+#include <ilqgames/dynamics/fixed_size_concatenated_dynamical_system.h>
 #include <ilqgames/dynamics/single_player_car_5d.h>
 #include <ilqgames/dynamics/single_player_car_6d.h>
 #include <ilqgames/dynamics/single_player_car_7d.h>
@@ -60,6 +61,9 @@
 using namespace ilqgames;
 
 namespace {
+// Time step for discrete-time linearizations.
+static constexpr Time kTimeStep = 0.1;
+
 // Step size for forward differences.
 static constexpr float kForwardStep = 1e-3;
 static constexpr float kNumericalPrecision = 1e-2;
@@ -85,8 +89,8 @@ void NumericalJacobian(const SinglePlayerDynamicalSystem& system, Time t,
     VectorXf x_forward(x);
     x_forward(ii) += kForwardStep;
 
-    A.col(ii) += (system.Evaluate(t, x_forward, u) - xdot) * time::kTimeStep /
-                 kForwardStep;
+    A.col(ii) +=
+        (system.Evaluate(t, x_forward, u) - xdot) * kTimeStep / kForwardStep;
   }
 
   // Compute each column of B by forward differences.
@@ -94,8 +98,8 @@ void NumericalJacobian(const SinglePlayerDynamicalSystem& system, Time t,
     VectorXf u_forward(u);
     u_forward(ii) += kForwardStep;
 
-    B.col(ii) = (system.Evaluate(t, x, u_forward) - xdot) * time::kTimeStep /
-                kForwardStep;
+    B.col(ii) =
+        (system.Evaluate(t, x, u_forward) - xdot) * kTimeStep / kForwardStep;
   }
 }
 
@@ -118,7 +122,7 @@ LinearDynamicsApproximation NumericalJacobian(
     x_forward(ii) += kForwardStep;
 
     linearization.A.col(ii) += (system.Evaluate(t, x_forward, us) - xdot) *
-                               time::kTimeStep / kForwardStep;
+                               kTimeStep / kForwardStep;
   }
 
   // Compute each column of A by forward differences.
@@ -129,7 +133,7 @@ LinearDynamicsApproximation NumericalJacobian(
 
     for (Dimension jj = 0; jj < system.UDim(ii); jj++) {
       u_forward(jj) += kForwardStep;
-      B.col(jj) = (system.Evaluate(t, x, us_forward) - xdot) * time::kTimeStep /
+      B.col(jj) = (system.Evaluate(t, x, us_forward) - xdot) * kTimeStep /
                   kForwardStep;
       u_forward(jj) -= kForwardStep;
     }
@@ -154,7 +158,7 @@ void CheckLinearization(const SinglePlayerDynamicalSystem& system) {
 
     MatrixXf A_analytic(MatrixXf::Identity(system.XDim(), system.XDim()));
     MatrixXf B_analytic(MatrixXf::Zero(system.XDim(), system.UDim()));
-    system.Linearize(t, x, u, A_analytic, B_analytic);
+    system.Linearize(t, kTimeStep, x, u, A_analytic, B_analytic);
 
     MatrixXf A_numerical(MatrixXf::Identity(system.XDim(), system.XDim()));
     MatrixXf B_numerical(MatrixXf::Zero(system.XDim(), system.UDim()));
@@ -183,7 +187,8 @@ void CheckLinearization(const MultiPlayerDynamicalSystem& system) {
     for (size_t jj = 0; jj < system.NumPlayers(); jj++)
       us[jj] = VectorXf::Random(system.UDim(jj));
 
-    const LinearDynamicsApproximation analytic = system.Linearize(t, x, us);
+    const LinearDynamicsApproximation analytic =
+        system.Linearize(t, kTimeStep, x, us);
     const LinearDynamicsApproximation numerical =
         NumericalJacobian(system, t, x, us);
 
@@ -248,6 +253,50 @@ TEST(ConcatenatedDynamicalSystemTest, LinearizesCorrectly) {
   CheckLinearization(system);
 }
 
+TEST(FixedSizeConcatenatedDynamicalSystemTest, LinearizesCorrectly) {
+  constexpr float kInterAxleLength = 5.0;  // m
+  const FixedSizeConcatenatedDynamicalSystem<SinglePlayerCar6D,
+                                             SinglePlayerUnicycle4D>
+      system{SinglePlayerCar6D(kInterAxleLength), SinglePlayerUnicycle4D()};
+  CheckLinearization(system);
+}
+
+TEST(FixedSizeConcatenatedDynamicalSystemTest, MatchesDynamicSize) {
+  constexpr float kInterAxleLength = 5.0;  // m
+  const FixedSizeConcatenatedDynamicalSystem<SinglePlayerCar6D,
+                                             SinglePlayerUnicycle4D>
+      fixed_system{SinglePlayerCar6D(kInterAxleLength),
+                   SinglePlayerUnicycle4D()};
+  const ConcatenatedDynamicalSystem dynamic_system(
+      {std::make_shared<SinglePlayerCar6D>(kInterAxleLength),
+       std::make_shared<SinglePlayerUnicycle4D>()});
+  ASSERT_EQ(fixed_system.XDim(), dynamic_system.XDim());
+  ASSERT_EQ(fixed_system.NumPlayers(), dynamic_system.NumPlayers());
+
+  const VectorXf x(VectorXf::Random(dynamic_system.XDim()));
+  std::vector<VectorXf> us(dynamic_system.NumPlayers());
+  for (PlayerIndex ii = 0; ii < dynamic_system.NumPlayers(); ii++) {
+    ASSERT_EQ(fixed_system.UDim(ii), dynamic_system.UDim(ii));
+    us[ii] = VectorXf::Random(dynamic_system.UDim(ii));
+  }
+
+  EXPECT_LT((fixed_system.Evaluate(0.0, x, us) -
+             dynamic_system.Evaluate(0.0, x, us))
+                .cwiseAbs()
+                .maxCoeff(),
+            constants::kSmallNumber);
+
+  const LinearDynamicsApproximation fixed_lin =
+      fixed_system.Linearize(0.0, kTimeStep, x, us);
+  const LinearDynamicsApproximation dynamic_lin =
+      dynamic_system.Linearize(0.0, kTimeStep, x, us);
+  EXPECT_LT((fixed_lin.A - dynamic_lin.A).cwiseAbs().maxCoeff(),
+            constants::kSmallNumber);
+  for (PlayerIndex ii = 0; ii < dynamic_system.NumPlayers(); ii++)
+    EXPECT_LT((fixed_lin.Bs[ii] - dynamic_lin.Bs[ii]).cwiseAbs().maxCoeff(),
+              constants::kSmallNumber);
+}
+
 TEST(Air3DTest, LinearizesCorrectly) {
   constexpr float kSpeed = 3.0;  // m/s
   const Air3D system(kSpeed, kSpeed);
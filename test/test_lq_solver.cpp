@@ -58,6 +58,7 @@
 #include <ilqgames/utils/linear_dynamics_approximation.h>
 #include <ilqgames/utils/quadratic_cost_approximation.h>
 #include <ilqgames/utils/strategy.h>
+#include <ilqgames/utils/thread_pool.h>
 #include <ilqgames/utils/types.h>
 
 #include <gtest/gtest.h>
@@ -67,6 +68,10 @@ using namespace ilqgames;
 
 namespace {
 
+// Time discretization.
+static constexpr Time kTimeStep = 0.1;
+static constexpr size_t kNumTimeSteps = 100;
+
 // Solve two-player infinite horizon (time-invariant) LQ game by Lyapunov
 // iterations.
 void SolveLyapunovIterations(const MatrixXf& A, const MatrixXf& B1,
@@ -115,16 +120,16 @@ class SinglePlayerUtilityDynamics : public SinglePlayerDynamicalSystem {
   SinglePlayerUtilityDynamics() : SinglePlayerDynamicalSystem(2, 2) {
     CHECK_EQ(xdim_, udim_);
     A_ = MatrixXf::Identity(xdim_, xdim_);
-    B_ = time::kTimeStep * 0.41 * MatrixXf::Identity(xdim_, xdim_);
-    A_(0, 1) = time::kTimeStep;
+    B_ = kTimeStep * 0.41 * MatrixXf::Identity(xdim_, xdim_);
+    A_(0, 1) = kTimeStep;
   }
 
   VectorXf Evaluate(Time t, const VectorXf& x, const VectorXf& u) const {
-    return (A_ - MatrixXf::Identity(xdim_, xdim_)) * x / time::kTimeStep +
-           B_ * u / time::kTimeStep;
+    return (A_ - MatrixXf::Identity(xdim_, xdim_)) * x / kTimeStep +
+           B_ * u / kTimeStep;
   }
 
-  void Linearize(Time t, const VectorXf& x, const VectorXf& u,
+  void Linearize(Time t, Time time_step, const VectorXf& x, const VectorXf& u,
                  Eigen::Ref<MatrixXf> A, Eigen::Ref<MatrixXf> B) const {
     A = A_;
     B = B_;
@@ -166,13 +171,14 @@ class TwoPlayerPointMass1D : public MultiPlayerDynamicalSystem {
   }
 
   // Discrete-time Jacobian linearization.
-  LinearDynamicsApproximation Linearize(Time t, const VectorXf& x,
+  LinearDynamicsApproximation Linearize(Time t, Time time_step,
+                                        const VectorXf& x,
                                         const std::vector<VectorXf>& us) const {
     LinearDynamicsApproximation linearization(*this);
 
-    linearization.A += A_ * time::kTimeStep;
-    linearization.Bs[0] = B1_ * time::kTimeStep;
-    linearization.Bs[1] = B2_ * time::kTimeStep;
+    linearization.A += A_ * time_step;
+    linearization.Bs[0] = B1_ * time_step;
+    linearization.Bs[1] = B2_ * time_step;
     return linearization;
   }
 
@@ -190,7 +196,7 @@ template <typename T>
 class ProvideDefaultConstructor : public T {
  public:
   ProvideDefaultConstructor()
-      : T(std::make_shared<TwoPlayerPointMass1D>(), time::kNumTimeSteps) {}
+      : T(std::make_shared<TwoPlayerPointMass1D>(), kNumTimeSteps) {}
 };  // class ProvideDefaultConstructor
 
 }  // anonymous namespace
@@ -203,13 +209,14 @@ class LQSolverTest : public ::testing::Test {
     x0_ = VectorXf::Ones(2);
 
     // Set linearization and quadraticizations.
-    linearization_ = dynamics_->Linearize(
-        0.0, VectorXf::Zero(2), {VectorXf::Zero(1), VectorXf::Zero(1)});
+    linearization_ =
+        dynamics_->Linearize(0.0, kTimeStep, VectorXf::Zero(2),
+                             {VectorXf::Zero(1), VectorXf::Zero(1)});
 
     // Set a zero operating point.
     operating_point_.reset(
-        new OperatingPoint(time::kNumTimeSteps, dynamics_->NumPlayers(), 0.0));
-    for (size_t kk = 0; kk < time::kNumTimeSteps; kk++) {
+        new OperatingPoint(kNumTimeSteps, dynamics_->NumPlayers(), 0.0));
+    for (size_t kk = 0; kk < kNumTimeSteps; kk++) {
       operating_point_->xs[kk] =
           MatrixXf::Zero(dynamics_->XDim(), dynamics_->XDim());
       for (PlayerIndex ii = 0; ii < dynamics_->NumPlayers(); ii++)
@@ -257,9 +264,9 @@ class LQSolverTest : public ::testing::Test {
 
     lq_solution_ =
         lq_solver_.Solve(std::vector<LinearDynamicsApproximation>(
-                             time::kNumTimeSteps, linearization_),
+                             kNumTimeSteps, linearization_),
                          std::vector<std::vector<QuadraticCostApproximation>>(
-                             time::kNumTimeSteps, quadraticizations_),
+                             kNumTimeSteps, quadraticizations_),
                          x0_);
   }
 
@@ -299,10 +306,14 @@ TEST_F(LQFeedbackSolverTest, MatchesLyapunovIterations) {
   const VectorXf& l1 = quadraticizations_[0].state.grad;
   const VectorXf& l2 = quadraticizations_[1].state.grad;
 
-  const MatrixXf& R11 = quadraticizations_[0].control.at(0).hess;
-  const MatrixXf& R12 = quadraticizations_[0].control.at(1).hess;
-  const MatrixXf& R21 = quadraticizations_[1].control.at(0).hess;
-  const MatrixXf& R22 = quadraticizations_[1].control.at(1).hess;
+  ASSERT_TRUE(quadraticizations_[0].HasControl(0));
+  ASSERT_TRUE(quadraticizations_[0].HasControl(1));
+  ASSERT_TRUE(quadraticizations_[1].HasControl(0));
+  ASSERT_TRUE(quadraticizations_[1].HasControl(1));
+  const MatrixXf& R11 = quadraticizations_[0].control[0].hess;
+  const MatrixXf& R12 = quadraticizations_[0].control[1].hess;
+  const MatrixXf& R21 = quadraticizations_[1].control[0].hess;
+  const MatrixXf& R22 = quadraticizations_[1].control[1].hess;
 
   // Solve with Lyapunov iterations.
   MatrixXf P1(1, 2);
@@ -321,10 +332,12 @@ TEST_F(LQFeedbackSolverTest, NashEquilibrium) {
   constexpr float kMaxPerturbation = 0.1;
   EXPECT_TRUE(NumericalCheckLocalNashEquilibrium(player_costs_, lq_solution_,
                                                  *operating_point_, *dynamics_,
-                                                 x0_, kMaxPerturbation));
+                                                 x0_, kTimeStep,
+                                                 kMaxPerturbation));
   EXPECT_FALSE(NumericalCheckLocalNashEquilibrium(player_costs_, lq_solution_,
                                                   *operating_point_, *dynamics_,
-                                                  x0_, kMaxPerturbation, true));
+                                                  x0_, kTimeStep,
+                                                  kMaxPerturbation, true));
 }
 
 TEST_F(LQFeedbackSolverTest, NashEquilibriumWithLinearCostTerms) {
@@ -338,10 +351,12 @@ TEST_F(LQFeedbackSolverTest, NashEquilibriumWithLinearCostTerms) {
   constexpr float kMaxPerturbation = 0.1;
   EXPECT_TRUE(NumericalCheckLocalNashEquilibrium(player_costs_, lq_solution_,
                                                  *operating_point_, *dynamics_,
-                                                 x0_, kMaxPerturbation));
+                                                 x0_, kTimeStep,
+                                                 kMaxPerturbation));
   EXPECT_FALSE(NumericalCheckLocalNashEquilibrium(player_costs_, lq_solution_,
                                                   *operating_point_, *dynamics_,
-                                                  x0_, kMaxPerturbation, true));
+                                                  x0_, kTimeStep,
+                                                  kMaxPerturbation, true));
 }
 
 TEST_F(LQOpenLoopSolverTest, NashEquilibrium) {
@@ -383,7 +398,8 @@ TEST_F(LQOpenLoopSolverTest, NashEquilibrium) {
   constexpr float kMaxPerturbation = 0.1;
   EXPECT_TRUE(NumericalCheckLocalNashEquilibrium(player_costs_, lq_solution_,
                                                  *operating_point_, *dynamics_,
-                                                 x0_, kMaxPerturbation, true));
+                                                 x0_, kTimeStep,
+                                                 kMaxPerturbation, true));
 }
 
 TEST(SinglePlayerOpenLoopFeedback, TestSameSolution) {
@@ -393,25 +409,24 @@ TEST(SinglePlayerOpenLoopFeedback, TestSameSolution) {
   lin.A = single.A();
   lin.Bs.push_back(single.B());
 
-  const std::vector<LinearDynamicsApproximation> big_lin(time::kNumTimeSteps,
-                                                         lin);
+  const std::vector<LinearDynamicsApproximation> big_lin(kNumTimeSteps, lin);
 
   // Cost structure to regulate to the origin.
   QuadraticCostApproximation quad(single.UDim());
   quad.state.hess = MatrixXf::Identity(single.XDim(), single.XDim());
-  quad.control.emplace(0, SingleCostApproximation(
-                              MatrixXf::Identity(single.UDim(), single.UDim()),
-                              VectorXf::Zero(single.UDim())));
+  quad.SetControl(0, SingleCostApproximation(
+                         MatrixXf::Identity(single.UDim(), single.UDim()),
+                         VectorXf::Zero(single.UDim())));
 
   const std::vector<std::vector<QuadraticCostApproximation>> big_quad(
-      time::kNumTimeSteps, {quad});
+      kNumTimeSteps, {quad});
 
   // Solve open-loop and feedback separately.
   const std::shared_ptr<ConcatenatedDynamicalSystem> dyn(
       new ConcatenatedDynamicalSystem(
           {std::make_shared<SinglePlayerUtilityDynamics>()}));
-  LQOpenLoopSolver ol(dyn, time::kNumTimeSteps);
-  LQFeedbackSolver fb(dyn, time::kNumTimeSteps);
+  LQOpenLoopSolver ol(dyn, kNumTimeSteps);
+  LQFeedbackSolver fb(dyn, kNumTimeSteps);
 
   const VectorXf x0 = VectorXf::Ones(single.XDim());
   const std::vector<Strategy> ol_strategy = ol.Solve(big_lin, big_quad, x0);
@@ -432,3 +447,238 @@ TEST(SinglePlayerOpenLoopFeedback, TestSameSolution) {
   CHECK_LT((u_ol - u_fb).cwiseAbs().maxCoeff(),
            kMaxRelativeError * u_fb.cwiseAbs().maxCoeff());
 }
+
+TEST(LQFeedbackSolverBlockStructureTest, MatchesDenseSolve) {
+  // Two decoupled double integrators, which are linearized with a block
+  // structure.
+  const std::shared_ptr<ConcatenatedDynamicalSystem> dyn(
+      new ConcatenatedDynamicalSystem(
+          {std::make_shared<SinglePlayerUtilityDynamics>(),
+           std::make_shared<SinglePlayerUtilityDynamics>()}));
+  const LinearDynamicsApproximation block_lin = dyn->Linearize(
+      0.0, kTimeStep, VectorXf::Zero(dyn->XDim()),
+      {VectorXf::Zero(dyn->UDim(0)), VectorXf::Zero(dyn->UDim(1))});
+  ASSERT_TRUE(block_lin.HasBlockStructure());
+
+  // Same linearization, but without the block structure.
+  LinearDynamicsApproximation dense_lin = block_lin;
+  dense_lin.x_block_starts.clear();
+  dense_lin.x_block_dims.clear();
+  ASSERT_FALSE(dense_lin.HasBlockStructure());
+
+  // Random costs which couple the players through their states.
+  std::vector<QuadraticCostApproximation> quad;
+  for (PlayerIndex ii = 0; ii < dyn->NumPlayers(); ii++) {
+    quad.emplace_back(dyn->XDim());
+    const MatrixXf M = MatrixXf::Random(dyn->XDim(), dyn->XDim());
+    quad.back().state.hess = M * M.transpose();
+    quad.back().state.grad = VectorXf::Random(dyn->XDim());
+    for (PlayerIndex jj = 0; jj < dyn->NumPlayers(); jj++) {
+      quad.back().SetControl(
+          jj, SingleCostApproximation(
+                  MatrixXf::Identity(dyn->UDim(jj), dyn->UDim(jj)),
+                  VectorXf::Random(dyn->UDim(jj))));
+    }
+  }
+
+  // Solve both ways and check that the answers are close.
+  LQFeedbackSolver solver(dyn, kNumTimeSteps);
+  const VectorXf x0 = VectorXf::Ones(dyn->XDim());
+  const std::vector<std::vector<QuadraticCostApproximation>> big_quad(
+      kNumTimeSteps, quad);
+  const std::vector<Strategy> block_strategies = solver.Solve(
+      std::vector<LinearDynamicsApproximation>(kNumTimeSteps, block_lin),
+      big_quad, x0);
+  const std::vector<Strategy> dense_strategies = solver.Solve(
+      std::vector<LinearDynamicsApproximation>(kNumTimeSteps, dense_lin),
+      big_quad, x0);
+
+  for (PlayerIndex ii = 0; ii < dyn->NumPlayers(); ii++) {
+    for (size_t kk = 0; kk < kNumTimeSteps; kk++) {
+      EXPECT_TRUE(block_strategies[ii].Ps[kk].isApprox(
+          dense_strategies[ii].Ps[kk], constants::kSmallNumber));
+      EXPECT_TRUE(block_strategies[ii].alphas[kk].isApprox(
+          dense_strategies[ii].alphas[kk], constants::kSmallNumber));
+    }
+  }
+}
+
+TEST(LQFeedbackSolverBackendTest, BackendsMatchHouseholderQR) {
+  // Three double integrators, coupled through everyone's costs.
+  const std::shared_ptr<ConcatenatedDynamicalSystem> dyn(
+      new ConcatenatedDynamicalSystem(
+          {std::make_shared<SinglePlayerUtilityDynamics>(),
+           std::make_shared<SinglePlayerUtilityDynamics>(),
+           std::make_shared<SinglePlayerUtilityDynamics>()}));
+  const LinearDynamicsApproximation lin = dyn->Linearize(
+      0.0, kTimeStep, VectorXf::Zero(dyn->XDim()),
+      {VectorXf::Zero(dyn->UDim(0)), VectorXf::Zero(dyn->UDim(1)),
+       VectorXf::Zero(dyn->UDim(2))});
+
+  // Random costs, including off-diagonal control costs.
+  std::vector<QuadraticCostApproximation> quad;
+  for (PlayerIndex ii = 0; ii < dyn->NumPlayers(); ii++) {
+    quad.emplace_back(dyn->XDim());
+    const MatrixXf M = MatrixXf::Random(dyn->XDim(), dyn->XDim());
+    quad.back().state.hess = M * M.transpose();
+    quad.back().state.grad = VectorXf::Random(dyn->XDim());
+    for (PlayerIndex jj = 0; jj < dyn->NumPlayers(); jj++) {
+      const MatrixXf N = MatrixXf::Random(dyn->UDim(jj), dyn->UDim(jj));
+      quad.back().SetControl(
+          jj, SingleCostApproximation(
+                  N * N.transpose() +
+                      MatrixXf::Identity(dyn->UDim(jj), dyn->UDim(jj)),
+                  VectorXf::Random(dyn->UDim(jj))));
+    }
+  }
+
+  const std::vector<LinearDynamicsApproximation> big_lin(kNumTimeSteps, lin);
+  const std::vector<std::vector<QuadraticCostApproximation>> big_quad(
+      kNumTimeSteps, quad);
+  const VectorXf x0 = VectorXf::Ones(dyn->XDim());
+
+  LQFeedbackSolver qr_solver(dyn, kNumTimeSteps, HOUSEHOLDER_QR);
+  const std::vector<Strategy> qr_strategies =
+      qr_solver.Solve(big_lin, big_quad, x0);
+
+  for (const LQSolverBackend backend : {PARTIAL_PIV_LU, BLOCK_SCHUR}) {
+    LQFeedbackSolver solver(dyn, kNumTimeSteps, backend);
+    const std::vector<Strategy> strategies =
+        solver.Solve(big_lin, big_quad, x0);
+
+    for (PlayerIndex ii = 0; ii < dyn->NumPlayers(); ii++) {
+      for (size_t kk = 0; kk < kNumTimeSteps; kk++) {
+        EXPECT_TRUE(strategies[ii].Ps[kk].isApprox(qr_strategies[ii].Ps[kk],
+                                                   constants::kSmallNumber))
+            << "Backend " << backend << ", player " << ii << ", time " << kk;
+        EXPECT_TRUE(strategies[ii].alphas[kk].isApprox(
+            qr_strategies[ii].alphas[kk], constants::kSmallNumber))
+            << "Backend " << backend << ", player " << ii << ", time " << kk;
+      }
+    }
+  }
+}
+
+TEST(LQFeedbackSolverBackendTest, FallsBackToQRForSingularPlayerBlock) {
+  constexpr size_t kNumSteps = 2;
+
+  // Each player moves one coordinate of the state.
+  const std::shared_ptr<TwoPlayerPointMass1D> dyn(new TwoPlayerPointMass1D);
+  LinearDynamicsApproximation lin(*dyn);
+  lin.Bs[0] = Eigen::Vector2f(1.0, 0.0);
+  lin.Bs[1] = Eigen::Vector2f(0.0, 1.0);
+
+  // Player 0 has an indefinite state cost which cancels its own control
+  // exactly and no control cost, so its block of S is zero. S itself is still
+  // invertible though, since player 0's control is coupled to player 1's.
+  std::vector<QuadraticCostApproximation> quad(
+      dyn->NumPlayers(), QuadraticCostApproximation(dyn->XDim()));
+  quad[0].state.hess << 0.0, 1.0, 1.0, 0.0;
+  quad[0].state.grad = Eigen::Vector2f(1.0, -1.0);
+  quad[0].SetControl(
+      0, SingleCostApproximation(MatrixXf::Zero(1, 1), VectorXf::Zero(1)));
+  quad[1].state.hess << 1.0, 1.0, 1.0, 2.0;
+  quad[1].state.grad = Eigen::Vector2f(0.5, 1.0);
+  quad[1].SetControl(
+      1, SingleCostApproximation(MatrixXf::Identity(1, 1), VectorXf::Zero(1)));
+
+  const std::vector<LinearDynamicsApproximation> big_lin(kNumSteps, lin);
+  const std::vector<std::vector<QuadraticCostApproximation>> big_quad(
+      kNumSteps, quad);
+  const VectorXf x0 = VectorXf::Ones(dyn->XDim());
+
+  LQFeedbackSolver qr_solver(dyn, kNumSteps, HOUSEHOLDER_QR);
+  const std::vector<Strategy> qr_strategies =
+      qr_solver.Solve(big_lin, big_quad, x0);
+
+  for (const LQSolverBackend backend : {PARTIAL_PIV_LU, BLOCK_SCHUR}) {
+    LQFeedbackSolver solver(dyn, kNumSteps, backend);
+    const std::vector<Strategy> strategies =
+        solver.Solve(big_lin, big_quad, x0);
+
+    for (PlayerIndex ii = 0; ii < dyn->NumPlayers(); ii++) {
+      EXPECT_TRUE(strategies[ii].Ps[0].allFinite())
+          << "Backend " << backend << ", player " << ii;
+      EXPECT_TRUE(strategies[ii].alphas[0].allFinite())
+          << "Backend " << backend << ", player " << ii;
+      EXPECT_TRUE(strategies[ii].Ps[0].isApprox(qr_strategies[ii].Ps[0],
+                                                constants::kSmallNumber))
+          << "Backend " << backend << ", player " << ii;
+      EXPECT_TRUE(strategies[ii].alphas[0].isApprox(
+          qr_strategies[ii].alphas[0], constants::kSmallNumber))
+          << "Backend " << backend << ", player " << ii;
+    }
+  }
+}
+
+TEST(LQSolverParallelInTimeTest, MatchesSequentialForwardPass) {
+  constexpr size_t kNumChunks = 3;
+  constexpr size_t kNumThreads = 2;
+  constexpr float kMaxError = 1e-3;
+
+  // Two coupled double integrators with random costs.
+  const std::shared_ptr<ConcatenatedDynamicalSystem> dyn(
+      new ConcatenatedDynamicalSystem(
+          {std::make_shared<SinglePlayerUtilityDynamics>(),
+           std::make_shared<SinglePlayerUtilityDynamics>()}));
+  const std::vector<LinearDynamicsApproximation> lin(
+      kNumTimeSteps,
+      dyn->Linearize(0.0, kTimeStep, VectorXf::Zero(dyn->XDim()),
+                     {VectorXf::Zero(dyn->UDim(0)),
+                      VectorXf::Zero(dyn->UDim(1))}));
+
+  std::vector<QuadraticCostApproximation> quad;
+  for (PlayerIndex ii = 0; ii < dyn->NumPlayers(); ii++) {
+    quad.emplace_back(dyn->XDim());
+    const MatrixXf M = MatrixXf::Random(dyn->XDim(), dyn->XDim());
+    quad.back().state.hess = M * M.transpose();
+    quad.back().state.grad = VectorXf::Random(dyn->XDim());
+    for (PlayerIndex jj = 0; jj < dyn->NumPlayers(); jj++) {
+      quad.back().SetControl(
+          jj, SingleCostApproximation(
+                  MatrixXf::Identity(dyn->UDim(jj), dyn->UDim(jj)),
+                  VectorXf::Random(dyn->UDim(jj))));
+    }
+  }
+  const std::vector<std::vector<QuadraticCostApproximation>> big_quad(
+      kNumTimeSteps, quad);
+  const VectorXf x0 = VectorXf::Ones(dyn->XDim());
+
+  // Solve sequentially and in parallel in time with both solvers, and check
+  // that strategies, delta xs, and costates all agree.
+  ThreadPool pool(kNumThreads);
+  auto check = [&](LQSolver* sequential, LQSolver* parallel) {
+    parallel->SetTimeChunks(kNumChunks, &pool);
+
+    std::vector<VectorXf> sequential_xs, parallel_xs;
+    std::vector<std::vector<VectorXf>> sequential_costates, parallel_costates;
+    const std::vector<Strategy> sequential_strategies = sequential->Solve(
+        lin, big_quad, x0, &sequential_xs, &sequential_costates);
+    const std::vector<Strategy> parallel_strategies =
+        parallel->Solve(lin, big_quad, x0, &parallel_xs, &parallel_costates);
+
+    for (size_t kk = 0; kk < kNumTimeSteps; kk++) {
+      EXPECT_LT((sequential_xs[kk] - parallel_xs[kk]).cwiseAbs().maxCoeff(),
+                kMaxError);
+      for (PlayerIndex ii = 0; ii < dyn->NumPlayers(); ii++) {
+        EXPECT_LT((sequential_strategies[ii].alphas[kk] -
+                   parallel_strategies[ii].alphas[kk])
+                      .cwiseAbs()
+                      .maxCoeff(),
+                  kMaxError);
+        EXPECT_LT((sequential_costates[kk][ii] - parallel_costates[kk][ii])
+                      .cwiseAbs()
+                      .maxCoeff(),
+                  kMaxError);
+      }
+    }
+  };
+
+  LQFeedbackSolver sequential_feedback(dyn, kNumTimeSteps);
+  LQFeedbackSolver parallel_feedback(dyn, kNumTimeSteps);
+  check(&sequential_feedback, &parallel_feedback);
+
+  LQOpenLoopSolver sequential_open_loop(dyn, kNumTimeSteps);
+  LQOpenLoopSolver parallel_open_loop(dyn, kNumTimeSteps);
+  check(&sequential_open_loop, &parallel_open_loop);
+}
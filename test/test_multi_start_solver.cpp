@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Tests for MultiStartSolver.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/dynamics/single_player_car_6d.h>
+#include <ilqgames/examples/two_player_collision_example.h>
+#include <ilqgames/geometry/polyline2.h>
+#include <ilqgames/solver/ilq_solver.h>
+#include <ilqgames/solver/multi_start_solver.h>
+#include <ilqgames/solver/problem.h>
+#include <ilqgames/solver/solver_params.h>
+#include <ilqgames/utils/initialize_along_route.h>
+#include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/types.h>
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace ilqgames;
+
+namespace {
+// Number of starts and standard deviation of perturbations to each.
+static constexpr size_t kNumStarts = 3;
+static constexpr float kPerturbationStddev = 0.1;
+
+// Create a set of problems, all but the first of which are perturbed.
+std::vector<std::shared_ptr<Problem>> CreateProblems(size_t num_starts) {
+  std::vector<std::shared_ptr<Problem>> problems;
+  for (size_t start = 0; start < num_starts; start++) {
+    auto problem = std::make_shared<TwoPlayerCollisionExample>();
+    problem->Initialize();
+    if (start > 0)
+      MultiStartSolver::PerturbInitialization(kPerturbationStddev, start,
+                                              problem.get());
+    problems.push_back(problem);
+  }
+
+  return problems;
+}
+}  // anonymous namespace
+
+TEST(MultiStartSolverTest, SingleStartMatchesILQSolver) {
+  auto problem = std::make_shared<TwoPlayerCollisionExample>();
+  problem->Initialize();
+  ILQSolver solver(problem);
+  const auto expected_log = solver.Solve();
+
+  MultiStartSolver multi_start_solver(CreateProblems(1));
+  const auto log = multi_start_solver.Solve();
+  EXPECT_EQ(multi_start_solver.SelectedStart(), 0);
+  EXPECT_EQ(log->NumIterates(), expected_log->NumIterates());
+  EXPECT_EQ(log->TotalCosts(), expected_log->TotalCosts());
+}
+
+TEST(MultiStartSolverTest, PerturbationChangesInitialization) {
+  const auto problems = CreateProblems(2);
+  const auto& default_strategies = problems[0]->CurrentStrategies();
+  const auto& perturbed_strategies = problems[1]->CurrentStrategies();
+  EXPECT_GT((default_strategies[0].alphas[0] -
+             perturbed_strategies[0].alphas[0])
+                .norm(),
+            0.0);
+}
+
+TEST(MultiStartSolverTest, InitializesAlongRoute) {
+  constexpr float kInitialRoutePos = 5.0;
+  constexpr float kNominalSpeed = 2.0;
+
+  auto problem = std::make_shared<TwoPlayerCollisionExample>();
+  problem->Initialize();
+  const std::vector<Strategy> strategies = problem->CurrentStrategies();
+
+  const Polyline2 route({Point2(1.0, -10.0), Point2(1.0, 90.0)});
+  InitializeAlongRoute(route, kInitialRoutePos, kNominalSpeed,
+                       {SinglePlayerCar6D::kPxIdx, SinglePlayerCar6D::kPyIdx},
+                       problem.get());
+
+  const OperatingPoint& op = problem->CurrentOperatingPoint();
+  for (size_t kk = 0; kk < problem->NumTimeSteps(); kk++) {
+    const float y =
+        -10.0 + kInitialRoutePos + kNominalSpeed * problem->RelativeTime(kk);
+    EXPECT_NEAR(op.xs[kk](SinglePlayerCar6D::kPxIdx), 1.0,
+                constants::kSmallNumber);
+    EXPECT_NEAR(op.xs[kk](SinglePlayerCar6D::kPyIdx), y,
+                constants::kSmallNumber);
+  }
+
+  // Strategies are left alone.
+  for (PlayerIndex ii = 0; ii < strategies.size(); ii++)
+    EXPECT_EQ(problem->CurrentStrategies()[ii].alphas, strategies[ii].alphas);
+}
+
+TEST(MultiStartSolverTest, SelectsByScore) {
+  for (const auto criterion : {LOWEST_SCORE, FASTEST_CONVERGENCE}) {
+    MultiStartSolver solver(CreateProblems(kNumStarts), SolverParams(),
+                            criterion);
+    bool success = false;
+    const auto log = solver.Solve(&success);
+    ASSERT_EQ(solver.Logs().size(), kNumStarts);
+    EXPECT_EQ(log, solver.Logs()[solver.SelectedStart()]);
+    EXPECT_EQ(success, log->Quality() == CONVERGED);
+
+    // Converged solutions are always preferred, and ties are broken by the
+    // lowest score unless selecting the fastest to converge.
+    for (const auto& other : solver.Logs()) {
+      const bool other_converged = other->Quality() == CONVERGED;
+      if (other_converged) {
+        EXPECT_TRUE(success);
+      }
+      if (other_converged == success &&
+          !(criterion == FASTEST_CONVERGENCE && success)) {
+        EXPECT_LE(MultiStartSolver::EgoCost(*log),
+                  MultiStartSolver::EgoCost(*other));
+      }
+    }
+  }
+}
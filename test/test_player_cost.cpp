@@ -48,6 +48,7 @@
 #include <gtest/gtest.h>
 #include <math.h>
 #include <memory>
+#include <vector>
 
 using namespace ilqgames;
 
@@ -110,8 +111,10 @@ TEST_F(PlayerCostTest, QuadraticizeWorks) {
       quad.state.grad.isApprox(kCostWeight * x_, constants::kSmallNumber));
 
   // Check control Hessians.
-  for (const auto& pair : quad.control) {
-    const auto& R = pair.second.hess;
+  for (PlayerIndex jj = 0; jj < quad.control.size(); jj++) {
+    if (!quad.HasControl(jj)) continue;
+
+    const auto& R = quad.control[jj].hess;
     EXPECT_TRUE(
         R.diagonal().isApprox(VectorXf::Constant(kVectorDimension, kCostWeight),
                               constants::kSmallNumber));
@@ -120,3 +123,66 @@ TEST_F(PlayerCostTest, QuadraticizeWorks) {
                 constants::kSmallNumber);
   }
 }
+
+// Check that quadraticizing in place only marks players with control costs as
+// present, even when reusing a quadraticization which had other players.
+TEST_F(PlayerCostTest, QuadraticizeInPlaceTracksPresentControls) {
+  PlayerCost control_cost;
+  control_cost.AddControlCost(
+      1, std::make_shared<QuadraticCost>(kCostWeight, -1));
+
+  QuadraticCostApproximation quad(kVectorDimension);
+  player_cost_.Quadraticize(0.0, x_, us_, &quad);
+  EXPECT_TRUE(quad.HasControl(0));
+  EXPECT_TRUE(quad.HasControl(1));
+
+  control_cost.Quadraticize(0.0, x_, us_, &quad);
+  EXPECT_FALSE(quad.HasControl(0));
+  ASSERT_TRUE(quad.HasControl(1));
+  EXPECT_TRUE(quad.state.hess.isZero());
+  EXPECT_TRUE(quad.control[1].grad.isApprox(kCostWeight * us_[1],
+                                            constants::kSmallNumber));
+}
+
+// Check that sparse state Hessians are tracked and reset correctly when
+// quadraticizing in place more than once.
+TEST_F(PlayerCostTest, QuadraticizeInPlaceTracksSparseStateHessian) {
+  constexpr float kStateRegularization = 1.0;
+  PlayerCost sparse_cost("", kStateRegularization);
+  sparse_cost.AddStateCost(std::make_shared<QuadraticCost>(kCostWeight, 2));
+  sparse_cost.AddStateCost(std::make_shared<QuadraticCost>(kCostWeight, 0));
+  sparse_cost.AddControlCost(
+      0, std::make_shared<QuadraticCost>(kCostWeight, -1));
+
+  QuadraticCostApproximation quad(kVectorDimension);
+  sparse_cost.Quadraticize(0.0, x_, us_, &quad);
+  EXPECT_TRUE(quad.state.is_hess_sparse);
+  EXPECT_EQ(quad.state.hess_dims, std::vector<Dimension>({0, 2}));
+
+  // Quadraticize again somewhere else and compare to a fresh quadraticization.
+  const VectorXf x = VectorXf::Random(kVectorDimension);
+  sparse_cost.Quadraticize(0.0, x, us_, &quad);
+  const QuadraticCostApproximation expected =
+      sparse_cost.Quadraticize(0.0, x, us_);
+  EXPECT_TRUE(quad.state.hess.isApprox(expected.state.hess));
+  EXPECT_TRUE(quad.state.grad.isApprox(expected.state.grad));
+
+  // Costs on all dimensions are dense.
+  EXPECT_FALSE(player_cost_.Quadraticize(0.0, x_, us_).state.is_hess_sparse);
+}
+
+// Check that differentiating yields the same gradients as quadraticizing.
+TEST_F(PlayerCostTest, DifferentiateMatchesQuadraticize) {
+  const QuadraticCostApproximation quad =
+      player_cost_.Quadraticize(0.0, x_, us_);
+
+  QuadraticCostApproximation grads(kVectorDimension);
+  player_cost_.Differentiate(0.0, x_, us_, &grads);
+  EXPECT_TRUE(grads.state.grad.isApprox(quad.state.grad,
+                                        constants::kSmallNumber));
+  for (PlayerIndex jj = 0; jj < kNumPlayers; jj++) {
+    ASSERT_TRUE(grads.HasControl(jj));
+    EXPECT_TRUE(grads.control[jj].grad.isApprox(quad.control[jj].grad,
+                                                constants::kSmallNumber));
+  }
+}
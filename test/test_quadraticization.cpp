@@ -73,6 +73,7 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <random>
+#include <vector>
 
 using namespace ilqgames;
 
@@ -138,8 +139,8 @@ MatrixXf NumericalHessian(const Cost& cost, Time t, const VectorXf& input) {
 void CheckQuadraticization(const Cost& cost, bool is_constraint) {
   // Random number generator to make random timestamps.
   std::default_random_engine rng(0);
-  std::uniform_real_distribution<Time> time_distribution(0.0,
-                                                         time::kTimeHorizon);
+  std::uniform_real_distribution<Time> time_distribution(
+      0.0, time::kDefaultTimeHorizon);
   std::bernoulli_distribution sign_distribution;
   std::uniform_real_distribution<float> entry_distribution(0.5, 5.0);
 
@@ -158,6 +159,25 @@ void CheckQuadraticization(const Cost& cost, bool is_constraint) {
     VectorXf grad_analytic(VectorXf::Zero(kInputDimension));
     cost.Quadraticize(t, input, &hess_analytic, &grad_analytic);
 
+    // Gradient-only quadraticization should match the full one.
+    VectorXf grad_only(VectorXf::Zero(kInputDimension));
+    cost.Quadraticize(t, input, nullptr, &grad_only);
+    EXPECT_LT((grad_only - grad_analytic).lpNorm<Eigen::Infinity>(),
+              constants::kSmallNumber);
+
+    // If the cost declares a sparsity pattern, its Hessian should vanish
+    // outside of it.
+    std::vector<Dimension> dims;
+    if (cost.HessianSparsityPattern(&dims)) {
+      MatrixXf hess_outside_pattern = hess_analytic;
+      for (const Dimension dim1 : dims) {
+        for (const Dimension dim2 : dims)
+          hess_outside_pattern(dim1, dim2) = 0.0;
+      }
+
+      EXPECT_TRUE(hess_outside_pattern.isZero());
+    }
+
     MatrixXf hess_numerical = NumericalHessian(cost, t, input);
 
     // Custom method for evaluating the cost/constraint.
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+///////////////////////////////////////////////////////////////////////////////
+//
+// Tests that steady-state ILQSolver iterations do not allocate memory, other
+// than to copy each new iterate into the solver log.
+// Allocations are counted by replacing the global `malloc` family (see
+// test/allocation_counter.h), so these tests are skipped on platforms other
+// than glibc.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "allocation_counter.h"
+
+#include <ilqgames/examples/three_player_intersection_example.h>
+#include <ilqgames/solver/ilq_solver.h>
+#include <ilqgames/solver/solver_params.h>
+#include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/types.h>
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+using namespace ilqgames;
+
+namespace {
+// Number of iterations to run before and while counting allocations.
+static constexpr size_t kNumWarmupIterations = 1;
+static constexpr size_t kNumCountedIterations = 5;
+
+// Alignment (and size) of aligned allocations.
+static constexpr size_t kAlignment = 64;
+
+// Expose the solver's main loop so that it can be run one iteration at a time.
+class IterableILQSolver : public ILQSolver {
+ public:
+  IterableILQSolver(const std::shared_ptr<Problem>& problem,
+                    const SolverParams& params)
+      : ILQSolver(problem, params) {
+    Start();
+  }
+
+  using ILQSolver::Step;
+
+  // Number of allocations needed to copy the current iterate into a log which
+  // has room for it, as `Step` does.
+  size_t NumAllocationsToLogIterate() const {
+    const std::shared_ptr<SolverLog> log = CreateNewLog();
+    log->Reserve(1);
+
+    StartCountingAllocations();
+    log->AddSolverIterate(current_operating_point_, current_strategies_,
+                          total_costs_, 0.0, has_converged_);
+    return StopCountingAllocations();
+  }
+};  // class IterableILQSolver
+
+// Run the solver for a few iterations and return the number of allocations in
+// each iteration after warming up, excluding those needed to log the iterate.
+std::vector<size_t> CountAllocationsPerIteration(const SolverParams& params) {
+  auto problem = std::make_shared<ThreePlayerIntersectionExample>();
+  problem->Initialize();
+  IterableILQSolver solver(problem, params);
+
+  for (size_t ii = 0; ii < kNumWarmupIterations; ii++)
+    EXPECT_TRUE(solver.Step());
+
+  std::vector<size_t> allocations(kNumCountedIterations);
+  for (auto& count : allocations) {
+    StartCountingAllocations();
+    EXPECT_TRUE(solver.Step());
+    count = StopCountingAllocations();
+    count -= solver.NumAllocationsToLogIterate();
+  }
+
+  return allocations;
+}
+}  // anonymous namespace
+
+TEST(SolverAllocationsTest, CountsAllocations) {
+#ifndef __GLIBC__
+  GTEST_SKIP() << "Allocation counting requires glibc.";
+#endif
+
+  StartCountingAllocations();
+  std::unique_ptr<std::vector<float>> v(new std::vector<float>(10));
+  EXPECT_EQ(StopCountingAllocations(), 2);
+
+  // Aligned allocations are counted as well.
+  StartCountingAllocations();
+  void* ptr = nullptr;
+  ASSERT_EQ(posix_memalign(&ptr, kAlignment, kAlignment), 0);
+  free(ptr);
+  free(aligned_alloc(kAlignment, kAlignment));
+  EXPECT_EQ(StopCountingAllocations(), 2);
+}
+
+TEST(SolverAllocationsTest, SteadyStateIterationsDoNotAllocate) {
+#ifndef __GLIBC__
+  GTEST_SKIP() << "Allocation counting requires glibc.";
+#endif
+
+  const std::vector<size_t> allocations =
+      CountAllocationsPerIteration(SolverParams());
+  for (size_t count : allocations) EXPECT_EQ(count, 0);
+}
+
+TEST(SolverAllocationsTest, SteadyStateIterationsDoNotAllocateAnyLQBackend) {
+#ifndef __GLIBC__
+  GTEST_SKIP() << "Allocation counting requires glibc.";
+#endif
+
+  for (const LQSolverBackend backend : {PARTIAL_PIV_LU, BLOCK_SCHUR}) {
+    SolverParams params;
+    params.lq_solver_backend = backend;
+    const std::vector<size_t> allocations =
+        CountAllocationsPerIteration(params);
+    for (size_t count : allocations) EXPECT_EQ(count, 0) << backend;
+  }
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Tests for TimeGrid.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/utils/time_grid.h>
+#include <ilqgames/utils/types.h>
+
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace ilqgames;
+
+namespace {
+// Graded grid parameters.
+static constexpr Time kInitialTimeStep = 0.05;
+static constexpr Time kFinalTimeStep = 0.4;
+}  // anonymous namespace
+
+TEST(TimeGridTest, UniformMatchesFixedTimeStep) {
+  const TimeGrid grid(time::kDefaultTimeStep);
+  EXPECT_TRUE(grid.IsUniform());
+  EXPECT_EQ(grid.NumTimeSteps(time::kDefaultTimeHorizon),
+            time::kDefaultNumTimeSteps);
+
+  for (size_t kk = 0; kk < time::kDefaultNumTimeSteps; kk++) {
+    const Time t = time::kDefaultTimeStep * static_cast<Time>(kk);
+    EXPECT_EQ(grid.TimeStep(kk), time::kDefaultTimeStep);
+    EXPECT_EQ(grid.RelativeTime(kk), t);
+    EXPECT_EQ(grid.CostWeight(kk), 1.0);
+    EXPECT_EQ(grid.Index(t + 0.5 * time::kDefaultTimeStep), kk);
+  }
+}
+
+TEST(TimeGridTest, GradedSpansHorizon) {
+  const TimeGrid grid = TimeGrid::Graded(kInitialTimeStep, kFinalTimeStep,
+                                         time::kDefaultTimeHorizon);
+  EXPECT_FALSE(grid.IsUniform());
+
+  const size_t num_time_steps = grid.NumTimeSteps(time::kDefaultTimeHorizon);
+  EXPECT_LT(num_time_steps, time::kDefaultNumTimeSteps);
+  EXPECT_NEAR(grid.RelativeTime(num_time_steps), time::kDefaultTimeHorizon,
+              constants::kSmallNumber);
+
+  for (size_t kk = 0; kk < num_time_steps; kk++) {
+    if (kk > 0) {
+      EXPECT_GT(grid.TimeStep(kk), grid.TimeStep(kk - 1));
+    }
+    EXPECT_NEAR(grid.RelativeTime(kk + 1) - grid.RelativeTime(kk),
+                grid.TimeStep(kk), constants::kSmallNumber);
+    EXPECT_EQ(grid.Index(grid.RelativeTime(kk) + 0.5 * grid.TimeStep(kk)), kk);
+  }
+
+  // Beyond the horizon, the grid continues with its last time step.
+  EXPECT_EQ(grid.TimeStep(num_time_steps),
+            grid.TimeStep(num_time_steps - 1));
+}
+
+TEST(TimeGridTest, SpliceKeepsOldStepsThenNew) {
+  const TimeGrid old_grid(std::vector<Time>{0.1, 0.2, 0.3, 0.4});
+  const TimeGrid new_grid(std::vector<Time>{0.5, 0.6});
+  const TimeGrid spliced = old_grid.Splice(1, 3, new_grid);
+
+  const std::vector<Time> expected_time_steps = {0.2, 0.3, 0.5, 0.6};
+  for (size_t kk = 0; kk < expected_time_steps.size(); kk++)
+    EXPECT_EQ(spliced.TimeStep(kk), expected_time_steps[kk]);
+
+  // Splicing uniform grids with the same time step stays uniform.
+  const TimeGrid uniform(time::kDefaultTimeStep);
+  EXPECT_TRUE(uniform.Splice(2, 5, uniform).IsUniform());
+}
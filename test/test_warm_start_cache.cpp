@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2019, The Regents of the University of California (Regents).
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *
+ *    2. Redistributions in binary form must reproduce the above
+ *       copyright notice, this list of conditions and the following
+ *       disclaimer in the documentation and/or other materials provided
+ *       with the distribution.
+ *
+ *    3. Neither the name of the copyright holder nor the names of its
+ *       contributors may be used to endorse or promote products derived
+ *       from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS AS IS
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Please contact the author(s) of this library if you have any questions.
+ * Authors: David Fridovich-Keil   ( dfk@eecs.berkeley.edu )
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Tests for WarmStartCache.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <ilqgames/examples/two_player_collision_example.h>
+#include <ilqgames/solver/ilq_solver.h>
+#include <ilqgames/solver/solver_params.h>
+#include <ilqgames/solver/warm_start_cache.h>
+#include <ilqgames/utils/operating_point.h>
+#include <ilqgames/utils/solver_log.h>
+#include <ilqgames/utils/types.h>
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+using namespace ilqgames;
+
+namespace {
+// Number of entries in a small cache.
+static constexpr size_t kSmallCacheSize = 2;
+
+// Initial time of a warm-started problem.
+static constexpr Time kLaterInitialTime = 1.0;
+
+// Perturbation to the initial state of a distant problem.
+static constexpr float kInitialStatePerturbation = 0.1;
+}  // anonymous namespace
+
+TEST(WarmStartCacheTest, FindsNearestAndEvictsOldest) {
+  auto problem = std::make_shared<TwoPlayerCollisionExample>();
+  problem->Initialize();
+  const auto& dynamics = problem->Dynamics();
+  const OperatingPoint& op = problem->CurrentOperatingPoint();
+  const auto& strategies = problem->CurrentStrategies();
+
+  WarmStartCache cache(dynamics, kSmallCacheSize);
+  EXPECT_EQ(cache.Nearest(problem->InitialState()), nullptr);
+
+  const VectorXf x0 = VectorXf::Zero(dynamics->XDim());
+  const VectorXf x1 = VectorXf::Ones(dynamics->XDim());
+  const VectorXf x2 = 2.0 * x1;
+  cache.Add(x0, op, strategies);
+  cache.Add(x1, op, strategies);
+  EXPECT_EQ(cache.Size(), 2);
+  EXPECT_TRUE(cache.Nearest(0.1 * x1)->x0.isApprox(x0));
+  EXPECT_TRUE(cache.Nearest(0.9 * x1)->x0.isApprox(x1));
+  EXPECT_EQ(cache.Nearest(10.0 * x1, cache.Distance(x1, x2)), nullptr);
+
+  // Adding a third entry should evict the first.
+  cache.Add(x2, op, strategies);
+  EXPECT_EQ(cache.Size(), kSmallCacheSize);
+  EXPECT_TRUE(cache.Nearest(x0)->x0.isApprox(x1));
+}
+
+TEST(WarmStartCacheTest, WarmStartReproducesCachedSolution) {
+  // Solve a problem and cache the result, whether or not it converged.
+  auto cached_problem = std::make_shared<TwoPlayerCollisionExample>();
+  cached_problem->Initialize();
+  ILQSolver cached_solver(cached_problem);
+  const auto cached_log = cached_solver.Solve();
+
+  WarmStartCache cache(cached_problem->Dynamics());
+  EXPECT_TRUE(cache.Add(*cached_log, false));
+
+  // Warm start a fresh copy of the problem at a later initial time. The
+  // solver's first iterate should be the cached solution.
+  auto warm_problem = std::make_shared<TwoPlayerCollisionExample>();
+  warm_problem->Initialize();
+  warm_problem->ResetInitialTime(kLaterInitialTime);
+  EXPECT_TRUE(cache.WarmStart(warm_problem.get()));
+  EXPECT_FLOAT_EQ(warm_problem->InitialTime(), kLaterInitialTime);
+
+  SolverParams params;
+  params.max_solver_iters = 0;
+  ILQSolver warm_solver(warm_problem, params);
+  const auto warm_log = warm_solver.Solve();
+
+  const OperatingPoint& cached_op = cached_log->FinalOperatingPoint();
+  const OperatingPoint& warm_op = warm_log->InitialOperatingPoint();
+  ASSERT_EQ(warm_op.xs.size(), cached_op.xs.size());
+  for (size_t kk = 0; kk < cached_op.xs.size(); kk++) {
+    EXPECT_LT((warm_op.xs[kk] - cached_op.xs[kk]).lpNorm<Eigen::Infinity>(),
+              constants::kSmallNumber);
+  }
+
+  // A distant initial state should not be warm started.
+  auto far_problem = std::make_shared<TwoPlayerCollisionExample>();
+  far_problem->Initialize();
+  far_problem->ResetInitialState(
+      far_problem->InitialState() +
+      VectorXf::Constant(far_problem->InitialState().size(),
+                         kInitialStatePerturbation));
+  EXPECT_FALSE(cache.WarmStart(
+      far_problem.get(),
+      0.5 * cache.Distance(far_problem->InitialState(),
+                           cached_problem->InitialState())));
+}